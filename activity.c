@@ -1,13 +1,559 @@
+// activity.c
+// Times-table quiz with three lives, played at the console or hosted for
+// thousands of players at once over a local socket
+// Compile: gcc -O2 activity.c -o activity
+// Play:    ./activity
+// Server:  ./activity --serve [--socket <path>] [--max-sessions <n>]
+//          (line protocol: the server sends "What is a x b?" lines, the
+//          player answers with a number per line; try: nc -U activity.sock)
+// Load:    ./activity --load [sessions] [--socket <path>] [--concurrency <n>]
+//                     [--rounds <n>]
+//          (each session answers <rounds> questions right, then loses its
+//          lives; reports sessions/s and answer latency)
+#ifdef __linux__
+#define _GNU_SOURCE             // accept4
+#endif
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
 
-int main() {
-    int lives = 3;
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+#define LIVES 3
+#define MAX_FACTOR 12
+#define DEFAULT_SOCKET "activity.sock"
+
+// ------------------ Questions ------------------
+// PCG32 with unbiased bounded draws (Lemire's multiply-shift with rejection)
+typedef struct {
+    uint64_t state, inc;
+} Pcg32;
+
+static inline uint32_t pcgNext(Pcg32 *r) {
+    uint64_t old = r->state;
+    r->state = old * 6364136223846793005ULL + r->inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rot = (uint32_t)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+}
+
+void pcgSeed(Pcg32 *r, uint64_t seed) {
+    r->state = 0;
+    r->inc = 0xDA3E39CB94B95BDBULL;
+    pcgNext(r);
+    r->state += seed;
+    pcgNext(r);
+}
+
+static inline uint32_t pcgBelow(Pcg32 *r, uint32_t n) {
+    uint64_t m = (uint64_t)pcgNext(r) * n;
+    if ((uint32_t)m < n) {
+        uint32_t threshold = -n % n;
+        while ((uint32_t)m < threshold) m = (uint64_t)pcgNext(r) * n;
+    }
+    return (uint32_t)(m >> 32);
+}
+
+#ifdef __linux__
+static double nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Let one process hold as many sockets as the hard limit allows
+static void raiseFileLimit() {
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+        rl.rlim_cur = rl.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &rl);
+    }
+}
+
+static int unixAddress(struct sockaddr_un *addr, const char *path) {
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr->sun_path)) {
+        fprintf(stderr, "Socket path too long: %s\n", path);
+        return -1;
+    }
+    strcpy(addr->sun_path, path);
+    return 0;
+}
+
+// ------------------ Session server ------------------
+// One thread, one epoll set. Every session lives in a slot of a slab
+// allocated up front; free slots are chained through `next`, and the epoll
+// data of a connection is its slot number. Input is received straight into
+// the slot and replies are formatted into it, so no message allocates.
+// While a reply cannot be sent the session stops reading (EPOLLIN is
+// dropped), so answers a client sends ahead wait in the socket buffer.
+#define SESSION_INPUT 13
+#define SESSION_OUTPUT 104
+#define LISTEN_SLOT UINT32_MAX
+#define DEFAULT_MAX_SESSIONS 16384
+#define SERVER_EVENTS 256
+
+typedef struct {
+    int fd;                     // -1 when free
+    uint32_t next;              // next free slot
+    uint32_t score;
+    uint8_t a, b;               // current question
+    uint8_t lives, streak;
+    uint8_t inLen, overflow, closing;
+    uint8_t outLen, outSent, blocked;
+    char in[SESSION_INPUT];
+    char out[SESSION_OUTPUT];
+} Session;
+
+typedef struct {
+    Session *slots;
+    uint32_t capacity, freeHead, active, peak;
+    uint64_t opened, finished, answers, correct, dropped;
+    int epoll;
+    Pcg32 rng;
+} SessionPool;
+
+static volatile sig_atomic_t stopServer;
+
+static void onStopSignal(int sig) {
+    (void)sig;
+    stopServer = 1;
+}
+
+int poolInit(SessionPool *p, uint32_t capacity) {
+    memset(p, 0, sizeof(*p));
+    p->slots = malloc((size_t)capacity * sizeof(Session));
+    if (!p->slots) return -1;
+    for (uint32_t i = 0; i < capacity; i++) {
+        p->slots[i].fd = -1;
+        p->slots[i].next = i + 1;
+    }
+    p->capacity = capacity;
+    return 0;
+}
+
+static void askQuestion(SessionPool *p, Session *s) {
+    s->a = (uint8_t)(pcgBelow(&p->rng, MAX_FACTOR) + 1);
+    s->b = (uint8_t)(pcgBelow(&p->rng, MAX_FACTOR) + 1);
+    s->outLen += (uint8_t)snprintf(s->out + s->outLen, SESSION_OUTPUT - s->outLen, "Lives: %d\nWhat is %d x %d?\n",
+                                   s->lives, s->a, s->b);
+}
+
+static void sessionClose(SessionPool *p, uint32_t slot) {
+    Session *s = &p->slots[slot];
+    close(s->fd);               // also leaves the epoll set
+    s->fd = -1;
+    s->next = p->freeHead;
+    p->freeHead = slot;
+    p->active--;
+}
+
+// Send what is pending; while a reply is stuck, wait for writability
+// instead of input. -1 once a closing session has sent everything.
+static int sessionFlush(SessionPool *p, uint32_t slot) {
+    Session *s = &p->slots[slot];
+    while (s->outSent < s->outLen) {
+        ssize_t n = send(s->fd, s->out + s->outSent, s->outLen - s->outSent, MSG_NOSIGNAL);
+        if (n > 0) {
+            s->outSent += (uint8_t)n;
+        } else if (n < 0 && errno == EAGAIN) {
+            if (!s->blocked) {
+                struct epoll_event ev = { .events = EPOLLOUT, .data.u32 = slot };
+                epoll_ctl(p->epoll, EPOLL_CTL_MOD, s->fd, &ev);
+                s->blocked = 1;
+            }
+            return 0;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            return -1;
+        }
+    }
+    s->outLen = s->outSent = 0;
+    if (s->closing) return -1;
+    if (s->blocked) {
+        struct epoll_event ev = { .events = EPOLLIN, .data.u32 = slot };
+        epoll_ctl(p->epoll, EPOLL_CTL_MOD, s->fd, &ev);
+        s->blocked = 0;
+    }
+    return 0;
+}
+
+// Check one answer line and queue the reply; the line is s->in[0..len)
+static void sessionAnswer(SessionPool *p, Session *s, int len) {
+    int i = 0, digits = 0;
+    long value = 0;
+    while (i < len && (s->in[i] == ' ' || s->in[i] == '\t')) i++;
+    int negative = i < len && s->in[i] == '-';
+    i += negative;
+    for (; i < len && s->in[i] >= '0' && s->in[i] <= '9'; i++, digits++) value = value * 10 + (s->in[i] - '0');
+    while (i < len && (s->in[i] == ' ' || s->in[i] == '\t' || s->in[i] == '\r')) i++;
+    int valid = digits > 0 && i == len && !s->overflow;
+    int expected = s->a * s->b;
+
+    p->answers++;
+    if (valid && !negative && value == expected) {
+        p->correct++;
+        if (s->streak < UINT8_MAX) s->streak++;
+        s->score += s->streak;
+        s->outLen = (uint8_t)snprintf(s->out, SESSION_OUTPUT, "Correct!\n");
+    } else {
+        s->lives--;
+        s->streak = 0;
+        s->outLen = (uint8_t)snprintf(s->out, SESSION_OUTPUT,
+                                      "Wrong! The correct answer is %d. You have %d lives left.\n", expected, s->lives);
+    }
+    if (s->lives == 0) {
+        s->outLen += (uint8_t)snprintf(s->out + s->outLen, SESSION_OUTPUT - s->outLen, "Sorry, You lose! Score: %u\n",
+                                       s->score);
+        s->closing = 1;
+        p->finished++;
+    } else {
+        askQuestion(p, s);
+    }
+    s->overflow = 0;
+}
+
+// Answer the complete lines already received, one at a time, stopping
+// while a reply is waiting to be sent
+static int sessionProcess(SessionPool *p, uint32_t slot) {
+    Session *s = &p->slots[slot];
+    while (!s->outLen && !s->closing) {
+        const char *nl = memchr(s->in, '\n', s->inLen);
+        if (!nl) return 0;
+        int len = (int)(nl - s->in);
+        sessionAnswer(p, s, len);
+        s->inLen -= (uint8_t)(len + 1);
+        memmove(s->in, nl + 1, s->inLen);
+        if (sessionFlush(p, slot) < 0) return -1;
+    }
+    return 0;
+}
+
+// Read what fits in the slot and answer it; -1 when the session should end
+static int sessionRead(SessionPool *p, uint32_t slot) {
+    Session *s = &p->slots[slot];
+    for (;;) {
+        if (sessionProcess(p, slot) < 0) return -1;
+        if (s->outLen || s->closing) return 0;     // reading resumes once the reply is out
+        if (s->inLen == SESSION_INPUT) {            // no answer is this long: drop it
+            s->overflow = 1;
+            s->inLen = 0;
+        }
+        ssize_t n = recv(s->fd, s->in + s->inLen, SESSION_INPUT - s->inLen, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && errno == EAGAIN) return 0;
+        if (n <= 0) return -1;
+        s->inLen += (uint8_t)n;
+    }
+}
+
+static void acceptSessions(SessionPool *p, int listener) {
+    for (;;) {
+        int fd = accept4(listener, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            return;             // EAGAIN, or out of descriptors until a session ends
+        }
+        if (p->freeHead == p->capacity) {
+            send(fd, "Server full\n", 12, MSG_NOSIGNAL);
+            close(fd);
+            p->dropped++;
+            continue;
+        }
+        uint32_t slot = p->freeHead;
+        Session *s = &p->slots[slot];
+        p->freeHead = s->next;
+        memset(s, 0, sizeof(*s));
+        s->fd = fd;
+        s->lives = LIVES;
+        struct epoll_event ev = { .events = EPOLLIN, .data.u32 = slot };
+        epoll_ctl(p->epoll, EPOLL_CTL_ADD, fd, &ev);
+        p->opened++;
+        if (++p->active > p->peak) p->peak = p->active;
+        askQuestion(p, s);
+        if (sessionFlush(p, slot) < 0) sessionClose(p, slot);
+    }
+}
+
+int runServer(const char *path, uint32_t maxSessions) {
+    struct sockaddr_un addr;
+    SessionPool pool;
+    if (unixAddress(&addr, path) != 0) return 1;
+    if (poolInit(&pool, maxSessions) != 0) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    raiseFileLimit();
+    pcgSeed(&pool.rng, (uint64_t)time(NULL) ^ (uint64_t)getpid() << 32);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    unlink(path);
+    if (listener < 0 || bind(listener, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(listener, SOMAXCONN) != 0) {
+        perror(path);
+        free(pool.slots);
+        return 1;
+    }
+    pool.epoll = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event ev = { .events = EPOLLIN, .data.u32 = LISTEN_SLOT };
+    epoll_ctl(pool.epoll, EPOLL_CTL_ADD, listener, &ev);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = onStopSignal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    printf("Serving quizzes on %s (up to %u sessions, %zu bytes each); Ctrl+C to stop\n", path, maxSessions,
+           sizeof(Session));
+    fflush(stdout);
+
+    struct epoll_event events[SERVER_EVENTS];
+    double start = nowSeconds();
+    while (!stopServer) {
+        int n = epoll_wait(pool.epoll, events, SERVER_EVENTS, -1);
+        for (int i = 0; i < n; i++) {
+            uint32_t slot = events[i].data.u32;
+            if (slot == LISTEN_SLOT) {
+                acceptSessions(&pool, listener);
+                continue;
+            }
+            if (pool.slots[slot].fd < 0) continue;
+            int status = 0;
+            if (events[i].events & (EPOLLOUT | EPOLLHUP | EPOLLERR)) status = sessionFlush(&pool, slot);
+            if (status == 0) status = sessionRead(&pool, slot);
+            if (status < 0) sessionClose(&pool, slot);
+        }
+    }
+
+    double seconds = nowSeconds() - start;
+    printf("\n%llu sessions (%llu finished, %llu turned away, peak %u at once), %llu answers (%llu correct) in %.1f s\n",
+           (unsigned long long)pool.opened, (unsigned long long)pool.finished, (unsigned long long)pool.dropped,
+           pool.peak, (unsigned long long)pool.answers, (unsigned long long)pool.correct, seconds);
+    for (uint32_t i = 0; i < pool.capacity; i++) {
+        if (pool.slots[i].fd >= 0) close(pool.slots[i].fd);
+    }
+    close(pool.epoll);
+    close(listener);
+    unlink(path);
+    free(pool.slots);
+    return 0;
+}
+
+// ------------------ Load generator ------------------
+// Keeps `concurrency` players connected, each answering as soon as its
+// question arrives. Latency is the time from sending an answer (or
+// connecting) to receiving the whole next question, kept in a log-linear
+// histogram with 8 buckets per power of two of nanoseconds.
+#define LATENCY_BUCKETS 512
+#define CLIENT_BUFFER 256
+#define DEFAULT_SESSIONS 20000
+#define DEFAULT_CONCURRENCY 1000
+#define DEFAULT_ROUNDS 5
+
+typedef struct {
+    int fd;
+    int answered;
+    int len;
+    double sent;
+    char buf[CLIENT_BUFFER];
+} Client;
+
+static int highestBit(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(v);
+#else
+    int bit = 0;
+    while (v >>= 1) bit++;
+    return bit;
+#endif
+}
+
+static int latencyBucket(uint64_t ns) {
+    if (ns < 8) return (int)ns;
+    int msb = highestBit(ns);
+    return (msb - 2) * 8 + (int)((ns >> (msb - 3)) & 7);
+}
+
+static double bucketNanos(int bucket) {
+    if (bucket < 8) return bucket;
+    return (double)(8 + bucket % 8) * (double)(1ULL << (bucket / 8 - 1));
+}
+
+static double latencyPercentile(const uint64_t *hist, uint64_t total, double fraction) {
+    uint64_t want = (uint64_t)(total * fraction), seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        seen += hist[i];
+        if (seen > want) return bucketNanos(i);
+    }
+    return bucketNanos(LATENCY_BUCKETS - 1);
+}
+
+static int clientConnect(Client *c, const struct sockaddr_un *addr, int epoll, uint32_t id) {
+    c->fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (c->fd < 0) return -1;
+    // Blocking connect waits for room in the listen backlog
+    if (connect(c->fd, (const struct sockaddr *)addr, sizeof(*addr)) != 0) {
+        close(c->fd);
+        c->fd = -1;
+        return -1;
+    }
+    fcntl(c->fd, F_SETFL, fcntl(c->fd, F_GETFL) | O_NONBLOCK);
+    c->answered = c->len = 0;
+    c->sent = nowSeconds();
+    struct epoll_event ev = { .events = EPOLLIN, .data.u32 = id };
+    epoll_ctl(epoll, EPOLL_CTL_ADD, c->fd, &ev);
+    return 0;
+}
+
+int runLoad(const char *path, uint64_t sessions, int concurrency, int rounds) {
+    struct sockaddr_un addr;
+    if (unixAddress(&addr, path) != 0) return 1;
+    raiseFileLimit();
+    if ((uint64_t)concurrency > sessions) concurrency = (int)sessions;
+
+    Client *clients = calloc((size_t)concurrency, sizeof(Client));
+    uint64_t *hist = calloc(LATENCY_BUCKETS, sizeof(uint64_t));
+    struct epoll_event *events = malloc((size_t)concurrency * sizeof(struct epoll_event));
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (!clients || !hist || !events || epoll < 0) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    uint64_t started = 0, completed = 0, failed = 0, answers = 0, replies = 0;
+    double maxLatency = 0, start = nowSeconds();
+    int open = 0;
+    for (int i = 0; i < concurrency; i++) {
+        if (clientConnect(&clients[i], &addr, epoll, (uint32_t)i) != 0) {
+            perror(path);
+            return 1;
+        }
+        started++;
+        open++;
+    }
+
+    while (open > 0) {
+        int n = epoll_wait(epoll, events, concurrency, -1);
+        if (n < 0 && errno != EINTR) break;
+        for (int e = 0; e < n; e++) {
+            uint32_t id = events[e].data.u32;
+            Client *c = &clients[id];
+            ssize_t got = recv(c->fd, c->buf + c->len, CLIENT_BUFFER - 1 - c->len, 0);
+            if (got < 0 && (errno == EAGAIN || errno == EINTR)) continue;
+            if (got <= 0) {
+                // Server ended the session: count it and start the next one
+                if (c->answered == rounds + LIVES) completed++;
+                else failed++;
+                close(c->fd);
+                c->fd = -1;
+                open--;
+                if (started < sessions) {
+                    if (clientConnect(c, &addr, epoll, id) == 0) {
+                        open++;
+                    } else {
+                        failed++;
+                    }
+                    started++;
+                }
+                continue;
+            }
+            c->len += (int)got;
+            c->buf[c->len] = '\0';
+            if (c->len < 2 || memcmp(c->buf + c->len - 2, "?\n", 2) != 0) {
+                if (c->len == CLIENT_BUFFER - 1) c->len = 0;    // not our server
+                continue;
+            }
+
+            double now = nowSeconds(), latency = now - c->sent;
+            hist[latencyBucket((uint64_t)(latency * 1e9))]++;
+            replies++;
+            if (latency > maxLatency) maxLatency = latency;
+
+            const char *q = strstr(c->buf, "What is ");
+            int a = 0, b = 0;
+            if (!q || sscanf(q, "What is %d x %d?", &a, &b) != 2) {
+                c->len = 0;
+                continue;
+            }
+            char line[24];
+            int value = c->answered < rounds ? a * b : a * b + 1;
+            int len = snprintf(line, sizeof(line), "%d\n", value);
+            c->len = 0;
+            c->answered++;
+            answers++;
+            c->sent = nowSeconds();
+            if (send(c->fd, line, (size_t)len, MSG_NOSIGNAL) != len) {
+                shutdown(c->fd, SHUT_RDWR);     // reported as failed when the read side ends
+            }
+        }
+    }
+    double seconds = nowSeconds() - start;
+
+    printf("%llu sessions (%llu failed) with %d connected at once, %d right + %d wrong answers each\n",
+           (unsigned long long)completed, (unsigned long long)failed, concurrency, rounds, LIVES);
+    printf("%.3f s: %.0f sessions/s, %.0f answers/s\n", seconds, completed / seconds, answers / seconds);
+    printf("Latency: p50 %.1f us, p90 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n",
+           latencyPercentile(hist, replies, 0.50) / 1e3, latencyPercentile(hist, replies, 0.90) / 1e3,
+           latencyPercentile(hist, replies, 0.99) / 1e3, latencyPercentile(hist, replies, 0.999) / 1e3,
+           maxLatency * 1e6);
+    close(epoll);
+    free(events);
+    free(hist);
+    free(clients);
+    return failed ? 1 : 0;
+}
+#endif
+
+// ------------------ Game ------------------
+int main(int argc, char **argv) {
+    int lives = LIVES;
     int answer;
+    int serve = 0, load = 0;
+    const char *path = DEFAULT_SOCKET;
+    uint32_t maxSessions = 0;
+    uint64_t sessions = 0;
+    int concurrency = 0, rounds = -1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--serve") == 0) serve = 1;
+        else if (strcmp(argv[i], "--load") == 0) {
+            load = 1;
+            if (i + 1 < argc && argv[i + 1][0] != '-') sessions = strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) path = argv[++i];
+        else if (strcmp(argv[i], "--max-sessions") == 0 && i + 1 < argc) maxSessions = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--concurrency") == 0 && i + 1 < argc) concurrency = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) rounds = atoi(argv[++i]);
+    }
+    if (serve || load) {
+#ifdef __linux__
+        if (serve) return runServer(path, maxSessions ? maxSessions : DEFAULT_MAX_SESSIONS);
+        return runLoad(path, sessions ? sessions : DEFAULT_SESSIONS, concurrency > 0 ? concurrency : DEFAULT_CONCURRENCY,
+                       rounds >= 0 ? rounds : DEFAULT_ROUNDS);
+#else
+        (void)path, (void)maxSessions, (void)sessions, (void)concurrency, (void)rounds;
+        fprintf(stderr, "The quiz server needs Linux (epoll)\n");
+        return 1;
+#endif
+    }
+
     while (lives > 0) {
         printf("Lives: %d\n", lives);
         printf("What is 2x2? \n");
         printf("Your answer: ");
-        scanf("%d", &answer);
+        if (scanf("%d", &answer) != 1) break;
         if (answer == 4) {
             printf("\nYou Win!\n");
             break;
@@ -1,28 +1,417 @@
+// activityextra.c
+// Multiplication quiz with lives, and a generator for printed worksheets
+// Compile: gcc -O2 activityextra.c -o activityextra
+// Play:    ./activityextra [--seed <n>]
+// Sheets:  ./activityextra --generate <count> [--ops mul,add,sub,div] [--max-x <n>]
+//                          [--max-y <n>] [--seed <n>] [--answers] [--out <file|->]
+// Bench:   ./activityextra --bench [count]
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
 
-int main() {
+// ------------------ Random numbers ------------------
+// PCG32 (XSH RR): 64-bit state, 32-bit output. Bounded draws use Lemire's
+// multiply-shift with rejection, so every value in [0, n) is equally likely
+// (rand() % n favours the low values whenever n does not divide RAND_MAX + 1).
+typedef struct {
+    uint64_t state, inc;
+} Pcg32;
+
+static inline uint32_t pcgNext(Pcg32 *r) {
+    uint64_t old = r->state;
+    r->state = old * 6364136223846793005ULL + r->inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rot = (uint32_t)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+}
+
+void pcgSeed(Pcg32 *r, uint64_t seed, uint64_t stream) {
+    r->state = 0;
+    r->inc = (stream << 1) | 1;
+    pcgNext(r);
+    r->state += seed;
+    pcgNext(r);
+}
+
+// Uniform in [0, n), n > 0
+static inline uint32_t pcgBelow(Pcg32 *r, uint32_t n) {
+    uint64_t m = (uint64_t)pcgNext(r) * n;
+    uint32_t low = (uint32_t)m;
+    if (low < n) {
+        uint32_t threshold = -n % n;    // 2^32 mod n
+        while (low < threshold) {
+            m = (uint64_t)pcgNext(r) * n;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+// Uniform in [0, n) for n up to 2^64
+static inline uint64_t pcgBelow64(Pcg32 *r, uint64_t n) {
+    if (n <= UINT32_MAX) return pcgBelow(r, (uint32_t)n);
+    uint64_t limit = UINT64_MAX - UINT64_MAX % n, v;
+    do {
+        v = (uint64_t)pcgNext(r) << 32 | pcgNext(r);
+    } while (v >= limit);
+    return v % n;
+}
+
+static uint64_t timeSeed() {
+    return (uint64_t)time(NULL) * 0x9E3779B97F4A7C15ULL ^ (uint64_t)clock();
+}
+
+static double nowSeconds() {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// ------------------ Quiz engine ------------------
+// A question is an operation and two operands, x in [1, maxX] and y in
+// [1, maxY]; its index in [0, ops * maxX * maxY) identifies it. Questions
+// already given are remembered in a bitset over every index while that
+// fits in QUIZ_BITSET_LIMIT bits, otherwise in a Bloom filter sized for the
+// questions asked for (about 1% of new questions are then skipped as if
+// seen, but none is ever repeated).
+#define QUIZ_BITSET_LIMIT (1ULL << 30)     // 128 MB
+#define BLOOM_BITS_PER_ITEM 10
+#define BLOOM_HASHES 7
+
+typedef enum { OP_MUL, OP_ADD, OP_SUB, OP_DIV, OP_COUNT } QuizOp;
+
+static const char *OP_NAMES[OP_COUNT] = { "mul", "add", "sub", "div" };
+static const char *OP_SIGNS[OP_COUNT] = { " x ", " + ", " - ", " / " };
+
+typedef struct {
+    int op;
+    long long a, b, answer;     // "a op b = answer"
+} Question;
+
+typedef struct {
+    Pcg32 rng;
+    uint32_t maxX, maxY;
+    int ops[OP_COUNT], opCount;
+    uint64_t universe;          // distinct questions
+    uint64_t *seen;
+    uint64_t seenMask;          // bits in the Bloom filter - 1; 0 for a bitset
+    uint64_t issued, rejected;
+} QuizGen;
+
+// ops is a bitmask of 1 << QuizOp; expected is how many questions will be
+// drawn (sizes the Bloom filter). Returns -1 if out of memory.
+int quizInit(QuizGen *g, uint32_t maxX, uint32_t maxY, unsigned ops, uint64_t seed, uint64_t expected) {
+    memset(g, 0, sizeof(*g));
+    pcgSeed(&g->rng, seed, 0x5175697A);
+    g->maxX = maxX;
+    g->maxY = maxY;
+    for (int op = 0; op < OP_COUNT; op++) {
+        if (ops >> op & 1) g->ops[g->opCount++] = op;
+    }
+    g->universe = (uint64_t)g->opCount * maxX * maxY;
+
+    uint64_t bits = g->universe;
+    if (bits > QUIZ_BITSET_LIMIT) {
+        bits = 64;
+        while (bits < expected * BLOOM_BITS_PER_ITEM) bits *= 2;
+        g->seenMask = bits - 1;
+    }
+    g->seen = calloc((size_t)((bits + 63) / 64), sizeof(uint64_t));
+    return g->seen ? 0 : -1;
+}
+
+void quizFree(QuizGen *g) {
+    free(g->seen);
+    g->seen = NULL;
+}
+
+static inline uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Mark index as given; 0 if it was (or, in a Bloom filter, may have been) before
+static inline int quizMark(QuizGen *g, uint64_t index) {
+    if (!g->seenMask) {
+        uint64_t bit = 1ULL << (index & 63), *w = &g->seen[index >> 6];
+        if (*w & bit) return 0;
+        *w |= bit;
+        return 1;
+    }
+    uint64_t h = mix64(index), h1 = h, h2 = (h >> 32) | 1;
+    int fresh = 0;
+    for (int i = 0; i < BLOOM_HASHES; i++, h1 += h2) {
+        uint64_t pos = h1 & g->seenMask, bit = 1ULL << (pos & 63);
+        if (!(g->seen[pos >> 6] & bit)) {
+            g->seen[pos >> 6] |= bit;
+            fresh = 1;
+        }
+    }
+    return fresh;
+}
+
+static inline void quizBuild(const QuizGen *g, uint64_t index, Question *q) {
+    uint64_t per = (uint64_t)g->maxX * g->maxY;
+    long long x = (long long)(index % per / g->maxY) + 1, y = (long long)(index % per % g->maxY) + 1;
+    q->op = g->ops[index / per];
+    switch (q->op) {
+        case OP_MUL: q->a = x; q->b = y; q->answer = x * y; break;
+        case OP_ADD: q->a = x; q->b = y; q->answer = x + y; break;
+        case OP_SUB: q->a = x + y; q->b = y; q->answer = x; break;     // never negative
+        default:     q->a = x * y; q->b = y; q->answer = x; break;     // always exact
+    }
+}
+
+// Next question not given before; 0 once every question has been given
+// (or, with a Bloom filter, when new ones stop turning up)
+int quizNext(QuizGen *g, Question *q) {
+    if (!g->seenMask && g->issued == g->universe) return 0;
+    for (uint64_t tries = 0; ; tries++) {
+        uint64_t index = pcgBelow64(&g->rng, g->universe);
+        if (quizMark(g, index)) {
+            quizBuild(g, index, q);
+            g->issued++;
+            return 1;
+        }
+        g->rejected++;
+
+        // Near the end of a bitset, scan from the draw to the next free index
+        if (!g->seenMask && tries >= 64) {
+            while (g->seen[index >> 6] >> (index & 63) & 1) index = index + 1 == g->universe ? 0 : index + 1;
+            quizMark(g, index);
+            quizBuild(g, index, q);
+            g->issued++;
+            return 1;
+        }
+        if (g->seenMask && tries >= 1000) return 0;
+    }
+}
+
+// --- Worksheet Output ---
+static char *putNumber(char *p, long long v) {
+    char tmp[24];
+    int n = 0;
+    unsigned long long u = v < 0 ? 0ULL - (unsigned long long)v : (unsigned long long)v;
+    if (v < 0) *p++ = '-';
+    do {
+        tmp[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+    while (n) *p++ = tmp[--n];
+    return p;
+}
+
+static char *putQuestion(char *p, const Question *q, int answers) {
+    p = putNumber(p, q->a);
+    memcpy(p, OP_SIGNS[q->op], 3);
+    p = putNumber(p + 3, q->b);
+    memcpy(p, " =", 2);
+    p += 2;
+    if (answers) {
+        *p++ = ' ';
+        p = putNumber(p, q->answer);
+    }
+    *p++ = '\n';
+    return p;
+}
+
+// Parse "mul,add" into a bitmask of operations; 0 if a name is unknown
+unsigned parseOps(const char *s) {
+    unsigned ops = 0;
+    while (*s) {
+        size_t len = strcspn(s, ",");
+        int found = 0;
+        for (int op = 0; op < OP_COUNT; op++) {
+            if (strlen(OP_NAMES[op]) == len && strncmp(OP_NAMES[op], s, len) == 0) {
+                ops |= 1u << op;
+                found = 1;
+            }
+        }
+        if (!found) return 0;
+        s += len + (s[len] == ',');
+    }
+    return ops;
+}
+
+#define SHEET_BUFFER (1 << 20)
+#define SHEET_LINE 80               // longest question line
+
+int runGenerate(uint64_t count, uint32_t maxX, uint32_t maxY, unsigned ops, uint64_t seed, int answers,
+                const char *path) {
+    QuizGen g;
+    if (quizInit(&g, maxX, maxY, ops, seed, count) != 0) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    if (!g.seenMask && count > g.universe) {
+        fprintf(stderr, "Only %llu different questions with these limits\n", (unsigned long long)g.universe);
+        quizFree(&g);
+        return 1;
+    }
+    FILE *out = strcmp(path, "-") == 0 ? stdout : fopen(path, "wb");
+    if (!out) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        quizFree(&g);
+        return 1;
+    }
+    char *buf = malloc(SHEET_BUFFER + SHEET_LINE), *p = buf;
+    if (!buf) {
+        fprintf(stderr, "Out of memory\n");
+        if (out != stdout) fclose(out);
+        quizFree(&g);
+        return 1;
+    }
+    Question q;
+    double t0 = nowSeconds();
+    uint64_t n = 0;
+    for (; n < count && quizNext(&g, &q); n++) {
+        p = putQuestion(p, &q, answers);
+        if (p - buf >= SHEET_BUFFER) {
+            fwrite(buf, 1, (size_t)(p - buf), out);
+            p = buf;
+        }
+    }
+    fwrite(buf, 1, (size_t)(p - buf), out);
+    int ok = out == stdout ? fflush(out) == 0 : fclose(out) == 0;
+    double seconds = nowSeconds() - t0;
+    fprintf(stderr, "%llu questions (%llu redrawn, %s) in %.3f s: %.1f M/s\n", (unsigned long long)n,
+            (unsigned long long)g.rejected, g.seenMask ? "Bloom filter" : "bitset", seconds,
+            n / (seconds > 0 ? seconds : 1e-9) / 1e6);
+    free(buf);
+    quizFree(&g);
+    return ok && n == count ? 0 : 1;
+}
+
+// Throughput of each stage on `count` questions
+int runBench(uint64_t count) {
+    Pcg32 r;
+    volatile uint64_t sink = 0;
+    uint64_t acc = 0;
+    pcgSeed(&r, 42, 1);
+
+    double t0 = nowSeconds();
+    for (uint64_t i = 0; i < count; i++) acc += pcgNext(&r);
+    double t1 = nowSeconds();
+    for (uint64_t i = 0; i < count; i++) acc += pcgBelow(&r, 1000);
+    double t2 = nowSeconds();
+    printf(" pcg32                %8.2f ns/number\n", (t1 - t0) * 1e9 / count);
+    printf(" bounded [0, 1000)    %8.2f ns/number\n", (t2 - t1) * 1e9 / count);
+
+    // Unique questions: a bitset universe twice the count, then one too big
+    // for a bitset so the Bloom filter is used
+    static const struct { uint32_t maxX, maxY; unsigned ops; } SETS[2] = {
+        { 10000, 10000, 1u << OP_MUL }, { 1000000, 1000000, 15 }
+    };
+    char *buf = malloc(SHEET_BUFFER + SHEET_LINE);
+    if (!buf) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    for (int s = 0; s < 2; s++) {
+        QuizGen g;
+        Question q;
+        if (quizInit(&g, SETS[s].maxX, SETS[s].maxY, SETS[s].ops, 42, count) != 0) {
+            fprintf(stderr, "Out of memory\n");
+            free(buf);
+            return 1;
+        }
+        uint64_t n = count < g.universe / 2 ? count : g.universe / 2, bytes = 0;
+        char *p = buf;
+        double t3 = nowSeconds();
+        for (uint64_t i = 0; i < n && quizNext(&g, &q); i++) {
+            p = putQuestion(p, &q, 1);
+            if (p - buf >= SHEET_BUFFER) {
+                bytes += (uint64_t)(p - buf);
+                p = buf;
+            }
+        }
+        bytes += (uint64_t)(p - buf);
+        double t4 = nowSeconds();
+        printf(" %-7s %7ux%-7u %llu questions, %llu redrawn, %s: %.3f s, %.1f M/s, %.1f MB/s formatted\n",
+               s ? "mixed" : "mul", SETS[s].maxX, SETS[s].maxY, (unsigned long long)g.issued,
+               (unsigned long long)g.rejected, g.seenMask ? "Bloom filter" : "bitset", t4 - t3,
+               g.issued / (t4 - t3) / 1e6, bytes / (t4 - t3) / 1e6);
+        acc += g.issued;
+        quizFree(&g);
+    }
+    free(buf);
+    sink = acc;
+    (void)sink;
+    return 0;
+}
+
+// ------------------ Quiz ------------------
+int main(int argc, char **argv) {
     int lives = 3;
-    int maxX, maxY, answer;
+    int maxX, maxY;
+    long long answer;
+    uint64_t seed = timeSeed(), count = 0, benchCount = 0;
+    uint32_t sheetX = 12, sheetY = 12;
+    unsigned ops = 1u << OP_MUL;
+    int answers = 0;
+    const char *path = "-";
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--generate") == 0 && i + 1 < argc) count = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--max-x") == 0 && i + 1 < argc) sheetX = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--max-y") == 0 && i + 1 < argc) sheetY = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc) ops = parseOps(argv[++i]);
+        else if (strcmp(argv[i], "--answers") == 0) answers = 1;
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) path = argv[++i];
+        else if (strcmp(argv[i], "--bench") == 0) {
+            benchCount = i + 1 < argc ? strtoull(argv[++i], NULL, 10) : 0;
+            if (!benchCount) benchCount = 20000000;
+        }
+    }
+    if (benchCount) return runBench(benchCount);
+    if (count) {
+        if (!ops || sheetX < 1 || sheetY < 1 || sheetX > 1000000 || sheetY > 1000000) {
+            fprintf(stderr, "Operations are mul, add, sub and div; limits go from 1 to 1000000\n");
+            return 1;
+        }
+        return runGenerate(count, sheetX, sheetY, ops, seed, answers, path);
+    }
+
     printf("Enter the maximum value for x: ");
-    scanf("%d", &maxX);
+    if (scanf("%d", &maxX) != 1 || maxX < 1) return 1;
     printf("Enter the maximum value for y: ");
-    scanf("%d", &maxY);
+    if (scanf("%d", &maxY) != 1 || maxY < 1) return 1;
+
+    // No question comes up twice until all of them have
+    QuizGen quiz;
+    Question q;
+    if (quizInit(&quiz, (uint32_t)maxX, (uint32_t)maxY, 1u << OP_MUL, seed, 1024) != 0) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
     while (lives > 0) {
-        int num1 = (rand() % maxX) + 1; 
-        int num2 = (rand() % maxY) + 1;
+        if (!quizNext(&quiz, &q)) {
+            uint64_t next = pcgNext(&quiz.rng);
+            quizFree(&quiz);
+            if (quizInit(&quiz, (uint32_t)maxX, (uint32_t)maxY, 1u << OP_MUL, next, 1024) != 0) {
+                fprintf(stderr, "Out of memory\n");
+                return 1;
+            }
+            quizNext(&quiz, &q);
+        }
         printf("Lives: %d\n", lives);
-        printf("What is %d x %d? \n", num1, num2);
+        printf("What is %lld x %lld? \n", q.a, q.b);
         printf("Your answer: ");
-        scanf("%d", &answer);
-        if (answer == num1 * num2) {
+        if (scanf("%lld", &answer) != 1) break;
+        if (answer == q.answer) {
             printf("\nCorrect!\n\n");
         } else {
             lives--;
-            printf("Wrong! The correct answer is %d. You have %d lives left.\n\n", num1 * num2, lives);
+            printf("Wrong! The correct answer is %lld. You have %d lives left.\n\n", q.answer, lives);
         }
     }
     if (lives <= 0) {
         printf("Sorry, You lose!\n");
     }
+    quizFree(&quiz);
     return 0;
 }
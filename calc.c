@@ -1,6 +1,7 @@
 // calc.c
 // Windows console calculator with HUD
 // Compile: gcc calc.c -o calc.exe -lm -mconsole
+//     with __float128: add -DCALC_FLOAT128 -lquadmath
 // this code is made by Tonie 
 // License: Public Domain
 // Note: This code uses C17 standard
@@ -12,6 +13,11 @@
 // - Memory operations: M+, M-, MC
 // - History of last 6 results
 // - Angle mode toggle: degrees/radians
+// - Unit conversions with dimension checking (length, mass, time,
+//   temperature, pressure, energy, data sizes, angles, SI prefixes)
+// - Batch column conversion: calc.exe --convert <from> <to> [column] < in > out
+// - Expressions with a session cache: exp(log(5)) * (m + 1) ^ 2
+// - Selectable precision: calc.exe --precision float|double|long|quad
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -19,9 +25,13 @@
 #include <math.h>
 #include <conio.h>
 #include <windows.h>
+#include "calc_core.h"
+#include "calc_expr.h"
 
 #define HISTORY_SIZE 6
 #define INPUT_SZ 128
+#define VALUE_SZ 48                      // one formatted number, up to quad precision
+#define ENTRY_SZ (INPUT_SZ + VALUE_SZ + 16)  // "expr = r", or "a op b = r" with three numbers
 
 // ANSI color helpers (Windows 10+ consoles support this if enabled)
 // Colors
@@ -46,9 +56,11 @@ const char *CLR_ERROR  = "\x1b[1;31m";   // bright red
 
 // Global state
 double memory_value = 0.0;
-char history[HISTORY_SIZE][64];
+char history[HISTORY_SIZE][ENTRY_SZ];
 int hist_count = 0;
 int show_radians = 0; // 0 = degrees (default), 1 = radians
+CalcPrecision precision = CALC_DOUBLE; // number type for basic/scientific ops
+CalcExprCtx expr_ctx; // hash-consed expressions + result cache for the session
 
 // Forward declarations
 // Functions
@@ -57,10 +69,15 @@ void clear_screen();
 void add_history(const char *entry);
 void draw_hud(const char *mode, const char *msg);
 double prompt_number(const char *prompt, int *ok);
+CalcValue prompt_value(const char *prompt, int *ok);
+void format_value(const CalcValue *v, char *buf, size_t sz);
 void basic_ops();
 void scientific_ops();
 void conversion_ops();
+void expression_ops();
 void show_help();
+void units_init();
+int run_batch_convert(const char *from, const char *to, int column);
 
 // Enable ANSI escape codes on Windows console
 // This is needed for colored output
@@ -102,9 +119,10 @@ void draw_hud(const char *mode, const char *msg) {
     printf("%s+------------------------------------------------------------+%s\n\n", CLR_HEADER, CLR_RESET);
 
     // Mode and memory
-    printf("%sMode:%s  %s%-8s%s   %sMemory:%s  %s%g%s\n\n",
+    printf("%sMode:%s  %s%-8s%s   %sMemory:%s  %s%g%s   %sPrecision:%s  %s%s%s\n\n",
            CLR_LABEL, CLR_RESET, CLR_VALUE, mode, CLR_RESET,
-           CLR_LABEL, CLR_RESET, CLR_VALUE, memory_value, CLR_RESET);
+           CLR_LABEL, CLR_RESET, CLR_VALUE, memory_value, CLR_RESET,
+           CLR_LABEL, CLR_RESET, CLR_VALUE, CALC_PRECISION_NAMES[precision], CLR_RESET);
 
     // History box
     printf("%sHistory:%s\n", CLR_LABEL, CLR_RESET);
@@ -119,9 +137,9 @@ void draw_hud(const char *mode, const char *msg) {
     printf("+------------------------------------------------------------+\n\n");
 
     // Instructions / shortcuts
-    printf("%sShortcuts:%s  %s[1]%s Basic   %s[2]%s Scientific   %s[3]%s Conversions   %s[m]%s Mem+  %s[M]%s Mem-  %s[c]%s Clear Memory\n",
+    printf("%sShortcuts:%s  %s[1]%s Basic   %s[2]%s Scientific   %s[3]%s Conversions   %s[4]%s Expression   %s[m]%s Mem+  %s[M]%s Mem-  %s[c]%s Clear Memory\n",
            CLR_LABEL, CLR_RESET,
-           CLR_VALUE, CLR_RESET, CLR_VALUE, CLR_RESET, CLR_VALUE, CLR_RESET,
+           CLR_VALUE, CLR_RESET, CLR_VALUE, CLR_RESET, CLR_VALUE, CLR_RESET, CLR_VALUE, CLR_RESET,
            CLR_VALUE, CLR_RESET, CLR_VALUE, CLR_RESET, CLR_VALUE, CLR_RESET);
     printf("%s          %s[h]%s Help   %s[q]%s Quit   %s[r]%s Toggle Deg/Rad (%s)%s\n\n",
            CLR_LABEL, CLR_RESET, CLR_LABEL, CLR_RESET, CLR_LABEL, CLR_RESET,
@@ -162,6 +180,32 @@ double prompt_number(const char *prompt, int *ok) {
     return val;
 }
 
+// Prompt a number in the selected precision ('m' inserts memory)
+CalcValue prompt_value(const char *prompt, int *ok) {
+    char buf[INPUT_SZ];
+    CalcValue v = calc_from_double(precision, 0.0);
+    *ok = 0;
+    printf("%s%s:%s ", CLR_LABEL, prompt, CLR_RESET);
+    if (!fgets(buf, sizeof(buf), stdin)) return v;
+    buf[strcspn(buf, "\r\n")] = 0;
+    if (strlen(buf) == 0) return v;
+    if (strlen(buf) == 1 && (buf[0] == 'm' || buf[0] == 'M')) {
+        *ok = 1;
+        return calc_from_double(precision, memory_value);
+    }
+    if (!calc_parse(precision, buf, &v)) {
+        printf("%sInvalid number input.%s\n", CLR_ERROR, CLR_RESET);
+        return v;
+    }
+    *ok = 1;
+    return v;
+}
+
+// %g look for double; wider types show all of their digits
+void format_value(const CalcValue *v, char *buf, size_t sz) {
+    calc_format(v, 'g', v->prec == CALC_DOUBLE ? 6 : -1, buf, sz);
+}
+
 // Basic operations: + - * /
 void basic_ops() {
     char opbuf[16];
@@ -172,24 +216,26 @@ void basic_ops() {
     char op = opbuf[0];
     if (op == 'b' || op == 'B') return;
 
-    double a = prompt_number("First number (or 'm' for memory)", &ok);
+    char opname[2] = { op, '\0' };
+    int calc_op = calc_op_find(opname);
+    if (calc_op < 0 || CALC_OPS[calc_op].arity != 2 || op == '\0') {
+        draw_hud("Basic", "Unknown operator"); return;
+    }
+
+    CalcValue a = prompt_value("First number (or 'm' for memory)", &ok);
     if (!ok) { draw_hud("Basic", "Cancelled: invalid first number"); return; }
-    double b = prompt_number("Second number (or 'm' for memory)", &ok);
+    CalcValue b = prompt_value("Second number (or 'm' for memory)", &ok);
     if (!ok) { draw_hud("Basic", "Cancelled: invalid second number"); return; }
 
-    double res = 0.0;
-    char entry[64];
-    switch (op) {
-        case '+': res = a + b; break;
-        case '-': res = a - b; break;
-        case '*': res = a * b; break;
-        case '/':
-            if (b == 0.0) { draw_hud("Basic", "Error: Division by zero"); return; }
-            res = a / b; break;
-        default:
-            draw_hud("Basic", "Unknown operator"); return;
-    }
-    snprintf(entry, sizeof(entry), "%g %c %g = %g", a, op, b, res);
+    if (op == '/' && calc_is_zero(&b)) { draw_hud("Basic", "Error: Division by zero"); return; }
+    CalcValue res = calc_compute((CalcOp)calc_op, &a, &b);
+
+    char sa[VALUE_SZ], sb[VALUE_SZ], sr[VALUE_SZ];
+    char entry[ENTRY_SZ];
+    format_value(&a, sa, sizeof(sa));
+    format_value(&b, sb, sizeof(sb));
+    format_value(&res, sr, sizeof(sr));
+    snprintf(entry, sizeof(entry), "%s %c %s = %s", sa, op, sb, sr);
     add_history(entry);
     draw_hud("Basic", entry);
 }
@@ -206,31 +252,26 @@ void scientific_ops() {
     if (strlen(opbuf) == 0) return;
     if (opbuf[0] == 'b' || opbuf[0] == 'B') return;
 
-    // unary functions
-    if (strcmp(opbuf, "sin") == 0 || strcmp(opbuf, "cos") == 0 || strcmp(opbuf, "tan") == 0 ||
-        strcmp(opbuf, "exp") == 0 || strcmp(opbuf, "log") == 0 || strcmp(opbuf, "sqrt") == 0) {
-        double a = prompt_number("Value (or 'm')", &ok);
+    int op = calc_op_find(opbuf);
+    char sa[VALUE_SZ], sb[VALUE_SZ], sr[VALUE_SZ];
+    char entry[ENTRY_SZ];
+
+    // unary functions (sin cos tan exp log sqrt, plus the rest of the core)
+    if (op >= 0 && CALC_OPS[op].arity == 1 && op != CALC_DEG2RAD) {
+        CalcValue a = prompt_value("Value (or 'm')", &ok);
         if (!ok) { draw_hud("Scientific", "Cancelled: invalid number"); return; }
-        double input_val = a;
-        if (!show_radians && (strcmp(opbuf, "sin") == 0 || strcmp(opbuf, "cos") == 0 || strcmp(opbuf, "tan") == 0)) {
+        CalcValue x = a;
+        if (!show_radians && (op == CALC_SIN || op == CALC_COS || op == CALC_TAN)) {
             // convert degrees to radians
-            a = a * M_PI / 180.0;
-        }
-        double res = 0.0;
-        if (strcmp(opbuf, "sin") == 0) res = sin(a);
-        else if (strcmp(opbuf, "cos") == 0) res = cos(a);
-        else if (strcmp(opbuf, "tan") == 0) res = tan(a);
-        else if (strcmp(opbuf, "exp") == 0) res = exp(a);
-        else if (strcmp(opbuf, "log") == 0) {
-            if (a <= 0.0) { draw_hud("Scientific", "Error: log domain"); return; }
-            res = log(a);
+            x = calc_compute(CALC_DEG2RAD, &a, NULL);
         }
-        else if (strcmp(opbuf, "sqrt") == 0) {
-            if (a < 0.0) { draw_hud("Scientific", "Error: sqrt domain"); return; }
-            res = sqrt(a);
-        }
-        char entry[64];
-        snprintf(entry, sizeof(entry), "%s(%g) = %g", opbuf, input_val, res);
+        double approx = calc_to_double(&a);
+        if (op == CALC_LOG && (calc_is_zero(&a) || approx < 0.0)) { draw_hud("Scientific", "Error: log domain"); return; }
+        if (op == CALC_SQRT && approx < 0.0) { draw_hud("Scientific", "Error: sqrt domain"); return; }
+        CalcValue res = calc_compute((CalcOp)op, &x, NULL);
+        format_value(&a, sa, sizeof(sa));
+        format_value(&res, sr, sizeof(sr));
+        snprintf(entry, sizeof(entry), "%s(%s) = %s", opbuf, sa, sr);
         add_history(entry);
         draw_hud("Scientific", entry);
         return;
@@ -239,14 +280,16 @@ void scientific_ops() {
     // binary pow
     // pow(base, exponent)
     // Example: pow(2, 3) = 8
-    if (strcmp(opbuf, "pow") == 0) {
-        double a = prompt_number("Base (or 'm')", &ok);
+    if (op == CALC_POW) {
+        CalcValue a = prompt_value("Base (or 'm')", &ok);
         if (!ok) { draw_hud("Scientific", "Cancelled: invalid base"); return; }
-        double b = prompt_number("Exponent (or 'm')", &ok);
+        CalcValue b = prompt_value("Exponent (or 'm')", &ok);
         if (!ok) { draw_hud("Scientific", "Cancelled: invalid exponent"); return; }
-        double res = pow(a, b);
-        char entry[64];
-        snprintf(entry, sizeof(entry), "pow(%g, %g) = %g", a, b, res);
+        CalcValue res = calc_compute(CALC_POW, &a, &b);
+        format_value(&a, sa, sizeof(sa));
+        format_value(&b, sb, sizeof(sb));
+        format_value(&res, sr, sizeof(sr));
+        snprintf(entry, sizeof(entry), "pow(%s, %s) = %s", sa, sb, sr);
         add_history(entry);
         draw_hud("Scientific", entry);
         return;
@@ -255,59 +298,403 @@ void scientific_ops() {
     draw_hud("Scientific", "Unknown scientific op");
 }
 
-// Conversion ops (deg/rad toggle, temperature, etc)
+// ------------------ Unit registry ------------------
+// Every unit maps to its dimension's base unit as: base = x * scale + offset.
+// Prefixable units also get the SI prefixes (km, mg, kPa, GB, ...) and data
+// units the binary ones (KiB, MiB, ...). units_init() expands the registry and
+// precomputes one affine pair (a, b) for every from/to pair inside a dimension,
+// so converting a value is a single table lookup plus one multiply-add.
+typedef enum {
+    DIM_LENGTH, DIM_MASS, DIM_TIME, DIM_TEMPERATURE, DIM_PRESSURE,
+    DIM_ENERGY, DIM_DATA, DIM_ANGLE, DIM_COUNT
+} Dimension;
+
+const char *DIM_NAMES[DIM_COUNT] = {
+    "length", "mass", "time", "temperature", "pressure", "energy", "data", "angle"
+};
+
+typedef struct {
+    const char *name;
+    Dimension dim;
+    double scale;
+    double offset;
+    int prefixable;
+} UnitDef;
+
+// Scales are relative to m, kg, s, K, Pa, J, bit and rad
+const UnitDef UNIT_DEFS[] = {
+    { "m",    DIM_LENGTH, 1.0, 0.0, 1 },
+    { "in",   DIM_LENGTH, 0.0254, 0.0, 0 },
+    { "ft",   DIM_LENGTH, 0.3048, 0.0, 0 },
+    { "yd",   DIM_LENGTH, 0.9144, 0.0, 0 },
+    { "mi",   DIM_LENGTH, 1609.344, 0.0, 0 },
+    { "nmi",  DIM_LENGTH, 1852.0, 0.0, 0 },
+    { "au",   DIM_LENGTH, 149597870700.0, 0.0, 0 },
+    { "ly",   DIM_LENGTH, 9460730472580800.0, 0.0, 0 },
+
+    { "g",    DIM_MASS, 1e-3, 0.0, 1 },
+    { "t",    DIM_MASS, 1000.0, 0.0, 0 },
+    { "lb",   DIM_MASS, 0.45359237, 0.0, 0 },
+    { "oz",   DIM_MASS, 0.028349523125, 0.0, 0 },
+    { "st",   DIM_MASS, 6.35029318, 0.0, 0 },
+
+    { "s",    DIM_TIME, 1.0, 0.0, 1 },
+    { "min",  DIM_TIME, 60.0, 0.0, 0 },
+    { "h",    DIM_TIME, 3600.0, 0.0, 0 },
+    { "d",    DIM_TIME, 86400.0, 0.0, 0 },
+    { "wk",   DIM_TIME, 604800.0, 0.0, 0 },
+    { "yr",   DIM_TIME, 31557600.0, 0.0, 0 },   // Julian year
+
+    { "K",    DIM_TEMPERATURE, 1.0, 0.0, 1 },
+    { "C",    DIM_TEMPERATURE, 1.0, 273.15, 0 },
+    { "F",    DIM_TEMPERATURE, 5.0 / 9.0, 273.15 - 32.0 * 5.0 / 9.0, 0 },
+    { "R",    DIM_TEMPERATURE, 5.0 / 9.0, 0.0, 0 },
+
+    { "Pa",   DIM_PRESSURE, 1.0, 0.0, 1 },
+    { "bar",  DIM_PRESSURE, 1e5, 0.0, 1 },
+    { "atm",  DIM_PRESSURE, 101325.0, 0.0, 0 },
+    { "psi",  DIM_PRESSURE, 6894.757293168361, 0.0, 0 },
+    { "mmHg", DIM_PRESSURE, 133.322387415, 0.0, 0 },
+    { "torr", DIM_PRESSURE, 101325.0 / 760.0, 0.0, 0 },
+
+    { "J",    DIM_ENERGY, 1.0, 0.0, 1 },
+    { "cal",  DIM_ENERGY, 4.184, 0.0, 1 },
+    { "eV",   DIM_ENERGY, 1.602176634e-19, 0.0, 1 },
+    { "Wh",   DIM_ENERGY, 3600.0, 0.0, 1 },
+    { "BTU",  DIM_ENERGY, 1055.05585262, 0.0, 0 },
+
+    { "bit",  DIM_DATA, 1.0, 0.0, 1 },
+    { "B",    DIM_DATA, 8.0, 0.0, 1 },
+
+    { "rad",  DIM_ANGLE, 1.0, 0.0, 0 },
+    { "deg",  DIM_ANGLE, M_PI / 180.0, 0.0, 0 },
+    { "grad", DIM_ANGLE, M_PI / 200.0, 0.0, 0 },
+    { "turn", DIM_ANGLE, 2.0 * M_PI, 0.0, 0 },
+};
+#define UNIT_DEF_COUNT ((int)(sizeof(UNIT_DEFS) / sizeof(UNIT_DEFS[0])))
+
+typedef struct {
+    const char *name;
+    double factor;
+} UnitPrefix;
+
+const UnitPrefix SI_PREFIXES[] = {
+    { "y", 1e-24 }, { "z", 1e-21 }, { "a", 1e-18 }, { "f", 1e-15 },
+    { "p", 1e-12 }, { "n", 1e-9 },  { "u", 1e-6 },  { "m", 1e-3 },
+    { "c", 1e-2 },  { "d", 1e-1 },  { "da", 1e1 },  { "h", 1e2 },
+    { "k", 1e3 },   { "M", 1e6 },   { "G", 1e9 },   { "T", 1e12 },
+    { "P", 1e15 },  { "E", 1e18 },  { "Z", 1e21 },  { "Y", 1e24 },
+};
+const UnitPrefix BINARY_PREFIXES[] = {
+    { "Ki", 1024.0 }, { "Mi", 1048576.0 }, { "Gi", 1073741824.0 },
+    { "Ti", 1099511627776.0 }, { "Pi", 1125899906842624.0 },
+    { "Ei", 1152921504606846976.0 },
+};
+
+#define MAX_UNITS 512
+#define UNIT_NAME_SZ 12
+
+typedef struct {
+    char name[UNIT_NAME_SZ];
+    Dimension dim;
+    int slot;         // index inside its dimension's pair table
+    double scale;
+    double offset;
+} Unit;
+
+typedef struct {
+    double a, b;      // to = from * a + b
+} UnitAffine;
+
+Unit units[MAX_UNITS];
+int unit_count = 0;
+int dim_unit_count[DIM_COUNT];
+UnitAffine *dim_pairs[DIM_COUNT];   // dim_unit_count[d]^2 entries each
+
+// Find a unit by exact name, -1 if unknown
+int unit_find(const char *name) {
+    for (int i = 0; i < unit_count; ++i) {
+        if (strcmp(units[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+void unit_register(const char *prefix, const UnitDef *def, double factor) {
+    char name[UNIT_NAME_SZ];
+    snprintf(name, sizeof(name), "%s%s", prefix, def->name);
+    // Plain names win over prefixed spellings ("min" is minutes, not milli-inch)
+    if (unit_count >= MAX_UNITS || unit_find(name) >= 0) return;
+    Unit *u = &units[unit_count++];
+    strcpy(u->name, name);
+    u->dim = def->dim;
+    u->slot = dim_unit_count[def->dim]++;
+    u->scale = def->scale * factor;
+    u->offset = def->offset;
+}
+
+// Expand prefixes and precompute every same-dimension conversion pair
+void units_init() {
+    for (int i = 0; i < UNIT_DEF_COUNT; ++i) unit_register("", &UNIT_DEFS[i], 1.0);
+    for (int i = 0; i < UNIT_DEF_COUNT; ++i) {
+        const UnitDef *def = &UNIT_DEFS[i];
+        if (!def->prefixable) continue;
+        for (size_t p = 0; p < sizeof(SI_PREFIXES) / sizeof(SI_PREFIXES[0]); ++p)
+            unit_register(SI_PREFIXES[p].name, def, SI_PREFIXES[p].factor);
+        if (def->dim == DIM_DATA) {
+            for (size_t p = 0; p < sizeof(BINARY_PREFIXES) / sizeof(BINARY_PREFIXES[0]); ++p)
+                unit_register(BINARY_PREFIXES[p].name, def, BINARY_PREFIXES[p].factor);
+        }
+    }
+
+    for (int d = 0; d < DIM_COUNT; ++d) {
+        int n = dim_unit_count[d];
+        dim_pairs[d] = malloc(sizeof(UnitAffine) * (n > 0 ? n * n : 1));
+        if (!dim_pairs[d]) { printf("Out of memory\n"); exit(1); }
+    }
+    for (int i = 0; i < unit_count; ++i) {
+        for (int j = 0; j < unit_count; ++j) {
+            if (units[i].dim != units[j].dim) continue;
+            const Unit *from = &units[i], *to = &units[j];
+            UnitAffine *pair = &dim_pairs[from->dim][from->slot * dim_unit_count[from->dim] + to->slot];
+            pair->a = from->scale / to->scale;
+            pair->b = (from->offset - to->offset) / to->scale;
+        }
+    }
+}
+
+// Look up the precomputed pair; NULL when the dimensions differ
+const UnitAffine *unit_pair(int from, int to) {
+    if (units[from].dim != units[to].dim) return NULL;
+    Dimension d = units[from].dim;
+    return &dim_pairs[d][units[from].slot * dim_unit_count[d] + units[to].slot];
+}
+
+double unit_apply(const UnitAffine *c, double x) {
+#ifdef FP_FAST_FMA
+    return fma(x, c->a, c->b);
+#else
+    return x * c->a + c->b;   // contracted to an FMA when the target has one
+#endif
+}
+
+// Convert a whole column in place of out[]; one lookup for the batch
+int convert_column(const double *in, double *out, size_t n, int from, int to) {
+    const UnitAffine *c = unit_pair(from, to);
+    if (!c) return 0;
+    const double a = c->a, b = c->b;
+    for (size_t i = 0; i < n; ++i) out[i] = in[i] * a + b;
+    return 1;
+}
+
+// Resolve two unit names, writing an error message into msg on failure
+int resolve_units(const char *from_name, const char *to_name, int *from, int *to, char *msg, size_t msg_sz) {
+    *from = unit_find(from_name);
+    *to = unit_find(to_name);
+    if (*from < 0) { snprintf(msg, msg_sz, "Unknown unit '%s'", from_name); return 0; }
+    if (*to < 0) { snprintf(msg, msg_sz, "Unknown unit '%s'", to_name); return 0; }
+    if (units[*from].dim != units[*to].dim) {
+        snprintf(msg, msg_sz, "Cannot convert %s (%s) to %s (%s)",
+                 from_name, DIM_NAMES[units[*from].dim], to_name, DIM_NAMES[units[*to].dim]);
+        return 0;
+    }
+    return 1;
+}
+
+// Shortest %g text (15 to 17 digits) that reads back as exactly x
+void format_exact(char *buf, size_t sz, double x) {
+    for (int digits = 15; digits < 17; ++digits) {
+        snprintf(buf, sz, "%.*g", digits, x);
+        if (strtod(buf, NULL) == x) return;
+    }
+    snprintf(buf, sz, "%.17g", x);
+}
+
+// Batch mode: convert one column of a text/CSV stream from stdin to stdout.
+// Lines are read in blocks so the conversion itself runs as a column pass.
+#define BATCH_LINES 4096
+#define BATCH_LINE_SZ 512
+
+int run_batch_convert(const char *from_name, const char *to_name, int column) {
+    char msg[128];
+    int from, to;
+    if (!resolve_units(from_name, to_name, &from, &to, msg, sizeof(msg))) {
+        fprintf(stderr, "%s\n", msg);
+        return 1;
+    }
+    if (column < 1) column = 1;
+
+    char (*lines)[BATCH_LINE_SZ] = malloc(sizeof(*lines) * BATCH_LINES);
+    double *values = malloc(sizeof(double) * BATCH_LINES);
+    int *field_start = malloc(sizeof(int) * BATCH_LINES);
+    int *field_end = malloc(sizeof(int) * BATCH_LINES);
+    if (!lines || !values || !field_start || !field_end) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    int done = 0, status = 0;
+    long line_no = 0;
+    while (!done) {
+        int n = 0;
+        while (n < BATCH_LINES) {
+            if (!fgets(lines[n], BATCH_LINE_SZ, stdin)) { done = 1; break; }
+            line_no++;
+            size_t len = strlen(lines[n]);
+            if (len == BATCH_LINE_SZ - 1 && lines[n][len - 1] != '\n') {
+                int ch = getchar();
+                if (ch != '\n' && ch != EOF) {
+                    // Too long to hold: drop the rest of the line and leave an
+                    // empty output line so output still matches input line for line
+                    while ((ch = getchar()) != EOF && ch != '\n') {}
+                    fprintf(stderr, "Line %ld: longer than %d characters, skipped\n", line_no, BATCH_LINE_SZ - 1);
+                    lines[n][0] = 0;
+                    values[n] = 0;
+                    field_end[n++] = -1;
+                    status = 1;
+                    continue;
+                }
+            }
+            lines[n][strcspn(lines[n], "\r\n")] = 0;
+
+            // Locate the requested field (separated by commas, tabs or spaces)
+            char *p = lines[n];
+            for (int c = 1; c < column && *p; ++c) {
+                p += strcspn(p, ",\t ");
+                if (*p) p++;
+            }
+            char *end;
+            values[n] = strtod(p, &end);
+            field_start[n] = (int)(p - lines[n]);
+            field_end[n] = (end == p) ? -1 : (int)(end - lines[n]);   // -1: not a number
+            n++;
+        }
+
+        convert_column(values, values, (size_t)n, from, to);
+
+        for (int i = 0; i < n; ++i) {
+            if (field_end[i] < 0) {           // headers and blanks pass through
+                printf("%s\n", lines[i]);
+                continue;
+            }
+            char num[32];
+            format_exact(num, sizeof(num), values[i]);
+            printf("%.*s%s%s\n", field_start[i], lines[i], num, lines[i] + field_end[i]);
+        }
+    }
+
+    free(lines); free(values); free(field_start); free(field_end);
+    return status;
+}
+
+// Conversion ops (any registered unit pair, plus the classic shortcuts)
 void conversion_ops() {
+    // Shortcut names kept from the original menu
+    static const char *aliases[][3] = {
+        { "deg2rad", "deg", "rad" }, { "rad2deg", "rad", "deg" },
+        { "c2f", "C", "F" },         { "f2c", "F", "C" },
+    };
     char buf[32];
-    int ok;
-    draw_hud("Conversions", "Options: deg2rad rad2deg c2f f2c  (or 'b' back)");
+    char from_name[UNIT_NAME_SZ], to_name[UNIT_NAME_SZ];
+    char msg[128];
+    int ok, from, to;
+    draw_hud("Conversions", "Enter '<from> <to>' (e.g. km mi, psi kPa, GiB MB) or deg2rad rad2deg c2f f2c  ('b' back)");
     printf("%sOption:%s ", CLR_LABEL, CLR_RESET);
     if (!fgets(buf, sizeof(buf), stdin)) return;
     buf[strcspn(buf, "\r\n")] = 0;
     if (strlen(buf) == 0) return;
-    if (buf[0] == 'b' || buf[0] == 'B') return;
-
-    if (strcmp(buf, "deg2rad") == 0) {
-        double a = prompt_number("Degrees", &ok);
-        if (!ok) { draw_hud("Conversions", "Cancelled"); return; }
-        double res = a * M_PI / 180.0;
-        char entry[64]; snprintf(entry, sizeof(entry), "%g deg = %g rad", a, res);
-        add_history(entry); draw_hud("Conversions", entry); return;
-    }
-    if (strcmp(buf, "rad2deg") == 0) {
-        double a = prompt_number("Radians", &ok);
-        if (!ok) { draw_hud("Conversions", "Cancelled"); return; }
-        double res = a * 180.0 / M_PI;
-        char entry[64]; snprintf(entry, sizeof(entry), "%g rad = %g deg", a, res);
-        add_history(entry); draw_hud("Conversions", entry); return;
+    if (strcmp(buf, "b") == 0 || strcmp(buf, "B") == 0) return;
+
+    int found = 0;
+    for (size_t i = 0; i < sizeof(aliases) / sizeof(aliases[0]); ++i) {
+        if (strcmp(buf, aliases[i][0]) == 0) {
+            strcpy(from_name, aliases[i][1]);
+            strcpy(to_name, aliases[i][2]);
+            found = 1;
+        }
     }
-    if (strcmp(buf, "c2f") == 0) {
-        double c = prompt_number("Celsius", &ok); if (!ok) { draw_hud("Conversions", "Cancelled"); return; }
-        double f = (c * 9.0 / 5.0) + 32.0;
-        char entry[64]; snprintf(entry, sizeof(entry), "%g C = %g F", c, f);
-        add_history(entry); draw_hud("Conversions", entry); return;
+    if (!found && sscanf(buf, "%11s %11s", from_name, to_name) != 2) {
+        draw_hud("Conversions", "Unknown conversion option");
+        return;
     }
-    if (strcmp(buf, "f2c") == 0) {
-        double f = prompt_number("Fahrenheit", &ok); if (!ok) { draw_hud("Conversions", "Cancelled"); return; }
-        double c = (f - 32.0) * 5.0 / 9.0;
-        char entry[64]; snprintf(entry, sizeof(entry), "%g F = %g C", f, c);
-        add_history(entry); draw_hud("Conversions", entry); return;
+    if (!resolve_units(from_name, to_name, &from, &to, msg, sizeof(msg))) {
+        draw_hud("Conversions", msg);
+        return;
     }
 
-    draw_hud("Conversions", "Unknown conversion option");
+    char prompt[32];
+    snprintf(prompt, sizeof(prompt), "Value in %s", from_name);
+    double a = prompt_number(prompt, &ok);
+    if (!ok) { draw_hud("Conversions", "Cancelled"); return; }
+    double res = unit_apply(unit_pair(from, to), a);
+    char entry[64]; snprintf(entry, sizeof(entry), "%g %s = %g %s", a, from_name, res, to_name);
+    add_history(entry); draw_hud("Conversions", entry);
 }
+// Expression mode: whole expressions, with repeated sub-expressions
+// answered from the session cache
+void expression_ops() {
+    char buf[INPUT_SZ];
+    char msg[128];
+    snprintf(msg, sizeof(msg), "e.g. exp(log(5)) * (m + 1) ^ 2   ('b' back)   Cache: %llu hits, %llu misses",
+             expr_ctx.hits, expr_ctx.misses);
+    draw_hud("Expression", msg);
+    printf("%sExpression:%s ", CLR_LABEL, CLR_RESET);
+    if (!fgets(buf, sizeof(buf), stdin)) return;
+    buf[strcspn(buf, "\r\n")] = 0;
+    if (strlen(buf) == 0) return;
+    if (strcmp(buf, "b") == 0 || strcmp(buf, "B") == 0) return;
+
+    // Memory and DEG/RAD changes drop only the cached results that used them
+    calc_expr_set_precision(&expr_ctx, precision);
+    calc_expr_set_memory(&expr_ctx, memory_value);
+    calc_expr_set_degrees(&expr_ctx, !show_radians);
+
+    CalcValue res;
+    CalcExprStatus st = calc_expr_eval(&expr_ctx, buf, &res);
+    if (st != CALC_EXPR_OK) {
+        snprintf(msg, sizeof(msg), "Error: %s", expr_ctx.err);
+        draw_hud("Expression", msg);
+        return;
+    }
+    char sr[VALUE_SZ], entry[ENTRY_SZ];
+    format_value(&res, sr, sizeof(sr));
+    snprintf(entry, sizeof(entry), "%s = %s", buf, sr);
+    add_history(entry);
+    draw_hud("Expression", entry);
+}
+
 // Show help screen
 void show_help() {
     draw_hud("Help", "Type a shortcut key or choose an option. Use 'm' to add last result to memory.");
     printf("\n%sDetailed Help:%s\n", CLR_LABEL, CLR_RESET);
     printf(" - Basic: enter operator (+ - * /) then two numbers. Use 'm' when prompted for number to use memory.\n");
     printf(" - Scientific: sin cos tan exp log sqrt pow. trig uses degrees by default (toggle r to change).\n");
+    printf(" - Conversions: '<from> <to>' with units for length, mass, time, temperature, pressure,\n");
+    printf("   energy, data and angles. SI prefixes work (km, mg, kPa, MJ, GB) and KiB/MiB/GiB for data.\n");
+    printf(" - Expression: + - * / ^, parentheses, m (memory), pi, e and functions like pow(a, b).\n");
+    printf("   Repeated sub-expressions are cached (%llu hits, %llu misses, %llu invalidated so far).\n",
+           expr_ctx.hits, expr_ctx.misses, expr_ctx.invalidations);
+    printf(" - Precision: start with --precision float|double|long|quad to pick the number type.\n");
     printf(" - Memory: press M to subtract, m to add last result to memory, c clears memory.\n");
     printf(" - History shows last %d results.\n", HISTORY_SIZE);
     printf("\nPress Enter to return...");
     getchar();
 }
 
-int main() {
+int main(int argc, char **argv) {
+    units_init();
+    // Batch mode: calc.exe --convert <from> <to> [column] < in.csv > out.csv
+    if (argc >= 4 && strcmp(argv[1], "--convert") == 0) {
+        return run_batch_convert(argv[2], argv[3], argc >= 5 ? atoi(argv[4]) : 1);
+    }
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (strcmp(argv[i], "--precision") == 0) {
+            int p = calc_precision_find(argv[i + 1]);
+            if (p < 0) { printf("Unknown or unavailable precision '%s'\n", argv[i + 1]); return 1; }
+            precision = (CalcPrecision)p;
+        }
+    }
+
+    calc_expr_init(&expr_ctx, precision);
     enable_ansi();
     memset(history, 0, sizeof(history));
     char choice[8];
@@ -321,7 +708,7 @@ int main() {
     while (1) {
         draw_hud("Idle", msg);
         msg[0] = '\0';
-        printf("%sChoose:[1]Basic [2]Sci [3]Conv [m]Mem+ [M]Mem- [c]ClearMem [r]ToggleDeg/Rad [h]Help [q]Quit%s\n> ",
+        printf("%sChoose:[1]Basic [2]Sci [3]Conv [4]Expr [m]Mem+ [M]Mem- [c]ClearMem [r]ToggleDeg/Rad [h]Help [q]Quit%s\n> ",
                CLR_LABEL, CLR_RESET);
         if (!fgets(choice, sizeof(choice), stdin)) break;
         char cmd = choice[0];
@@ -329,6 +716,7 @@ int main() {
         if (cmd == '1') basic_ops();
         else if (cmd == '2') scientific_ops();
         else if (cmd == '3') conversion_ops();
+        else if (cmd == '4') expression_ops();
         else if (cmd == 'm') {
             // add last result to memory
             // only if we have a last result
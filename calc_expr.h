@@ -0,0 +1,404 @@
+// calc_expr.h
+// Expression evaluator with a session-wide result cache, used by calc.c and
+// calc_mobile.c. Parsed expressions are hash-consed: every distinct
+// (operation, children, constant bits) node exists once, so the same
+// sub-expression typed twice - in one line or a hundred lines apart - is the
+// same node id. Results of operation nodes are memoized in a bounded LRU
+// keyed by that id. Nodes remember whether they read the memory register or
+// depend on the DEG/RAD mode, and only those cached results are dropped when
+// the memory or the mode changes.
+//
+// Grammar:  expr  := term (('+' | '-') term)*
+//           term  := unary (('*' | '/') unary)*
+//           unary := '-' unary | power
+//           power := atom ('^' unary)?
+//           atom  := number | m | pi | e | func '(' expr [',' expr] ')' | '(' expr ')'
+// Note: This code is made by Tonie and is in the Public Domain.
+
+#ifndef CALC_EXPR_H
+#define CALC_EXPR_H
+
+#include <ctype.h>
+#include <stdint.h>
+#include "calc_core.h"
+
+#define CALC_EXPR_MAX_NODES 4096   // interned nodes per session before a reset
+#define CALC_EXPR_HASH_SZ   8192   // intern table slots (power of two)
+#define CALC_EXPR_CACHE_SZ  1024   // memoized results kept (LRU)
+
+#define CALC_DEP_MEMORY 1          // reads the memory register
+#define CALC_DEP_ANGLE  2          // sin/cos/tan: depends on DEG/RAD
+
+typedef enum { CALC_NODE_NUM, CALC_NODE_MEM, CALC_NODE_OP } CalcNodeKind;
+
+typedef enum { CALC_EXPR_OK, CALC_EXPR_SYNTAX, CALC_EXPR_MATH } CalcExprStatus;
+
+typedef struct {
+    CalcNodeKind kind;
+    CalcOp op;
+    int a, b;              // child node ids (-1 if unused)
+    int deps;              // CALC_DEP_* of this node and its children
+    int cache_slot;        // index in the LRU, -1 if not cached
+    uint32_t hash;
+    CalcValue num;         // constant value for CALC_NODE_NUM
+} CalcNode;
+
+typedef struct {
+    int node;
+    int prev, next;        // LRU list, most recent at head
+    CalcValue value;
+} CalcCacheEntry;
+
+typedef struct {
+    CalcPrecision prec;
+    double memory;
+    int degrees;           // 1: trig arguments are in degrees
+
+    CalcNode nodes[CALC_EXPR_MAX_NODES];
+    int node_count;
+    int intern[CALC_EXPR_HASH_SZ];
+
+    CalcCacheEntry cache[CALC_EXPR_CACHE_SZ];
+    int cache_used, head, tail, free_list;
+
+    // Counters, exposed to the calculators
+    unsigned long long hits, misses, evictions, invalidations, resets;
+
+    // Parser state for the current line
+    const char *pos;
+    char err[64];
+} CalcExprCtx;
+
+// ------------------ Cache ------------------
+static inline void calc_lru_unlink(CalcExprCtx *c, int s) {
+    CalcCacheEntry *e = &c->cache[s];
+    if (e->prev >= 0) c->cache[e->prev].next = e->next; else c->head = e->next;
+    if (e->next >= 0) c->cache[e->next].prev = e->prev; else c->tail = e->prev;
+}
+
+static inline void calc_lru_push_front(CalcExprCtx *c, int s) {
+    CalcCacheEntry *e = &c->cache[s];
+    e->prev = -1;
+    e->next = c->head;
+    if (c->head >= 0) c->cache[c->head].prev = s; else c->tail = s;
+    c->head = s;
+}
+
+static inline void calc_lru_release(CalcExprCtx *c, int s) {
+    calc_lru_unlink(c, s);
+    c->nodes[c->cache[s].node].cache_slot = -1;
+    c->cache[s].next = c->free_list;
+    c->free_list = s;
+    c->cache_used--;
+}
+
+static inline void calc_lru_store(CalcExprCtx *c, int node, const CalcValue *v) {
+    int s;
+    if (c->free_list >= 0) {
+        s = c->free_list;
+        c->free_list = c->cache[s].next;
+    } else if (c->cache_used < CALC_EXPR_CACHE_SZ) {
+        s = c->cache_used;
+    } else {
+        s = c->tail;                         // evict least recently used
+        calc_lru_release(c, s);
+        c->free_list = c->cache[s].next;
+        c->evictions++;
+    }
+    c->cache_used++;
+    c->cache[s].node = node;
+    c->cache[s].value = *v;
+    c->nodes[node].cache_slot = s;
+    calc_lru_push_front(c, s);
+}
+
+// Drop cached results whose nodes carry any of the dependency bits
+static inline void calc_expr_invalidate(CalcExprCtx *c, int deps) {
+    int s = c->head;
+    while (s >= 0) {
+        int next = c->cache[s].next;
+        if (c->nodes[c->cache[s].node].deps & deps) {
+            calc_lru_release(c, s);
+            c->invalidations++;
+        }
+        s = next;
+    }
+}
+
+// Forget every node and cached result (new precision, or node pool full)
+static inline void calc_expr_reset(CalcExprCtx *c) {
+    c->node_count = 0;
+    for (int i = 0; i < CALC_EXPR_HASH_SZ; ++i) c->intern[i] = -1;
+    c->cache_used = 0;
+    c->head = c->tail = c->free_list = -1;
+}
+
+static inline void calc_expr_init(CalcExprCtx *c, CalcPrecision prec) {
+    c->prec = prec;
+    c->memory = 0.0;
+    c->degrees = 0;
+    c->hits = c->misses = c->evictions = c->invalidations = c->resets = 0;
+    calc_expr_reset(c);
+}
+
+static inline void calc_expr_set_memory(CalcExprCtx *c, double memory) {
+    if (memcmp(&c->memory, &memory, sizeof(double)) == 0) return;
+    c->memory = memory;
+    calc_expr_invalidate(c, CALC_DEP_MEMORY);
+}
+
+static inline void calc_expr_set_degrees(CalcExprCtx *c, int degrees) {
+    if (c->degrees == degrees) return;
+    c->degrees = degrees;
+    calc_expr_invalidate(c, CALC_DEP_ANGLE);
+}
+
+static inline void calc_expr_set_precision(CalcExprCtx *c, CalcPrecision prec) {
+    if (c->prec == prec) return;
+    c->prec = prec;
+    calc_expr_reset(c);
+}
+
+// ------------------ Hash-consing ------------------
+static inline size_t calc_value_size(CalcPrecision p) {
+    switch (p) {
+        case CALC_FLOAT:       return sizeof(float);
+        case CALC_LONG_DOUBLE: return LDBL_MANT_DIG == 64 ? 10 : sizeof(long double); // skip x87 padding
+#ifdef CALC_HAVE_FLOAT128
+        case CALC_QUAD:        return sizeof(__float128);
+#endif
+        default:               return sizeof(double);
+    }
+}
+
+static inline uint32_t calc_hash_bytes(uint32_t h, const void *data, size_t n) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < n; ++i) h = (h ^ p[i]) * 16777619u;   // FNV-1a
+    return h;
+}
+
+// Return the id of the node with this shape, creating it if needed; -1 if full
+static inline int calc_intern(CalcExprCtx *c, CalcNodeKind kind, CalcOp op, int a, int b,
+                              const CalcValue *num) {
+    size_t vsz = kind == CALC_NODE_NUM ? calc_value_size(c->prec) : 0;
+    int key[4] = { (int)kind, (int)op, a, b };
+    uint32_t h = calc_hash_bytes(2166136261u, key, sizeof(key));
+    if (vsz) h = calc_hash_bytes(h, &num->u, vsz);
+
+    uint32_t slot = h & (CALC_EXPR_HASH_SZ - 1);
+    while (c->intern[slot] >= 0) {
+        CalcNode *n = &c->nodes[c->intern[slot]];
+        if (n->hash == h && n->kind == kind && n->op == op && n->a == a && n->b == b &&
+            (!vsz || memcmp(&n->num.u, &num->u, vsz) == 0)) {
+            return c->intern[slot];
+        }
+        slot = (slot + 1) & (CALC_EXPR_HASH_SZ - 1);
+    }
+    if (c->node_count >= CALC_EXPR_MAX_NODES) return -1;
+
+    int id = c->node_count++;
+    CalcNode *n = &c->nodes[id];
+    n->kind = kind;
+    n->op = op;
+    n->a = a;
+    n->b = b;
+    n->hash = h;
+    n->cache_slot = -1;
+    n->deps = (kind == CALC_NODE_MEM) ? CALC_DEP_MEMORY : 0;
+    if (kind == CALC_NODE_OP && (op == CALC_SIN || op == CALC_COS || op == CALC_TAN)) n->deps |= CALC_DEP_ANGLE;
+    if (a >= 0) n->deps |= c->nodes[a].deps;
+    if (b >= 0) n->deps |= c->nodes[b].deps;
+    if (vsz) n->num = *num;
+    c->intern[slot] = id;
+    return id;
+}
+
+// ------------------ Parser ------------------
+static inline int calc_parse_expr(CalcExprCtx *c);
+
+static inline void calc_skip_spaces(CalcExprCtx *c) {
+    while (isspace((unsigned char)*c->pos)) c->pos++;
+}
+
+static inline int calc_fail(CalcExprCtx *c, const char *msg) {
+    if (!c->err[0]) snprintf(c->err, sizeof(c->err), "%s", msg);
+    return -1;
+}
+
+static inline int calc_node_op(CalcExprCtx *c, CalcOp op, int a, int b) {
+    if (a < 0 || b < -1 || (CALC_OPS[op].arity == 2 && b < 0)) return -1;
+    int id = calc_intern(c, CALC_NODE_OP, op, a, b, NULL);
+    return id < 0 ? calc_fail(c, "expression too large") : id;
+}
+
+static inline int calc_node_const(CalcExprCtx *c, const CalcValue *v) {
+    int id = calc_intern(c, CALC_NODE_NUM, CALC_ADD, -1, -1, v);
+    return id < 0 ? calc_fail(c, "expression too large") : id;
+}
+
+static inline int calc_parse_atom(CalcExprCtx *c) {
+    calc_skip_spaces(c);
+    const char *start = c->pos;
+
+    if (*start == '(') {
+        c->pos++;
+        int id = calc_parse_expr(c);
+        calc_skip_spaces(c);
+        if (*c->pos != ')') return calc_fail(c, "missing ')'");
+        c->pos++;
+        return id;
+    }
+
+    if (isdigit((unsigned char)*start) || *start == '.') {
+        char *end;
+        char tok[64];
+        CalcValue v;
+        strtold(start, &end);
+        size_t len = (size_t)(end - start);
+        if (len == 0 || len >= sizeof(tok)) return calc_fail(c, "bad number");
+        memcpy(tok, start, len);
+        tok[len] = '\0';
+        if (!calc_parse(c->prec, tok, &v)) return calc_fail(c, "bad number");
+        c->pos = end;
+        return calc_node_const(c, &v);
+    }
+
+    if (isalpha((unsigned char)*start)) {
+        char name[16];
+        size_t len = 0;
+        while (isalnum((unsigned char)c->pos[0]) && len < sizeof(name) - 1) name[len++] = *c->pos++;
+        name[len] = '\0';
+
+        if (strcmp(name, "m") == 0 || strcmp(name, "mem") == 0) {
+            int id = calc_intern(c, CALC_NODE_MEM, CALC_ADD, -1, -1, NULL);
+            return id < 0 ? calc_fail(c, "expression too large") : id;
+        }
+        if (strcmp(name, "pi") == 0 || strcmp(name, "e") == 0) {
+            CalcValue v = calc_from_double(c->prec, name[0] == 'p' ? 180.0 : 1.0);
+            v = calc_compute(name[0] == 'p' ? CALC_DEG2RAD : CALC_EXP, &v, NULL);
+            return calc_node_const(c, &v);
+        }
+
+        int op = calc_op_find(name);
+        if (op < 0 || op == CALC_DEG2RAD) return calc_fail(c, "unknown name");
+        calc_skip_spaces(c);
+        if (*c->pos != '(') return calc_fail(c, "expected '(' after function");
+        c->pos++;
+        int a = calc_parse_expr(c), b = -1;
+        calc_skip_spaces(c);
+        if (CALC_OPS[op].arity == 2) {
+            if (*c->pos != ',') return calc_fail(c, "expected ','");
+            c->pos++;
+            b = calc_parse_expr(c);
+            calc_skip_spaces(c);
+        }
+        if (*c->pos != ')') return calc_fail(c, "missing ')'");
+        c->pos++;
+        return calc_node_op(c, (CalcOp)op, a, b);
+    }
+
+    return calc_fail(c, "unexpected character");
+}
+
+static inline int calc_parse_unary(CalcExprCtx *c);
+
+static inline int calc_parse_power(CalcExprCtx *c) {
+    int base = calc_parse_atom(c);
+    calc_skip_spaces(c);
+    if (*c->pos == '^') {
+        c->pos++;
+        return calc_node_op(c, CALC_POW, base, calc_parse_unary(c));
+    }
+    return base;
+}
+
+static inline int calc_parse_unary(CalcExprCtx *c) {
+    calc_skip_spaces(c);
+    if (*c->pos == '-') {
+        c->pos++;
+        CalcValue zero = calc_from_double(c->prec, 0.0);
+        int z = calc_node_const(c, &zero);
+        return calc_node_op(c, CALC_SUB, z, calc_parse_unary(c));
+    }
+    if (*c->pos == '+') c->pos++;
+    return calc_parse_power(c);
+}
+
+static inline int calc_parse_term(CalcExprCtx *c) {
+    int left = calc_parse_unary(c);
+    for (;;) {
+        calc_skip_spaces(c);
+        char ch = *c->pos;
+        if (ch != '*' && ch != '/') return left;
+        c->pos++;
+        left = calc_node_op(c, ch == '*' ? CALC_MUL : CALC_DIV, left, calc_parse_unary(c));
+    }
+}
+
+static inline int calc_parse_expr(CalcExprCtx *c) {
+    int left = calc_parse_term(c);
+    for (;;) {
+        calc_skip_spaces(c);
+        char ch = *c->pos;
+        if (ch != '+' && ch != '-') return left;
+        c->pos++;
+        left = calc_node_op(c, ch == '+' ? CALC_ADD : CALC_SUB, left, calc_parse_term(c));
+    }
+}
+
+// ------------------ Evaluation ------------------
+static inline int calc_eval_node(CalcExprCtx *c, int id, CalcValue *out) {
+    CalcNode *n = &c->nodes[id];
+    if (n->kind == CALC_NODE_NUM) { *out = n->num; return 1; }
+    if (n->kind == CALC_NODE_MEM) { *out = calc_from_double(c->prec, c->memory); return 1; }
+
+    if (n->cache_slot >= 0) {
+        int s = n->cache_slot;
+        c->hits++;
+        calc_lru_unlink(c, s);
+        calc_lru_push_front(c, s);
+        *out = c->cache[s].value;
+        return 1;
+    }
+    c->misses++;
+
+    CalcValue a, b;
+    if (!calc_eval_node(c, n->a, &a)) return 0;
+    if (n->b >= 0 && !calc_eval_node(c, n->b, &b)) return 0;
+    if (n->op == CALC_DIV && calc_is_zero(&b)) {
+        snprintf(c->err, sizeof(c->err), "division by zero");
+        return 0;
+    }
+    if ((n->deps & CALC_DEP_ANGLE) && c->degrees &&
+        (n->op == CALC_SIN || n->op == CALC_COS || n->op == CALC_TAN)) {
+        a = calc_compute(CALC_DEG2RAD, &a, NULL);
+    }
+    *out = calc_compute(n->op, &a, n->b >= 0 ? &b : NULL);
+    calc_lru_store(c, id, out);
+    return 1;
+}
+
+// Parse and evaluate one line. On failure err describes the problem.
+static inline CalcExprStatus calc_expr_eval(CalcExprCtx *c, const char *text, CalcValue *out) {
+    c->err[0] = '\0';
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        c->pos = text;
+        int root = calc_parse_expr(c);
+        calc_skip_spaces(c);
+        if (root >= 0 && *c->pos == '\0') {
+            return calc_eval_node(c, root, out) ? CALC_EXPR_OK : CALC_EXPR_MATH;
+        }
+        // A full node pool gets one retry from an empty session
+        if (attempt == 0 && strcmp(c->err, "expression too large") == 0) {
+            calc_expr_reset(c);
+            c->resets++;
+            c->err[0] = '\0';
+            continue;
+        }
+        break;
+    }
+    if (!c->err[0]) snprintf(c->err, sizeof(c->err), "unexpected input");
+    return CALC_EXPR_SYNTAX;
+}
+
+#endif // CALC_EXPR_H
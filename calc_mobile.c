@@ -1,9 +1,539 @@
+// calc_mobile.c
+// Line-based console calculator
+// Compile: gcc -O2 calc_mobile.c -o calc_mobile -lm -pthread
+//     with __float128: add -DCALC_FLOAT128 -lquadmath
+// Precision: ./calc_mobile --precision float|double|long|quad
+// Benchmark: ./calc_mobile --bench-precision [n]
+// Stats mode: ./calc_mobile --stats <file|-> [threads]
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <time.h>
+#include "calc_core.h"
+#include "calc_expr.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 double memory = 0.0; // Memory register
+CalcPrecision precision = CALC_DOUBLE; // Number type used for calculations
+CalcExprCtx expr_ctx;                  // Expression cache for the session
+
+// ------------------ Streaming statistics ------------------
+// Online mean/variance (Welford), min/max and a KLL-style quantile sketch.
+// Every level of the sketch holds at most KLL_K items; when a level fills up
+// it is sorted and every other item is promoted to the next level with twice
+// the weight. Memory is fixed at KLL_LEVELS * KLL_K doubles per sketch no
+// matter how many numbers are fed in, and two sketches merge by pushing the
+// items of one into the other level by level.
+#define KLL_K 256
+#define KLL_LEVELS 48
+#define STATS_MAX_THREADS 64
+
+typedef struct {
+    double items[KLL_LEVELS][KLL_K];
+    int size[KLL_LEVELS];
+    int levels;           // number of levels in use
+    uint64_t rng;         // coin flips for compaction offsets
+} KllSketch;
+
+typedef struct {
+    uint64_t n;
+    double mean;
+    double m2;            // sum of squared deviations from the mean
+    double min, max;
+    uint64_t bad;         // tokens that were not numbers
+    KllSketch sketch;
+} StatsAcc;
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void kll_init(KllSketch *s, uint64_t seed) {
+    memset(s->size, 0, sizeof(s->size));
+    s->levels = 1;
+    s->rng = seed ? seed : 0x9E3779B97F4A7C15ULL;
+}
+
+static int kll_coin(KllSketch *s) {
+    // xorshift64
+    s->rng ^= s->rng << 13;
+    s->rng ^= s->rng >> 7;
+    s->rng ^= s->rng << 17;
+    return (int)(s->rng >> 63);
+}
+
+static void kll_push(KllSketch *s, int level, double x);
+
+// Sort a full level and promote one item out of every pair
+static void kll_compact(KllSketch *s, int level) {
+    int n = s->size[level];
+    double *it = s->items[level];
+    if (level + 1 >= KLL_LEVELS) {
+        // Out of levels (more than 2^48 * KLL_K items): drop half instead
+        s->size[level] = n / 2;
+        return;
+    }
+    qsort(it, n, sizeof(double), cmp_double);
+    s->size[level] = 0;
+    if (level + 1 >= s->levels) s->levels = level + 2;
+    for (int i = kll_coin(s); i < n; i += 2) kll_push(s, level + 1, it[i]);
+}
+
+static void kll_push(KllSketch *s, int level, double x) {
+    if (s->size[level] == KLL_K) kll_compact(s, level);
+    s->items[level][s->size[level]++] = x;
+}
+
+static void kll_merge(KllSketch *dst, const KllSketch *src) {
+    for (int h = 0; h < src->levels; h++) {
+        if (h >= dst->levels) dst->levels = h + 1;
+        for (int i = 0; i < src->size[h]; i++) kll_push(dst, h, src->items[h][i]);
+    }
+}
+
+// Approximate quantiles for q[0..nq-1] (each in [0,1]), written to out[]
+static void kll_quantiles(const KllSketch *s, const double *q, int nq, double *out) {
+    int total = 0;
+    for (int h = 0; h < s->levels; h++) total += s->size[h];
+    if (total == 0) {
+        for (int i = 0; i < nq; i++) out[i] = NAN;
+        return;
+    }
+
+    typedef struct { double v; uint64_t w; } Weighted;
+    Weighted *all = malloc(sizeof(Weighted) * total);
+    if (!all) {
+        for (int i = 0; i < nq; i++) out[i] = NAN;
+        return;
+    }
+    int k = 0;
+    uint64_t weight_sum = 0;
+    for (int h = 0; h < s->levels; h++) {
+        for (int i = 0; i < s->size[h]; i++) {
+            all[k].v = s->items[h][i];
+            all[k].w = 1ULL << h;
+            weight_sum += all[k].w;
+            k++;
+        }
+    }
+    // cmp_double only looks at the leading value member
+    qsort(all, total, sizeof(Weighted), cmp_double);
+
+    for (int i = 0; i < nq; i++) {
+        double target = q[i] * (double)weight_sum;
+        uint64_t cum = 0;
+        int j = 0;
+        while (j < total - 1 && (double)(cum + all[j].w) < target) cum += all[j++].w;
+        out[i] = all[j].v;
+    }
+    free(all);
+}
+
+static void stats_init(StatsAcc *a, uint64_t seed) {
+    a->n = 0;
+    a->mean = 0.0;
+    a->m2 = 0.0;
+    a->min = INFINITY;
+    a->max = -INFINITY;
+    a->bad = 0;
+    kll_init(&a->sketch, seed);
+}
+
+static void stats_add(StatsAcc *a, double x) {
+    a->n++;
+    double delta = x - a->mean;
+    a->mean += delta / (double)a->n;
+    a->m2 += delta * (x - a->mean);
+    if (x < a->min) a->min = x;
+    if (x > a->max) a->max = x;
+    kll_push(&a->sketch, 0, x);
+}
+
+// Combine two accumulators (Chan et al. parallel variance formula)
+static void stats_merge(StatsAcc *dst, const StatsAcc *src) {
+    if (src->n > 0) {
+        if (dst->n == 0) {
+            dst->n = src->n;
+            dst->mean = src->mean;
+            dst->m2 = src->m2;
+        } else {
+            double n1 = (double)dst->n, n2 = (double)src->n;
+            double delta = src->mean - dst->mean;
+            double n = n1 + n2;
+            dst->mean += delta * n2 / n;
+            dst->m2 += src->m2 + delta * delta * n1 * n2 / n;
+            dst->n += src->n;
+        }
+        if (src->min < dst->min) dst->min = src->min;
+        if (src->max > dst->max) dst->max = src->max;
+    }
+    dst->bad += src->bad;
+    kll_merge(&dst->sketch, &src->sketch);
+}
+
+static int is_separator(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' || c == ';';
+}
+
+// Parse every number in [p, end). Returns a pointer to the first byte of an
+// unfinished trailing token when final is 0 (so the caller can carry it over).
+static const char *stats_feed(StatsAcc *a, const char *p, const char *end, int final) {
+    char tok[64];
+    while (p < end) {
+        while (p < end && is_separator(*p)) p++;
+        const char *start = p;
+        while (p < end && !is_separator(*p)) p++;
+        if (p == start) break;
+        if (p == end && !final) return start;
+
+        size_t len = (size_t)(p - start);
+        if (len >= sizeof(tok)) { a->bad++; continue; }
+        memcpy(tok, start, len);
+        tok[len] = '\0';
+        char *stop;
+        double v = strtod(tok, &stop);
+        if (stop == tok || *stop != '\0' || isnan(v)) a->bad++;
+        else stats_add(a, v);
+    }
+    return end;
+}
+
+// Read a stream in fixed-size blocks (stdin, or any file on platforms without mmap)
+static void stats_stream(StatsAcc *a, FILE *fp) {
+    enum { BLOCK = 1 << 16 };
+    static char buf[BLOCK + 64];
+    size_t carry = 0, got;
+    while ((got = fread(buf + carry, 1, BLOCK, fp)) > 0) {
+        const char *end = buf + carry + got;
+        const char *rest = stats_feed(a, buf, end, 0);
+        carry = (size_t)(end - rest);
+        if (carry >= 64) {          // absurdly long token: skip it
+            a->bad++;
+            carry = 0;
+        }
+        memmove(buf, rest, carry);
+    }
+    stats_feed(a, buf, buf + carry, 1);
+}
+
+#ifndef _WIN32
+typedef struct {
+    const char *begin, *end;
+    StatsAcc *acc;
+} StatsChunk;
+
+static void *stats_worker(void *arg) {
+    StatsChunk *c = arg;
+    stats_feed(c->acc, c->begin, c->end, 1);
+    return NULL;
+}
+
+// mmap the file and give each thread a chunk cut at a separator
+static int stats_file_parallel(StatsAcc *out, const char *path, int threads) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0) { close(fd); return -1; }
+    size_t size = (size_t)st.st_size;
+    if (size == 0) { close(fd); return 0; }
+
+    const char *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return -1;
+    madvise((void *)data, size, MADV_SEQUENTIAL);
+
+    if (threads < 1) threads = 1;
+    if (threads > STATS_MAX_THREADS) threads = STATS_MAX_THREADS;
+    if ((size_t)threads > size / 4096 + 1) threads = (int)(size / 4096 + 1);
+
+    StatsChunk chunks[STATS_MAX_THREADS];
+    pthread_t tid[STATS_MAX_THREADS];
+    StatsAcc *accs = malloc(sizeof(StatsAcc) * threads);
+    if (!accs) { munmap((void *)data, size); return -1; }
+
+    const char *pos = data, *end = data + size;
+    for (int t = 0; t < threads; t++) {
+        const char *cut = (t == threads - 1) ? end : data + size / threads * (t + 1);
+        if (cut < pos) cut = pos;
+        while (cut < end && !is_separator(*cut)) cut++;
+        chunks[t].begin = pos;
+        chunks[t].end = cut;
+        chunks[t].acc = &accs[t];
+        stats_init(&accs[t], 0x9E3779B97F4A7C15ULL * (t + 1));
+        pos = cut;
+    }
+    int started = 0;
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&tid[t], NULL, stats_worker, &chunks[t]) != 0) break;
+        started = t;
+    }
+    stats_worker(&chunks[0]);
+    // Any chunk whose thread failed to start is processed here
+    for (int t = started + 1; t < threads; t++) stats_worker(&chunks[t]);
+    for (int t = 1; t <= started; t++) pthread_join(tid[t], NULL);
+
+    for (int t = 0; t < threads; t++) stats_merge(out, &accs[t]);
+    free(accs);
+    munmap((void *)data, size);
+    return 0;
+}
+#endif
+
+static int default_threads() {
+#ifdef _SC_NPROCESSORS_ONLN
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n > 0) return (int)n;
+#endif
+    return 1;
+}
+
+// Run the stats mode over a file ("-" or NULL means stdin) and print a report
+int run_stats(const char *path, int threads) {
+    StatsAcc *acc = malloc(sizeof(StatsAcc));
+    if (!acc) { printf("Error: out of memory\n"); return 1; }
+    stats_init(acc, 0);
+
+    if (!path || strcmp(path, "-") == 0) {
+        stats_stream(acc, stdin);
+    } else {
+#ifndef _WIN32
+        if (stats_file_parallel(acc, path, threads) != 0) {
+            printf("Error: cannot read '%s'\n", path);
+            free(acc);
+            return 1;
+        }
+#else
+        (void)threads;
+        FILE *fp = fopen(path, "rb");
+        if (!fp) {
+            printf("Error: cannot read '%s'\n", path);
+            free(acc);
+            return 1;
+        }
+        stats_stream(acc, fp);
+        fclose(fp);
+#endif
+    }
+
+    static const double qs[] = { 0.01, 0.05, 0.25, 0.50, 0.75, 0.95, 0.99 };
+    double qv[sizeof(qs) / sizeof(qs[0])];
+    kll_quantiles(&acc->sketch, qs, (int)(sizeof(qs) / sizeof(qs[0])), qv);
+
+    printf("=============================================\n");
+    printf("           Streaming Statistics              \n");
+    printf("=============================================\n");
+    printf(" Count      : %llu\n", (unsigned long long)acc->n);
+    if (acc->bad) printf(" Skipped    : %llu (not numbers)\n", (unsigned long long)acc->bad);
+    if (acc->n > 0) {
+        double var = acc->n > 1 ? acc->m2 / (double)(acc->n - 1) : 0.0;
+        printf(" Mean       : %.10g\n", acc->mean);
+        printf(" Variance   : %.10g\n", var);
+        printf(" Std dev    : %.10g\n", sqrt(var));
+        printf(" Min        : %.10g\n", acc->min);
+        printf(" Max        : %.10g\n", acc->max);
+        printf("---------------------------------------------\n");
+        printf(" Quantiles (approximate, KLL k=%d):\n", KLL_K);
+        for (size_t i = 0; i < sizeof(qs) / sizeof(qs[0]); i++) {
+            printf("   p%-5g : %.10g\n", qs[i] * 100.0, qv[i]);
+        }
+    }
+    printf("=============================================\n");
+    free(acc);
+    return 0;
+}
+
+// ------------------ Evaluation ------------------
+// Print a result: double keeps the classic %lf look, the other precisions
+// print every significant digit of their type.
+void print_result(const CalcValue *v) {
+    char buf[128];
+    if (v->prec == CALC_DOUBLE) calc_format(v, 'f', 6, buf, sizeof(buf));
+    else calc_format(v, 'g', -1, buf, sizeof(buf));
+    printf("= %s\n", buf);
+}
+
+// Copy [begin, end) into out with surrounding spaces removed
+static void copy_trimmed(const char *begin, const char *end, char *out, size_t sz) {
+    while (begin < end && isspace((unsigned char)*begin)) begin++;
+    while (end > begin && isspace((unsigned char)end[-1])) end--;
+    size_t len = (size_t)(end - begin);
+    if (len >= sz) len = sz - 1;
+    memcpy(out, begin, len);
+    out[len] = '\0';
+}
+
+// Evaluate "a <op> b" or "<func> x [y]" in the selected precision.
+// Returns 1 if the line was a calculation (printed or reported as an error).
+int eval_line(const char *input) {
+    char lhs[64], rhs[64], name[16];
+    CalcValue a, b, r;
+    int op = -1;
+
+    // Infix form: the first operand's extent is found with strtold, then
+    // both operands are re-parsed in the selected type
+    char *end;
+    strtold(input, &end);
+    if (end != input) {
+        const char *p = end;
+        while (isspace((unsigned char)*p)) p++;
+        if (*p == '+' || *p == '-' || *p == '*' || *p == '/') {
+            char opname[2] = { *p, '\0' };
+            op = calc_op_find(opname);
+            copy_trimmed(input, end, lhs, sizeof(lhs));
+            copy_trimmed(p + 1, p + strlen(p), rhs, sizeof(rhs));
+            if (!calc_parse(precision, lhs, &a) || !calc_parse(precision, rhs, &b)) return 0;
+            if (op == CALC_DIV && calc_is_zero(&b)) {
+                printf("Error: Division by zero\n");
+                return 1;
+            }
+            r = calc_compute((CalcOp)op, &a, &b);
+            print_result(&r);
+            return 1;
+        }
+        return 0;
+    }
+
+    // Function form
+    char extra;
+    int n = sscanf(input, "%15s %63s %63s %c", name, lhs, rhs, &extra);
+    if (n < 2 || n > 3) return 0;
+    op = calc_op_find(name);
+    if (op < 0 || !isalpha((unsigned char)name[0]) || CALC_OPS[op].arity != n - 1) return 0;
+    if (!calc_parse(precision, lhs, &a)) return 0;
+    if (n == 3 && !calc_parse(precision, rhs, &b)) return 0;
+    r = calc_compute((CalcOp)op, &a, n == 3 ? &b : NULL);
+    print_result(&r);
+    return 1;
+}
+
+// Evaluate a full expression such as "exp(log(5)) * (2 + m) ^ 2".
+// Returns 0 if the line is not an expression at all.
+int eval_expression(const char *input) {
+    CalcValue r;
+    calc_expr_set_precision(&expr_ctx, precision);
+    calc_expr_set_memory(&expr_ctx, memory);
+    CalcExprStatus st = calc_expr_eval(&expr_ctx, input, &r);
+    if (st == CALC_EXPR_SYNTAX) return 0;
+    if (st == CALC_EXPR_MATH) printf("Error: %s\n", expr_ctx.err);
+    else print_result(&r);
+    return 1;
+}
+
+void show_cache_stats() {
+    printf("Expression cache: %llu hits, %llu misses, %llu evictions, %llu invalidations, %d nodes\n",
+           expr_ctx.hits, expr_ctx.misses, expr_ctx.evictions, expr_ctx.invalidations,
+           expr_ctx.node_count);
+}
+
+// ------------------ Precision benchmark ------------------
+// Throughput of each number type over a column of inputs, and the worst
+// relative error against a wider reference type evaluated on the same
+// (already rounded) inputs.
+#ifdef CALC_HAVE_FLOAT128
+typedef __float128 BenchRef;
+#define BENCH_REF_NAME "quad"
+#else
+typedef long double BenchRef;
+#define BENCH_REF_NAME "long"
+#endif
+
+#define DEFINE_BENCH(T, TAG)                                                    \
+static double bench_##TAG(CalcOp op, const double *xa, const double *xb,       \
+                          size_t n, int reps, double *max_rel) {               \
+    T *a = malloc(n * sizeof(T)), *b = malloc(n * sizeof(T));                  \
+    T *out = malloc(n * sizeof(T));                                            \
+    if (!a || !b || !out) { free(a); free(b); free(out); return 0.0; }         \
+    for (size_t i = 0; i < n; ++i) { a[i] = (T)xa[i]; b[i] = (T)xb[i]; }       \
+    clock_t t0 = clock();                                                      \
+    for (int r = 0; r < reps; ++r) calc_map_##TAG(op, a, b, out, n);           \
+    double secs = (double)(clock() - t0) / CLOCKS_PER_SEC;                     \
+    *max_rel = 0.0;                                                            \
+    for (size_t i = 0; i < n; ++i) {                                           \
+        BenchRef ref = calc_binary(op, (BenchRef)a[i], (BenchRef)b[i]);        \
+        if (ref == 0) continue;                                                \
+        double rel = fabs((double)(((BenchRef)out[i] - ref) / ref));           \
+        if (rel > *max_rel) *max_rel = rel;                                    \
+    }                                                                          \
+    free(a); free(b); free(out);                                               \
+    return secs > 0 ? (double)n * reps / secs : 0.0;                           \
+}
+
+DEFINE_BENCH(float, f)
+DEFINE_BENCH(double, d)
+DEFINE_BENCH(long double, ld)
+#ifdef CALC_HAVE_FLOAT128
+DEFINE_BENCH(__float128, q)
+#endif
+
+static double bench_uniform(uint64_t *state, double lo, double hi) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return lo + (hi - lo) * (double)(*state >> 11) / 9007199254740992.0;
+}
+
+int run_precision_bench(size_t n) {
+    static const struct { CalcOp op; double alo, ahi, blo, bhi; } cases[] = {
+        { CALC_ADD,  0.1, 10.0, 0.1, 10.0 },
+        { CALC_MUL,  0.1, 10.0, 0.1, 10.0 },
+        { CALC_DIV,  0.1, 10.0, 0.1, 10.0 },
+        { CALC_SQRT, 0.0, 100.0, 0.0, 0.0 },
+        { CALC_SIN, -10.0, 10.0, 0.0, 0.0 },
+        { CALC_EXP, -20.0, 20.0, 0.0, 0.0 },
+        { CALC_LOG,  0.1, 100.0, 0.0, 0.0 },
+        { CALC_POW,  0.5, 2.0, -10.0, 10.0 },
+    };
+    double *xa = malloc(n * sizeof(double)), *xb = malloc(n * sizeof(double));
+    if (!xa || !xb) { printf("Error: out of memory\n"); return 1; }
+    uint64_t state = 88172645463325252ULL;
+
+    printf("=====================================================================\n");
+    printf(" Precision benchmark: %zu values per op, reference type: %s\n", n, BENCH_REF_NAME);
+    printf("=====================================================================\n");
+    printf(" %-6s %-7s %14s %14s %10s\n", "op", "type", "Mops/s", "max rel err", "bits");
+    printf("---------------------------------------------------------------------\n");
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+        for (size_t i = 0; i < n; ++i) {
+            xa[i] = bench_uniform(&state, cases[c].alo, cases[c].ahi);
+            xb[i] = bench_uniform(&state, cases[c].blo, cases[c].bhi);
+        }
+        int cheap = cases[c].op <= CALC_DIV || cases[c].op == CALC_SQRT;
+        int reps = cheap ? 20 : 2;
+        for (int p = 0; p < CALC_PRECISION_COUNT; ++p) {
+            double rate = 0.0, err = 0.0;
+            switch (p) {
+                case CALC_FLOAT:       rate = bench_f(cases[c].op, xa, xb, n, reps, &err); break;
+                case CALC_DOUBLE:      rate = bench_d(cases[c].op, xa, xb, n, reps, &err); break;
+                case CALC_LONG_DOUBLE: rate = bench_ld(cases[c].op, xa, xb, n, reps, &err); break;
+#ifdef CALC_HAVE_FLOAT128
+                case CALC_QUAD:    rate = bench_q(cases[c].op, xa, xb, n, reps, &err); break;
+#endif
+                default: continue;
+            }
+            char bits[16];
+            if (err > 0) snprintf(bits, sizeof(bits), "%.1f", -log2(err));
+            else snprintf(bits, sizeof(bits), "%s", "ref");
+            printf(" %-6s %-7s %14.2f %14.3e %10s\n", CALC_OPS[cases[c].op].name,
+                   CALC_PRECISION_NAMES[p], rate / 1e6, err, bits);
+        }
+    }
+    printf("=====================================================================\n");
+    free(xa);
+    free(xb);
+    return 0;
+}
 
 // HUD
 void show_hud() {
@@ -19,6 +549,9 @@ void show_hud() {
     printf(" Other       : fabs x  | floor x | ceil x     \n");
     printf("             | round x                       \n");
     printf(" Memory      : m+ x   | m- x   | mr (recall)  \n");
+    printf(" Expressions : pow(2, 0.5) * (m + 1) ^ 2      \n");
+    printf(" Statistics  : stats <file>                   \n");
+    printf(" Precision   : precision float|double|long|quad\n");
     printf("=============================================\n");
     printf(" Commands    : help   | exit                  \n");
     printf("=============================================\n");
@@ -67,15 +600,52 @@ void show_help() {
     printf("  m- x   -> Subtract x from memory\n");
     printf("  mr     -> Recall memory value\n\n");
 
+    printf("Expressions:\n");
+    printf("  Any expression with + - * / ^, parentheses, m (memory), pi, e\n");
+    printf("  and functions like sin(x), pow(a, b), log10(x)\n");
+    printf("  Repeated sub-expressions are answered from a cache\n");
+    printf("  cache  -> Show cache hits/misses\n\n");
+
+    printf("Precision:\n");
+    printf("  precision <type> -> Calculate in float, double, long (long double)\n");
+    printf("                      or quad (__float128, if compiled in)\n\n");
+
+    printf("Statistics:\n");
+    printf("  stats <file> -> Count, mean, variance, min, max and quantiles\n");
+    printf("                  of every number in a file ('-' reads stdin)\n\n");
+
     printf("Commands:\n");
     printf("  help   -> Show this help guide\n");
     printf("  exit   -> Quit the program\n");
     printf("=============================================\n\n");
 }
 
-int main() {
+int main(int argc, char **argv) {
     char input[100];
-    double a, b;
+    char path[100];
+    char pname[16];
+    double a;
+
+    // Non-interactive stats mode: calc_mobile --stats <file|-> [threads]
+    if (argc >= 2 && strcmp(argv[1], "--stats") == 0) {
+        int threads = argc >= 4 ? atoi(argv[3]) : default_threads();
+        return run_stats(argc >= 3 ? argv[2] : "-", threads);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--bench-precision") == 0) {
+        return run_precision_bench(argc >= 3 ? (size_t)atol(argv[2]) : 1000000);
+    }
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (strcmp(argv[i], "--precision") == 0) {
+            int p = calc_precision_find(argv[i + 1]);
+            if (p < 0) {
+                printf("Unknown or unavailable precision '%s'\n", argv[i + 1]);
+                return 1;
+            }
+            precision = (CalcPrecision)p;
+        }
+    }
+
+    calc_expr_init(&expr_ctx, precision);
     show_hud();
 
     while (1) {
@@ -95,32 +665,15 @@ int main() {
         }
 
         // Try parsing inputs
-        if (sscanf(input, "%lf + %lf", &a, &b) == 2) printf("= %lf\n", a + b);
-        else if (sscanf(input, "%lf - %lf", &a, &b) == 2) printf("= %lf\n", a - b);
-        else if (sscanf(input, "%lf * %lf", &a, &b) == 2) printf("= %lf\n", a * b);
-        else if (sscanf(input, "%lf / %lf", &a, &b) == 2) {
-            if (b != 0) printf("= %lf\n", a / b);
-            else printf("Error: Division by zero\n");
-        }
-        else if (sscanf(input, "pow %lf %lf", &a, &b) == 2) printf("= %lf\n", pow(a, b));
-        else if (sscanf(input, "sqrt %lf", &a) == 1) printf("= %lf\n", sqrt(a));
-        else if (sscanf(input, "cbrt %lf", &a) == 1) printf("= %lf\n", cbrt(a));
-        else if (sscanf(input, "sin %lf", &a) == 1) printf("= %lf\n", sin(a));
-        else if (sscanf(input, "cos %lf", &a) == 1) printf("= %lf\n", cos(a));
-        else if (sscanf(input, "tan %lf", &a) == 1) printf("= %lf\n", tan(a));
-        else if (sscanf(input, "asin %lf", &a) == 1) printf("= %lf\n", asin(a));
-        else if (sscanf(input, "acos %lf", &a) == 1) printf("= %lf\n", acos(a));
-        else if (sscanf(input, "atan %lf", &a) == 1) printf("= %lf\n", atan(a));
-        else if (sscanf(input, "sinh %lf", &a) == 1) printf("= %lf\n", sinh(a));
-        else if (sscanf(input, "cosh %lf", &a) == 1) printf("= %lf\n", cosh(a));
-        else if (sscanf(input, "tanh %lf", &a) == 1) printf("= %lf\n", tanh(a));
-        else if (sscanf(input, "log %lf", &a) == 1) printf("= %lf\n", log(a));
-        else if (sscanf(input, "log10 %lf", &a) == 1) printf("= %lf\n", log10(a));
-        else if (sscanf(input, "exp %lf", &a) == 1) printf("= %lf\n", exp(a));
-        else if (sscanf(input, "fabs %lf", &a) == 1) printf("= %lf\n", fabs(a));
-        else if (sscanf(input, "floor %lf", &a) == 1) printf("= %lf\n", floor(a));
-        else if (sscanf(input, "ceil %lf", &a) == 1) printf("= %lf\n", ceil(a));
-        else if (sscanf(input, "round %lf", &a) == 1) printf("= %lf\n", round(a));
+        if (eval_line(input)) continue;
+        else if (sscanf(input, "precision %15s", pname) == 1) {
+            int p = calc_precision_find(pname);
+            if (p < 0) printf("Unknown or unavailable precision '%s'\n", pname);
+            else {
+                precision = (CalcPrecision)p;
+                printf("Precision = %s\n", CALC_PRECISION_NAMES[p]);
+            }
+        }
         else if (sscanf(input, "m+ %lf", &a) == 1) {
             memory += a;
             printf("Memory = %lf\n", memory);
@@ -129,7 +682,14 @@ int main() {
             memory -= a;
             printf("Memory = %lf\n", memory);
         }
+        else if (sscanf(input, "stats %99s", path) == 1) {
+            // stdin is the session itself here; only --stats can read it
+            if (strcmp(path, "-") == 0) printf("Error: give a file name ('-' works only with --stats)\n");
+            else run_stats(path, default_threads());
+        }
         else if (strcmp(input, "mr") == 0) printf("Memory Recall = %lf\n", memory);
+        else if (strcmp(input, "cache") == 0) show_cache_stats();
+        else if (eval_expression(input)) continue;
         else printf("Unknown command. Type 'help' for instructions.\n");
     }
     return 0;
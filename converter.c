@@ -1,31 +1,135 @@
+// converter.c
+// Number system converter (binary / octal / decimal / hexadecimal)
+// Compile: gcc -O2 converter.c -o converter -pthread -lm
+// Batch:   ./converter --batch <file> [base]   (one number per line -> CSV)
+// Bench:   ./converter --bench [count]
+// Big:     ./converter --big <from-base> <to-base> [file]   (any length)
+//          ./converter --bench-big [decimal-digits]
+//          ./converter --bench-parse [megabytes]
+// Dump:    ./converter --dump <hex|hexbits|octbits|bin> <file|-> [threads]
+//          ./converter --undump <hex|hexbits|octbits|bin> [file|-]
+//          ./converter --bench-dump <file> [threads]
+// Fields:  ./converter --fields <i8..i64|u8..u64|f16|f32|f64> <file|-> [--be] [--summary]
+// Build with -march=native (or -mssse3 / -mavx2) for the SIMD parsers.
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <time.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#else
+#include <io.h>
+#include <fcntl.h>
+#endif
 
 // --- Input Validation Helpers ---
-int isValidBinary(const char *s) {
-    while (*s) {
-        if (*s != '0' && *s != '1') return 0;
-        s++;
+// findInvalidDigit() checks 32 (AVX2) or 16 (SSE2) characters per step with
+// unsigned range compares and returns the index of the first character that
+// is not a digit of the base (len if all are valid). Other CPUs use the
+// scalar loop, which is also used for the tail.
+
+int ctz32(unsigned m) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(m);
+#else
+    int n = 0;
+    while (!(m & 1)) { m >>= 1; n++; }
+    return n;
+#endif
+}
+
+int isDigitOf(char ch, int base) {
+    unsigned d = (unsigned char)ch - '0';
+    if (base <= 10) return d < (unsigned)base;
+    return d < 10 || (unsigned)((ch | 0x20) - 'a') < 6;
+}
+
+#ifdef __SSE2__
+// Bit i set when byte i of c is not a digit of base
+static unsigned invalidMask16(__m128i c, int base) {
+    __m128i d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    __m128i limit = _mm_set1_epi8((char)((base < 10 ? base : 10) - 1));
+    __m128i ok = _mm_cmpeq_epi8(_mm_min_epu8(d, limit), d);
+    if (base == 16) {
+        __m128i a = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        __m128i five = _mm_set1_epi8(5);
+        ok = _mm_or_si128(ok, _mm_cmpeq_epi8(_mm_min_epu8(a, five), a));
     }
-    return 1;
+    return (unsigned)_mm_movemask_epi8(ok) ^ 0xFFFFu;
 }
+#endif
 
-int isValidOctal(const char *s) {
-    while (*s) {
-        if (*s < '0' || *s > '7') return 0;
-        s++;
+#ifdef __AVX2__
+static unsigned invalidMask32(__m256i c, int base) {
+    __m256i d = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    __m256i limit = _mm256_set1_epi8((char)((base < 10 ? base : 10) - 1));
+    __m256i ok = _mm256_cmpeq_epi8(_mm256_min_epu8(d, limit), d);
+    if (base == 16) {
+        __m256i a = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+        __m256i five = _mm256_set1_epi8(5);
+        ok = _mm256_or_si256(ok, _mm256_cmpeq_epi8(_mm256_min_epu8(a, five), a));
     }
-    return 1;
+    return ~(unsigned)_mm256_movemask_epi8(ok);
 }
+#endif
 
-int isValidHex(const char *s) {
-    while (*s) {
-        if (!isxdigit(*s)) return 0;
-        s++;
+size_t findInvalidDigit(const char *s, size_t len, int base) {
+    size_t i = 0;
+#ifdef __AVX2__
+    for (; i + 32 <= len; i += 32) {
+        unsigned bad = invalidMask32(_mm256_loadu_si256((const __m256i *)(s + i)), base);
+        if (bad) return i + ctz32(bad);
     }
-    return 1;
+#endif
+#ifdef __SSE2__
+    for (; i + 16 <= len; i += 16) {
+        unsigned bad = invalidMask16(_mm_loadu_si128((const __m128i *)(s + i)), base);
+        if (bad) return i + ctz32(bad);
+    }
+#endif
+    for (; i < len; i++) {
+        if (!isDigitOf(s[i], base)) return i;
+    }
+    return len;
+}
+
+int isValidBinary(const char *s) {
+    size_t len = strlen(s);
+    return findInvalidDigit(s, len, 2) == len;
+}
+
+int isValidOctal(const char *s) {
+    size_t len = strlen(s);
+    return findInvalidDigit(s, len, 8) == len;
+}
+
+int isValidHex(const char *s) {
+    size_t len = strlen(s);
+    return findInvalidDigit(s, len, 16) == len;
+}
+
+int isValidDecimal(const char *s) {
+    size_t len = strlen(s);
+    return findInvalidDigit(s, len, 10) == len;
 }
 
 // --- Utility Functions ---
@@ -133,32 +237,1980 @@ unsigned long long binToDec(const char *bin) {
     return dec;
 }
 
+// --- Fast Conversion Kernels ---
+// The functions above build each representation separately, digit by digit,
+// and reverse the result. The kernels below get the bit length once with
+// clz, then write every representation forward from the most significant
+// digit using lookup tables: 8 binary characters per byte, 2 hex digits per
+// byte (or one SSSE3 shuffle for all 16 hex digits) and 2 decimal digits per
+// division.
+
+static char BIN8[256][8];      // byte -> "00000000".."11111111"
+static char DEC2[200];         // "00".."99"
+static const char HEX_DIGITS[] = "0123456789ABCDEF";
+static int tablesReady = 0;
+
+void initTables() {
+    if (tablesReady) return;
+    for (int b = 0; b < 256; b++)
+        for (int k = 0; k < 8; k++) BIN8[b][k] = (char)('0' + ((b >> (7 - k)) & 1));
+    for (int d = 0; d < 100; d++) {
+        DEC2[2 * d] = (char)('0' + d / 10);
+        DEC2[2 * d + 1] = (char)('0' + d % 10);
+    }
+    tablesReady = 1;
+}
+
+// Number of significant bits (0 for 0)
+int bitLength(unsigned long long v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return v ? 64 - __builtin_clzll(v) : 0;
+#else
+    int n = 0;
+    while (v) { n++; v >>= 1; }
+    return n;
+#endif
+}
+
+// Each writer appends at p and returns the new end (no terminator)
+char *writeBin(unsigned long long v, int bits, char *p) {
+    if (bits == 0) { *p++ = '0'; return p; }
+    int lead = ((bits - 1) & 7) + 1;             // bits in the top byte
+    int byte = (bits - 1) >> 3;
+    memcpy(p, BIN8[(v >> (byte * 8)) & 0xFF] + (8 - lead), lead);
+    p += lead;
+    while (byte-- > 0) {
+        memcpy(p, BIN8[(v >> (byte * 8)) & 0xFF], 8);
+        p += 8;
+    }
+    return p;
+}
+
+char *writeOct(unsigned long long v, int bits, char *p) {
+    int digits = bits ? (bits + 2) / 3 : 1;
+    for (int i = digits - 1; i >= 0; i--) *p++ = (char)('0' + ((v >> (3 * i)) & 7));
+    return p;
+}
+
+char *writeHex(unsigned long long v, int bits, char *p) {
+    int digits = bits ? (bits + 3) / 4 : 1;
+#ifdef __SSSE3__
+    // Spread the 16 nibbles over 16 bytes and map them with one shuffle
+    __m128i bytes = _mm_cvtsi64_si128((long long)__builtin_bswap64(v));
+    __m128i lo = _mm_and_si128(bytes, _mm_set1_epi8(0x0F));
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), _mm_set1_epi8(0x0F));
+    __m128i nibbles = _mm_unpacklo_epi8(hi, lo);
+    __m128i chars = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)HEX_DIGITS), nibbles);
+    char all[16];
+    _mm_storeu_si128((__m128i *)all, chars);
+    memcpy(p, all + (16 - digits), digits);
+    return p + digits;
+#else
+    for (int i = digits - 1; i >= 0; i--) *p++ = HEX_DIGITS[(v >> (4 * i)) & 0xF];
+    return p;
+#endif
+}
+
+char *writeDec(unsigned long long v, char *p) {
+    char tmp[20];
+    char *t = tmp + sizeof(tmp);
+    while (v >= 100) {
+        unsigned d = (unsigned)(v % 100);
+        v /= 100;
+        t -= 2;
+        memcpy(t, DEC2 + 2 * d, 2);
+    }
+    if (v >= 10) { t -= 2; memcpy(t, DEC2 + 2 * v, 2); }
+    else *--t = (char)('0' + v);
+    size_t len = (size_t)(tmp + sizeof(tmp) - t);
+    memcpy(p, t, len);
+    return p + len;
+}
+
+// Octal digits as 3-bit groups separated by spaces, same layout as decToOctBits()
+char *writeOctBits(unsigned long long v, int bits, char *p) {
+    int digits = bits ? (bits + 2) / 3 : 1;
+    for (int i = digits - 1; i >= 0; i--) {
+        memcpy(p, BIN8[(v >> (3 * i)) & 7] + 5, 3);
+        p += 3;
+        if (i > 0) *p++ = ' ';
+    }
+    return p;
+}
+
+// Hex digits as 4-bit groups separated by spaces, same layout as decToHexBits()
+char *writeHexBits(unsigned long long v, int bits, char *p) {
+    int digits = bits ? (bits + 3) / 4 : 1;
+    for (int i = digits - 1; i >= 0; i--) {
+        memcpy(p, BIN8[(v >> (4 * i)) & 0xF] + 4, 4);
+        p += 4;
+        if (i > 0) *p++ = ' ';
+    }
+    return p;
+}
+
+// All representations of one value, filled in a single call
+typedef struct {
+    char bin[65], oct[23], dec[21], hex[17];
+    char octBits[88], hexBits[80];
+} Conversions;
+
+void convertAll(unsigned long long v, Conversions *c) {
+    int bits = bitLength(v);
+    *writeBin(v, bits, c->bin) = '\0';
+    *writeOct(v, bits, c->oct) = '\0';
+    *writeDec(v, c->dec) = '\0';
+    *writeHex(v, bits, c->hex) = '\0';
+    *writeOctBits(v, bits, c->octBits) = '\0';
+    *writeHexBits(v, bits, c->hexBits) = '\0';
+}
+
+// One CSV line "decimal,binary,octal,hex\n" written straight into out
+char *writeCsvLine(unsigned long long v, char *p) {
+    int bits = bitLength(v);
+    p = writeDec(v, p);
+    *p++ = ',';
+    p = writeBin(v, bits, p);
+    *p++ = ',';
+    p = writeOct(v, bits, p);
+    *p++ = ',';
+    p = writeHex(v, bits, p);
+    *p++ = '\n';
+    return p;
+}
+
+// --- Batch Mode ---
+// Reads one number per line (in the given base) and writes CSV rows to
+// stdout through a large buffer flushed in big writes.
+#define BATCH_IN_SZ  (1 << 20)
+#define BATCH_OUT_SZ (1 << 22)
+#define CSV_LINE_MAX 128
+
+int runBatch(const char *path, int base) {
+    FILE *in = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    if (!in) {
+        fprintf(stderr, "[!] Cannot open %s\n", path);
+        return 1;
+    }
+    char *inBuf = malloc(BATCH_IN_SZ + 1);
+    char *outBuf = malloc(BATCH_OUT_SZ);
+    if (!inBuf || !outBuf) {
+        fprintf(stderr, "[!] Out of memory\n");
+        return 1;
+    }
+    initTables();
+
+    char *out = outBuf;
+    size_t carry = 0, got;
+    unsigned long long lineNo = 0, bad = 0;
+    int eof = 0;
+    while (!eof) {
+        got = fread(inBuf + carry, 1, BATCH_IN_SZ - carry, in);
+        if (got == 0) eof = 1;
+        size_t len = carry + got;
+        size_t start = 0;
+        for (size_t i = 0; i <= len; i++) {
+            if (i < len && inBuf[i] != '\n') continue;
+            if (i == len && !eof) break;         // partial line: carry it over
+            size_t end = i;
+            if (end > start && inBuf[end - 1] == '\r') end--;
+            if (end > start) {
+                lineNo++;
+                inBuf[end] = '\0';
+                char *stop = inBuf + start;
+                unsigned long long v = 0;
+                // strtoull() would skip leading blanks and wrap "-1" around, so the
+                // line must start with a letter or digit; strtoull() then rejects
+                // any that is not a digit of the base
+                errno = 0;
+                if (isalnum((unsigned char)inBuf[start])) v = strtoull(inBuf + start, &stop, base);
+                if (stop == inBuf + start || *stop != '\0') {
+                    bad++;
+                    fprintf(stderr, "[!] Line %llu: invalid number\n", lineNo);
+                } else if (errno == ERANGE) {
+                    bad++;
+                    fprintf(stderr, "[!] Line %llu: number does not fit in 64 bits (use --big)\n", lineNo);
+                } else {
+                    out = writeCsvLine(v, out);
+                    if (out - outBuf > BATCH_OUT_SZ - CSV_LINE_MAX) {
+                        fwrite(outBuf, 1, (size_t)(out - outBuf), stdout);
+                        out = outBuf;
+                    }
+                }
+            }
+            start = i + 1;
+        }
+        carry = start < len ? len - start : 0;
+        memmove(inBuf, inBuf + start, carry);
+        if (carry == BATCH_IN_SZ) {               // line longer than the buffer
+            fprintf(stderr, "[!] Line too long\n");
+            break;
+        }
+    }
+    fwrite(outBuf, 1, (size_t)(out - outBuf), stdout);
+    fflush(stdout);
+
+    if (in != stdin) fclose(in);
+    free(inBuf);
+    free(outBuf);
+    return bad ? 2 : 0;
+}
+
+// --- Benchmark ---
+// Times the original per-representation functions against convertAll() on
+// the same pseudo-random values and checks that both produce the same text.
+double nowSeconds() {
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+int runBench(long count) {
+    if (count <= 0) count = 1000000;
+    unsigned long long *values = malloc(sizeof(unsigned long long) * count);
+    if (!values) {
+        printf("[!] Out of memory\n");
+        return 1;
+    }
+    initTables();
+    unsigned long long x = 0x9E3779B97F4A7C15ULL;
+    for (long i = 0; i < count; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        values[i] = x >> (x & 63);              // spread over all bit lengths
+    }
+
+    char bin[65], octNum[65], hexNum[65], octBits[256], hexBits[256], decNum[32];
+    Conversions c;
+    volatile unsigned long long sink = 0;   // keeps the loops from being optimized away
+
+    double t0 = nowSeconds();
+    for (long i = 0; i < count; i++) {
+        decToBin(values[i], bin);
+        decToOct(values[i], octNum);
+        decToHex(values[i], hexNum);
+        decToOctBits(values[i], octBits);
+        decToHexBits(values[i], hexBits);
+        sprintf(decNum, "%llu", values[i]);
+        sink += (unsigned char)bin[0] + (unsigned char)hexBits[0];
+    }
+    double tOld = nowSeconds() - t0;
+
+    t0 = nowSeconds();
+    for (long i = 0; i < count; i++) {
+        convertAll(values[i], &c);
+        sink += (unsigned char)c.bin[0] + (unsigned char)c.hexBits[0];
+    }
+    double tNew = nowSeconds() - t0;
+
+    long mismatches = 0;
+    for (long i = 0; i < count && i < 100000; i++) {
+        decToBin(values[i], bin);
+        decToOct(values[i], octNum);
+        decToHex(values[i], hexNum);
+        decToOctBits(values[i], octBits);
+        decToHexBits(values[i], hexBits);
+        sprintf(decNum, "%llu", values[i]);
+        convertAll(values[i], &c);
+        if (strcmp(bin, c.bin) || strcmp(octNum, c.oct) || strcmp(hexNum, c.hex) ||
+            strcmp(octBits, c.octBits) || strcmp(hexBits, c.hexBits) || strcmp(decNum, c.dec)) {
+            mismatches++;
+        }
+    }
+
+    printf("\n------------------------------------\n");
+    printf("   Conversion Benchmark (%ld values)\n", count);
+    printf("------------------------------------\n");
+    printf(" Original functions : %8.1f ns/value\n", tOld * 1e9 / count);
+    printf(" Fused kernels      : %8.1f ns/value\n", tNew * 1e9 / count);
+    printf(" Speedup            : %8.1fx\n", tNew > 0 ? tOld / tNew : 0.0);
+    printf(" Mismatches         : %ld\n", mismatches);
+    printf("------------------------------------\n");
+    free(values);
+    return mismatches ? 1 : 0;
+}
+
 // Print results
-void printAll(long long dec) {
-    char bin[65], octNum[65], hexNum[65], octBits[256], hexBits[256];
-    decToBin(dec, bin);
-    decToOct(dec, octNum);
-    decToHex(dec, hexNum);
-    decToOctBits(dec, octBits);
-    decToHexBits(dec, hexBits);
+void printAll(unsigned long long dec) {
+    Conversions c;
+    initTables();
+    convertAll(dec, &c);
+    const char *bin = c.bin, *octNum = c.oct, *hexNum = c.hex;
+    const char *octBits = c.octBits, *hexBits = c.hexBits;
 
     printf("\n------------------------------------\n");
     printf("   Conversion Results\n");
     printf("------------------------------------\n");
     printf(" Binary      : %s\n", bin);
     printf(" Octal       : %s   (bits: %s)\n", octNum, octBits);
-    printf(" Decimal     : %lld\n", dec);
+    printf(" Decimal     : %s\n", c.dec);
     printf(" Hexadecimal : %s   (bits: %s)\n", hexNum, hexBits);
     printf("------------------------------------\n");
     printf("      © Tonie 2025\n");
     printf("------------------------------------\n");
 }
 
+// --- Big Integers ---
+// Values of any length are kept as little-endian arrays of 32-bit limbs.
+// Binary limbs use radix 2^32; decimal work uses radix 10^9 so each limb
+// holds 9 decimal digits. Bases 2, 8 and 16 convert in linear time by
+// regrouping bits. Decimal <-> binary uses divide and conquer:
+//     value(limbs) = value(high half) * R^k + value(low half)
+// with R^(2^j) precomputed by repeated squaring, and Karatsuba
+// multiplication in the target radix, so the whole conversion is
+// O(M(n) log n) instead of the O(n^2) of digit-at-a-time Horner.
+
+typedef struct {
+    uint32_t *d;     // limbs, least significant first
+    size_t n;        // limbs in use (no leading zero limbs)
+} BigNat;
+
+// Per-radix primitives; add/sub/mulSmall are instantiated for each radix so
+// the modulo/divide by the radix is a compile-time constant.
+typedef struct {
+    uint64_t radix;
+    uint32_t (*add)(uint32_t *r, size_t rn, const uint32_t *a, size_t an);  // r += a, returns carry
+    void (*sub)(uint32_t *r, size_t rn, const uint32_t *a, size_t an);      // r -= a, r >= a
+    void (*mulSchool)(const uint32_t *a, size_t an, const uint32_t *b, size_t bn, uint32_t *out);
+    uint64_t (*mulSmall)(uint32_t *r, size_t n, uint64_t m, uint64_t carry); // r = r*m + carry
+} LimbOps;
+
+#define DEFINE_LIMB_OPS(SUF, RADIX)                                               \
+static uint32_t limbAdd##SUF(uint32_t *r, size_t rn, const uint32_t *a, size_t an) { \
+    uint64_t c = 0;                                                               \
+    size_t i = 0;                                                                 \
+    for (; i < an; i++) {                                                         \
+        uint64_t s = (uint64_t)r[i] + a[i] + c;                                   \
+        c = s >= (RADIX);                                                         \
+        r[i] = (uint32_t)(c ? s - (RADIX) : s);                                   \
+    }                                                                             \
+    for (; c && i < rn; i++) {                                                    \
+        uint64_t s = (uint64_t)r[i] + 1;                                          \
+        c = s >= (RADIX);                                                         \
+        r[i] = (uint32_t)(c ? s - (RADIX) : s);                                   \
+    }                                                                             \
+    return (uint32_t)c;                                                           \
+}                                                                                 \
+static void limbSub##SUF(uint32_t *r, size_t rn, const uint32_t *a, size_t an) {  \
+    uint64_t borrow = 0;                                                          \
+    size_t i = 0;                                                                 \
+    for (; i < an; i++) {                                                         \
+        uint64_t sub = (uint64_t)a[i] + borrow;                                   \
+        borrow = r[i] < sub;                                                      \
+        r[i] = (uint32_t)(borrow ? r[i] + (RADIX) - sub : r[i] - sub);            \
+    }                                                                             \
+    for (; borrow && i < rn; i++) {                                               \
+        borrow = r[i] == 0;                                                       \
+        r[i] = (uint32_t)(borrow ? (RADIX) - 1 : r[i] - 1);                       \
+    }                                                                             \
+}                                                                                 \
+static uint64_t limbMulSmall##SUF(uint32_t *r, size_t n, uint64_t m, uint64_t carry) { \
+    for (size_t i = 0; i < n; i++) {                                              \
+        uint64_t t = r[i] * m + carry;                                            \
+        r[i] = (uint32_t)(t % (RADIX));                                           \
+        carry = t / (RADIX);                                                      \
+    }                                                                             \
+    return carry;                                                                 \
+}
+
+DEFINE_LIMB_OPS(Bin, 4294967296ULL)
+DEFINE_LIMB_OPS(Dec, 1000000000ULL)
+
+// Schoolbook for radix 2^32: out += a * b
+static void limbMulSchoolBin(const uint32_t *a, size_t an, const uint32_t *b,
+                             size_t bn, uint32_t *out) {
+    for (size_t i = 0; i < an; i++) {
+        uint64_t ai = a[i], carry = 0;
+        if (ai == 0) continue;
+        for (size_t j = 0; j < bn; j++) {
+            uint64_t t = ai * b[j] + out[i + j] + carry;
+            out[i + j] = (uint32_t)t;
+            carry = t >> 32;
+        }
+        for (size_t k = i + bn; carry; k++) {
+            uint64_t t = out[k] + carry;
+            out[k] = (uint32_t)t;
+            carry = t >> 32;
+        }
+    }
+}
+
+// Column-wise schoolbook for radix 10^9: products are below 10^18, so up to
+// 18 of them fit in a 64-bit sum before the column has to be normalized.
+// That replaces one divide per product with one per 16 products.
+static void limbMulColumnsDec(const uint32_t *a, size_t an, const uint32_t *b,
+                              size_t bn, uint32_t *out) {
+    const uint64_t R = 1000000000ULL;
+    uint64_t carry = 0;
+    for (size_t k = 0; k < an + bn - 1; k++) {
+        size_t lo = k >= bn ? k - bn + 1 : 0;
+        size_t hi = k < an ? k : an - 1;
+        uint64_t acc = out[k] + carry, high = 0;
+        int pending = 1;
+        for (size_t i = lo; i <= hi; i++) {
+            acc += (uint64_t)a[i] * b[k - i];
+            if (++pending == 16) {
+                high += acc / R;
+                acc %= R;
+                pending = 0;
+            }
+        }
+        high += acc / R;
+        out[k] = (uint32_t)(acc % R);
+        carry = high;
+    }
+    for (size_t k = an + bn - 1; carry; k++) {
+        uint64_t t = out[k] + carry;
+        out[k] = (uint32_t)(t % R);
+        carry = t / R;
+    }
+}
+
+static const LimbOps BIN_OPS = { 4294967296ULL, limbAddBin, limbSubBin, limbMulSchoolBin, limbMulSmallBin };
+static const LimbOps DEC_OPS = { 1000000000ULL, limbAddDec, limbSubDec, limbMulColumnsDec, limbMulSmallDec };
+
+#define KARATSUBA_CUTOFF 40
+#define HORNER_CUTOFF 64
+
+static size_t trimLimbs(const uint32_t *d, size_t n) {
+    while (n > 0 && d[n - 1] == 0) n--;
+    return n;
+}
+
+static void *xcalloc(size_t n, size_t size) {
+    void *p = calloc(n ? n : 1, size);
+    if (!p) {
+        fprintf(stderr, "[!] Out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+// out[0 .. an+bn) = a * b (out must be zeroed by the caller)
+static void limbMul(const LimbOps *o, const uint32_t *a, size_t an,
+                    const uint32_t *b, size_t bn, uint32_t *out) {
+    if (an < bn) {
+        const uint32_t *t = a; a = b; b = t;
+        size_t tn = an; an = bn; bn = tn;
+    }
+    if (bn == 0) return;
+    if (bn < KARATSUBA_CUTOFF) {
+        o->mulSchool(a, an, b, bn, out);
+        return;
+    }
+    if (an >= 2 * bn) {
+        // Unbalanced: multiply b by bn-sized slices of a and add them up
+        uint32_t *tmp = xcalloc(2 * bn, sizeof(uint32_t));
+        for (size_t i = 0; i < an; i += bn) {
+            size_t len = an - i < bn ? an - i : bn;
+            memset(tmp, 0, sizeof(uint32_t) * (len + bn));
+            limbMul(o, a + i, len, b, bn, tmp);
+            o->add(out + i, an + bn - i, tmp, len + bn);
+        }
+        free(tmp);
+        return;
+    }
+
+    // Karatsuba: a = a1*R^m + a0, b = b1*R^m + b0 (bn > m because an < 2*bn)
+    size_t m = an / 2;
+    size_t a1n = an - m, b1n = bn - m;
+    size_t sn = (a1n > m ? a1n : m) + 1, tn = (b1n > m ? b1n : m) + 1;
+    uint32_t *sa = xcalloc(sn, sizeof(uint32_t));
+    uint32_t *sb = xcalloc(tn, sizeof(uint32_t));
+    uint32_t *z1 = xcalloc(sn + tn, sizeof(uint32_t));
+
+    limbMul(o, a, m, b, m, out);                       // z0 -> out[0 .. 2m)
+    limbMul(o, a + m, a1n, b + m, b1n, out + 2 * m);   // z2 -> out[2m ..)
+
+    memcpy(sa, a + m, sizeof(uint32_t) * a1n);
+    o->add(sa, sn, a, m);
+    memcpy(sb, b + m, sizeof(uint32_t) * b1n);
+    o->add(sb, tn, b, m);
+    limbMul(o, sa, trimLimbs(sa, sn), sb, trimLimbs(sb, tn), z1);
+    o->sub(z1, sn + tn, out, 2 * m);
+    o->sub(z1, sn + tn, out + 2 * m, a1n + b1n);
+
+    size_t z1n = trimLimbs(z1, sn + tn);
+    o->add(out + m, an + bn - m, z1, z1n);
+    free(sa);
+    free(sb);
+    free(z1);
+}
+
+// Powers srcRadix^(2^j) in the target radix, built once per conversion
+typedef struct {
+    uint32_t *d[40];
+    size_t n[40];
+    int count;
+} PowerTable;
+
+static void powerTableBuild(PowerTable *t, const LimbOps *to, uint64_t srcRadix, size_t srcLimbs) {
+    t->count = 0;
+    uint32_t first[3];
+    size_t fn = 0;
+    for (uint64_t v = srcRadix; v; v /= to->radix) first[fn++] = (uint32_t)(v % to->radix);
+    t->d[0] = xcalloc(fn, sizeof(uint32_t));
+    memcpy(t->d[0], first, sizeof(uint32_t) * fn);
+    t->n[0] = fn;
+    t->count = 1;
+    while (((size_t)1 << t->count) < srcLimbs && t->count < 40) {
+        int j = t->count;
+        size_t pn = t->n[j - 1];
+        t->d[j] = xcalloc(2 * pn, sizeof(uint32_t));
+        limbMul(to, t->d[j - 1], pn, t->d[j - 1], pn, t->d[j]);
+        t->n[j] = trimLimbs(t->d[j], 2 * pn);
+        t->count++;
+    }
+}
+
+static void powerTableFree(PowerTable *t) {
+    for (int j = 0; j < t->count; j++) free(t->d[j]);
+}
+
+// Convert n source limbs to the target radix; returns limbs, count in *outN
+static uint32_t *convertLimbs(const LimbOps *to, uint64_t srcRadix, const PowerTable *pw,
+                              const uint32_t *src, size_t n, size_t *outN) {
+    if (n <= HORNER_CUTOFF) {
+        // Horner: res = res * srcRadix + digit, one limb at a time
+        uint32_t *res = xcalloc(2 * n + 2, sizeof(uint32_t));
+        size_t len = 0;
+        for (size_t i = n; i-- > 0;) {
+            uint64_t carry = to->mulSmall(res, len, srcRadix, src[i]);
+            while (carry) {
+                res[len++] = (uint32_t)(carry % to->radix);
+                carry /= to->radix;
+            }
+        }
+        *outN = trimLimbs(res, len);
+        return res;
+    }
+
+    int j = 0;
+    while (((size_t)2 << j) < n) j++;          // k = 2^j is the largest power of two < n
+    size_t k = (size_t)1 << j;
+    size_t loN, hiN;
+    uint32_t *lo = convertLimbs(to, srcRadix, pw, src, k, &loN);
+    uint32_t *hi = convertLimbs(to, srcRadix, pw, src + k, n - k, &hiN);
+
+    size_t resN = hiN + pw->n[j] + 1;
+    if (resN < loN + 1) resN = loN + 1;
+    uint32_t *res = xcalloc(resN, sizeof(uint32_t));
+    limbMul(to, hi, hiN, pw->d[j], pw->n[j], res);
+    to->add(res, resN, lo, loN);
+    free(lo);
+    free(hi);
+    *outN = trimLimbs(res, resN);
+    return res;
+}
+
+// --- Chunk Parsers ---
+// Each kernel validates 16 characters and packs them into bits in the same
+// pass. They return -1 when all 16 are valid, else the index of the first
+// bad one. With SSSE3 the digit values are combined with multiply-add
+// instructions (pairs, then quads of digits per lane); otherwise a scalar
+// loop packs them after the SIMD check.
+
+// Value of an already validated digit, without branches
+static int digitValue(char ch) {
+    return (ch & 0xF) + 9 * ((unsigned char)ch >> 6);
+}
+
+static int chunkCheck(const char *p, int base) {
+#ifdef __SSE2__
+    unsigned bad = invalidMask16(_mm_loadu_si128((const __m128i *)p), base);
+    return bad ? ctz32(bad) : -1;
+#else
+    for (int i = 0; i < 16; i++) {
+        if (!isDigitOf(p[i], base)) return i;
+    }
+    return -1;
+#endif
+}
+
+#ifdef __SSSE3__
+// ASCII digits/hex letters -> values 0..15 per byte
+static __m128i chunkValues(const char *p) {
+    __m128i c = _mm_loadu_si128((const __m128i *)p);
+    __m128i d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    __m128i isLetter = _mm_cmpgt_epi8(d, _mm_set1_epi8(9));
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a' - 10));
+    return _mm_or_si128(_mm_and_si128(isLetter, letter), _mm_andnot_si128(isLetter, d));
+}
+#endif
+
+// 16 hex digits -> 64 bits
+int chunkHex16(const char *p, uint64_t *out) {
+    int bad = chunkCheck(p, 16);
+    if (bad >= 0) return bad;
+#ifdef __SSSE3__
+    __m128i v = chunkValues(p);
+    __m128i pairs = _mm_maddubs_epi16(v, _mm_set1_epi16(0x0110));   // hi*16 + lo
+    __m128i bytes = _mm_packus_epi16(pairs, pairs);
+    *out = __builtin_bswap64((uint64_t)_mm_cvtsi128_si64(bytes));
+#else
+    uint64_t v = 0;
+    for (int i = 0; i < 16; i++) v = (v << 4) | (uint64_t)digitValue(p[i]);
+    *out = v;
+#endif
+    return -1;
+}
+
+// 16 octal digits -> 48 bits
+int chunkOct16(const char *p, uint64_t *out) {
+    int bad = chunkCheck(p, 8);
+    if (bad >= 0) return bad;
+#ifdef __SSSE3__
+    __m128i v = chunkValues(p);
+    __m128i pairs = _mm_maddubs_epi16(v, _mm_set1_epi16(0x0108));   // 6 bits per pair
+    __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00010040)); // 12 bits per quad
+    uint32_t q[4];
+    _mm_storeu_si128((__m128i *)q, quads);
+    *out = ((uint64_t)q[0] << 36) | ((uint64_t)q[1] << 24) | ((uint64_t)q[2] << 12) | q[3];
+#else
+    uint64_t v = 0;
+    for (int i = 0; i < 16; i++) v = (v << 3) | (uint64_t)(p[i] - '0');
+    *out = v;
+#endif
+    return -1;
+}
+
+// 16 binary digits -> 16 bits
+int chunkBin16(const char *p, uint64_t *out) {
+    int bad = chunkCheck(p, 2);
+    if (bad >= 0) return bad;
+#ifdef __SSE2__
+    // movemask puts character i in bit i; the number wants it in bit 15-i
+    unsigned m = (unsigned)_mm_movemask_epi8(_mm_slli_epi16(_mm_loadu_si128((const __m128i *)p), 7));
+    m = ((m & 0x5555) << 1) | ((m >> 1) & 0x5555);
+    m = ((m & 0x3333) << 2) | ((m >> 2) & 0x3333);
+    m = ((m & 0x0F0F) << 4) | ((m >> 4) & 0x0F0F);
+    m = ((m & 0x00FF) << 8) | ((m >> 8) & 0x00FF);
+    *out = m;
+#else
+    uint64_t v = 0;
+    for (int i = 0; i < 16; i++) v = (v << 1) | (uint64_t)(p[i] - '0');
+    *out = v;
+#endif
+    return -1;
+}
+
+// OR nbits of v into the limbs starting at bit position pos
+static void orBits(uint32_t *d, size_t pos, uint64_t v, int nbits) {
+    size_t limb = pos / 32;
+    int off = (int)(pos % 32);
+    d[limb] |= (uint32_t)(v << off);
+    if (off + nbits > 32) d[limb + 1] |= (uint32_t)(v >> (32 - off));
+    if (off + nbits > 64) d[limb + 2] |= (uint32_t)(v >> (64 - off));
+}
+
+// Validate and parse len digits of s in base 2, 8, 10 or 16 into x.
+// Returns the index of the first invalid character, or len on success
+// (x is only filled in on success).
+size_t bigParse(const char *s, size_t len, int base, BigNat *x) {
+    if (base == 10) {
+        size_t bad = findInvalidDigit(s, len, 10);
+        if (bad < len) return bad;
+        size_t skipped = 0;
+        while (len - skipped > 1 && s[skipped] == '0') skipped++;
+        const char *t = s + skipped;
+        size_t tl = len - skipped;
+        size_t dn = (tl + 8) / 9;
+        uint32_t *dec = xcalloc(dn, sizeof(uint32_t));
+        for (size_t i = 0; i < dn; i++) {           // 9-digit groups from the right
+            size_t end = tl - 9 * i;
+            size_t start = end >= 9 ? end - 9 : 0;
+            uint32_t v = 0;
+            for (size_t k = start; k < end; k++) v = v * 10 + (uint32_t)(t[k] - '0');
+            dec[i] = v;
+        }
+        PowerTable pw;
+        powerTableBuild(&pw, &BIN_OPS, DEC_OPS.radix, dn);
+        x->d = convertLimbs(&BIN_OPS, DEC_OPS.radix, &pw, dec, trimLimbs(dec, dn), &x->n);
+        powerTableFree(&pw);
+        free(dec);
+        return len;
+    }
+
+    int bits = base == 2 ? 1 : base == 8 ? 3 : 4;
+    int (*chunk)(const char *, uint64_t *) = base == 2 ? chunkBin16 : base == 8 ? chunkOct16 : chunkHex16;
+    uint32_t *d = xcalloc((len * bits + 31) / 32 + 3, sizeof(uint32_t));
+
+    // Leading partial chunk first, then full 16-digit chunks left to right
+    size_t head = len % 16;
+    uint64_t v = 0;
+    for (size_t i = 0; i < head; i++) {
+        if (!isDigitOf(s[i], base)) { free(d); return i; }
+        v = (v << bits) | (uint64_t)digitValue(s[i]);
+    }
+    if (head) orBits(d, (len - head) * bits, v, (int)head * bits);
+    for (size_t i = head; i < len; i += 16) {
+        int bad = chunk(s + i, &v);
+        if (bad >= 0) { free(d); return i + (size_t)bad; }
+        orBits(d, (len - i - 16) * bits, v, 16 * bits);
+    }
+    x->d = d;
+    x->n = trimLimbs(d, (len * bits + 31) / 32 + 3);
+    return len;
+}
+
+size_t bigBitLength(const BigNat *x) {
+    if (x->n == 0) return 0;
+    return (x->n - 1) * 32 + (size_t)bitLength(x->d[x->n - 1]);
+}
+
+// Format in base 2, 8, 10 or 16; returns a malloc'd string
+char *bigToString(const BigNat *x, int base) {
+    if (x->n == 0) {
+        char *z = xcalloc(2, 1);
+        z[0] = '0';
+        return z;
+    }
+
+    if (base == 10) {
+        PowerTable pw;
+        powerTableBuild(&pw, &DEC_OPS, BIN_OPS.radix, x->n);
+        size_t dn;
+        uint32_t *dec = convertLimbs(&DEC_OPS, BIN_OPS.radix, &pw, x->d, x->n, &dn);
+        powerTableFree(&pw);
+        char *out = xcalloc(dn * 9 + 1, 1);
+        char *p = out + sprintf(out, "%u", dec[dn - 1]);
+        for (size_t i = dn - 1; i-- > 0;) {
+            uint32_t v = dec[i];
+            for (int k = 8; k >= 0; k--) { p[k] = (char)('0' + v % 10); v /= 10; }
+            p += 9;
+        }
+        *p = '\0';
+        free(dec);
+        return out;
+    }
+
+    int bits = base == 2 ? 1 : base == 8 ? 3 : 4;
+    size_t total = bigBitLength(x);
+    size_t digits = (total + bits - 1) / bits;
+    char *out = xcalloc(digits + 1, 1);
+    for (size_t k = 0; k < digits; k++) {
+        size_t pos = (digits - 1 - k) * bits;
+        size_t limb = pos / 32, off = pos % 32;
+        uint64_t w = x->d[limb] >> off;
+        if (limb + 1 < x->n && off + bits > 32) w |= (uint64_t)x->d[limb + 1] << (32 - off);
+        out[k] = HEX_DIGITS[w & ((1u << bits) - 1)];
+    }
+    out[digits] = '\0';
+    return out;
+}
+
+// Parse input in base, then print through the 64-bit path when it fits
+void convertInput(const char *input, int base, const char *name) {
+    BigNat x;
+    size_t len = strlen(input);
+    size_t bad = bigParse(input, len, base, &x);
+    if (bad < len) {
+        printf("\n[!] Invalid %s number: '%c' at position %zu.\n", name, input[bad], bad + 1);
+        return;
+    }
+    if (x.n <= 2) {
+        unsigned long long v = x.n == 0 ? 0 : x.d[0];
+        if (x.n == 2) v |= (unsigned long long)x.d[1] << 32;
+        free(x.d);
+        printAll(v);
+        return;
+    }
+    char *bin = bigToString(&x, 2), *oct = bigToString(&x, 8);
+    char *dec = bigToString(&x, 10), *hex = bigToString(&x, 16);
+    printf("\n------------------------------------\n");
+    printf("   Conversion Results (%zu bits)\n", bigBitLength(&x));
+    printf("------------------------------------\n");
+    printf(" Binary      : %s\n", bin);
+    printf(" Octal       : %s\n", oct);
+    printf(" Decimal     : %s\n", dec);
+    printf(" Hexadecimal : %s\n", hex);
+    printf("------------------------------------\n");
+    printf("      © Tonie 2025\n");
+    printf("------------------------------------\n");
+    free(bin); free(oct); free(dec); free(hex); free(x.d);
+}
+
+// Read a whole stream into memory (digits only, whitespace dropped)
+static char *readDigits(FILE *in, size_t *len) {
+    size_t cap = 1 << 16, n = 0;
+    char *buf = xcalloc(cap, 1);
+    int ch;
+    while ((ch = fgetc(in)) != EOF) {
+        if (isspace(ch)) continue;
+        if (n + 1 >= cap) {
+            cap *= 2;
+            buf = realloc(buf, cap);
+            if (!buf) { fprintf(stderr, "[!] Out of memory\n"); exit(1); }
+        }
+        buf[n++] = (char)ch;
+    }
+    buf[n] = '\0';
+    *len = n;
+    return buf;
+}
+
+// --big <from> <to> [file]: convert a number of any length
+int runBig(int from, int to, const char *path) {
+    if ((from != 2 && from != 8 && from != 10 && from != 16) ||
+        (to != 2 && to != 8 && to != 10 && to != 16)) {
+        fprintf(stderr, "[!] Bases must be 2, 8, 10 or 16\n");
+        return 1;
+    }
+    FILE *in = path ? fopen(path, "rb") : stdin;
+    if (!in) {
+        fprintf(stderr, "[!] Cannot open %s\n", path);
+        return 1;
+    }
+    size_t len;
+    char *digits = readDigits(in, &len);
+    if (in != stdin) fclose(in);
+    double t0 = nowSeconds();
+    BigNat x;
+    size_t bad = bigParse(digits, len, from, &x);
+    double t1 = nowSeconds();
+    if (len == 0 || bad < len) {
+        if (len == 0) fprintf(stderr, "[!] No digits.\n");
+        else fprintf(stderr, "[!] Invalid base-%d number: '%c' at digit %zu.\n", from, digits[bad], bad + 1);
+        free(digits);
+        return 1;
+    }
+    char *out = bigToString(&x, to);
+    double t2 = nowSeconds();
+    puts(out);
+    fprintf(stderr, "[i] %zu bits, parse %.3f s, format %.3f s\n", bigBitLength(&x), t1 - t0, t2 - t1);
+    free(out);
+    free(x.d);
+    free(digits);
+    return 0;
+}
+
+// --bench-big [digits]: random decimal -> binary -> decimal round trip
+int runBigBench(long digits) {
+    if (digits <= 0) digits = 1000000;
+    char *s = xcalloc((size_t)digits + 1, 1);
+    unsigned long long r = 0x2545F4914F6CDD1DULL;
+    for (long i = 0; i < digits; i++) {
+        r ^= r << 13; r ^= r >> 7; r ^= r << 17;
+        s[i] = (char)('0' + r % 10);
+    }
+    s[0] = '7';
+
+    double t0 = nowSeconds();
+    BigNat x, y;
+    bigParse(s, (size_t)digits, 10, &x);
+    double t1 = nowSeconds();
+    char *hex = bigToString(&x, 16);
+    double t2 = nowSeconds();
+    bigParse(hex, strlen(hex), 16, &y);
+    double t3 = nowSeconds();
+    char *back = bigToString(&y, 10);
+    double t4 = nowSeconds();
+
+    printf("\n------------------------------------\n");
+    printf("   Big Integer Benchmark (%ld digits)\n", digits);
+    printf("------------------------------------\n");
+    printf(" Decimal -> binary : %8.3f s\n", t1 - t0);
+    printf(" Binary  -> hex    : %8.3f s\n", t2 - t1);
+    printf(" Hex     -> binary : %8.3f s\n", t3 - t2);
+    printf(" Binary  -> decimal: %8.3f s\n", t4 - t3);
+    printf(" Round trip        : %s\n", strcmp(s, back) == 0 ? "OK" : "MISMATCH");
+    printf("------------------------------------\n");
+    int bad = strcmp(s, back) != 0;
+    free(s); free(hex); free(back); free(x.d); free(y.d);
+    return bad;
+}
+
+// --bench-parse [MB]: validate + parse long hex and binary strings with the
+// byte-at-a-time loops the converter used before and with bigParse()
+int runParseBench(long megabytes) {
+    if (megabytes <= 0) megabytes = 64;
+    size_t len = (size_t)megabytes << 20;
+    char *s = xcalloc(len + 1, 1);
+    static const int bases[] = { 16, 2 };
+    unsigned long long r = 0x9E3779B97F4A7C15ULL;
+
+    printf("\n------------------------------------\n");
+    printf("   Parse Benchmark (%ld MB per base)\n", megabytes);
+    printf("------------------------------------\n");
+    for (int b = 0; b < 2; b++) {
+        int base = bases[b];
+        for (size_t i = 0; i < len; i++) {
+            r ^= r << 13; r ^= r >> 7; r ^= r << 17;
+            s[i] = HEX_DIGITS[r % base];
+        }
+
+        // Old approach: isxdigit/range check per byte, then a second pass
+        // shifting each digit into the limbs
+        double t0 = nowSeconds();
+        int valid = 1;
+        for (size_t i = 0; i < len; i++) {
+            if (base == 16 ? !isxdigit((unsigned char)s[i]) : (s[i] != '0' && s[i] != '1')) { valid = 0; break; }
+        }
+        int bits = base == 16 ? 4 : 1;
+        uint32_t *d = xcalloc(len * bits / 32 + 2, sizeof(uint32_t));
+        for (size_t i = 0; i < len && valid; i++) {
+            size_t pos = (len - 1 - i) * bits;
+            d[pos / 32] |= (uint32_t)digitValue(s[i]) << (pos % 32);
+        }
+        double tOld = nowSeconds() - t0;
+
+        t0 = nowSeconds();
+        BigNat x;
+        size_t bad = bigParse(s, len, base, &x);
+        double tNew = nowSeconds() - t0;
+
+        int same = bad == len && memcmp(d, x.d, sizeof(uint32_t) * x.n) == 0;
+        printf(" Base %-2d scalar : %7.2f GB/s\n", base, tOld > 0 ? len / tOld / 1e9 : 0.0);
+        printf(" Base %-2d SIMD   : %7.2f GB/s   (%s)\n", base, tNew > 0 ? len / tNew / 1e9 : 0.0,
+               same ? "same result" : "MISMATCH");
+        free(d);
+        if (bad == len) free(x.d);
+    }
+    printf("------------------------------------\n");
+    free(s);
+    return 0;
+}
+
+// --- Dump / Undump ---
+// --dump writes any file as text: hex digits (same as xxd -p -u), or each
+// byte in the bit-group layout of decToHexBits()/decToOctBits(), or as 8
+// binary digits. Every byte becomes a fixed-width glyph, so the output
+// offset of each input line is known in advance: the file is mmap'd, cut
+// into blocks of whole lines, and each block is encoded by several threads
+// straight into one output buffer that goes out in a single write.
+// --undump reverses any of the formats; spaces and line breaks are ignored.
+#define DUMP_BLOCK_LINES 131072
+#define DUMP_MAX_THREADS 64
+#define UNDUMP_BLOCK     (1 << 22)
+
+typedef struct {
+    const char *name;
+    int width;          // characters per byte, without the separator
+    int sep;            // 1 when bytes are separated by spaces
+    int perLine;        // bytes per output line
+    int digitBase;      // digits the text is made of (16 or 2)
+    int digitsPerByte;  // digits per byte once whitespace is dropped
+} DumpFormat;
+
+enum { DUMP_HEX, DUMP_HEXBITS, DUMP_OCTBITS, DUMP_BIN, DUMP_FORMATS };
+
+static const DumpFormat DUMP_FORMAT[DUMP_FORMATS] = {
+    { "hex",      2, 0, 30, 16, 2 },   // "48"
+    { "hexbits",  9, 1,  6,  2, 8 },   // "0100 1000"
+    { "octbits", 11, 1,  6,  2, 9 },   // "001 001 000"
+    { "bin",      8, 1,  8,  2, 8 },   // "01001000"
+};
+
+static char GLYPH[DUMP_FORMATS][256][16];   // byte -> text plus separator
+#ifdef __SSSE3__
+static unsigned char PACK8[256][8];         // left-pack shuffle for an 8-bit mask
+static unsigned char PACK8N[256];           // bytes kept by that mask
+#endif
+
+int dumpFormatFind(const char *name) {
+    for (int f = 0; f < DUMP_FORMATS; f++) {
+        if (strcmp(DUMP_FORMAT[f].name, name) == 0) return f;
+    }
+    return -1;
+}
+
+// Fill the glyph tables from the fixed-width writers above, and the
+// left-pack shuffles used by squeezeSpace()
+void initGlyphs() {
+    static int ready = 0;
+    if (ready) return;
+    initTables();
+    for (int b = 0; b < 256; b++) {
+        char *p;
+        p = writeHex(b, 8, GLYPH[DUMP_HEX][b]);
+        p = writeHexBits(b, 8, GLYPH[DUMP_HEXBITS][b]);
+        *p = ' ';
+        p = writeOctBits(b, 9, GLYPH[DUMP_OCTBITS][b]);
+        *p = ' ';
+        p = writeBin(b, 8, GLYPH[DUMP_BIN][b]);
+        *p = ' ';
+#ifdef __SSSE3__
+        int n = 0;
+        for (int k = 0; k < 8; k++) {
+            if (b >> k & 1) PACK8[b][n++] = (unsigned char)k;
+        }
+        PACK8N[b] = (unsigned char)n;
+#endif
+    }
+    ready = 1;
+}
+
+static size_t dumpLineLen(const DumpFormat *f) {
+    return (size_t)f->perLine * (f->width + f->sep) + !f->sep;
+}
+
+// Text size for n input bytes
+size_t dumpSize(int fmt, size_t n) {
+    const DumpFormat *f = &DUMP_FORMAT[fmt];
+    size_t tail = n % f->perLine;
+    return n / f->perLine * dumpLineLen(f) + (tail ? tail * (f->width + f->sep) + !f->sep : 0);
+}
+
+// n bytes as hex digits, 16 bytes per shuffle where SSSE3 is available
+static char *hexRun(const unsigned char *in, size_t n, char *p) {
+    size_t i = 0;
+#ifdef __SSSE3__
+    const __m128i digits = _mm_loadu_si128((const __m128i *)HEX_DIGITS);
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    for (; i + 16 <= n; i += 16) {
+        __m128i b = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(b, 4), mask);
+        __m128i lo = _mm_and_si128(b, mask);
+        _mm_storeu_si128((__m128i *)p, _mm_shuffle_epi8(digits, _mm_unpacklo_epi8(hi, lo)));
+        _mm_storeu_si128((__m128i *)(p + 16), _mm_shuffle_epi8(digits, _mm_unpackhi_epi8(hi, lo)));
+        p += 32;
+    }
+#endif
+    for (; i < n; i++) {
+        memcpy(p, GLYPH[DUMP_HEX][in[i]], 2);
+        p += 2;
+    }
+    return p;
+}
+
+// Encode n bytes that start on a line boundary; returns the end of the text.
+// Glyphs are copied 16 bytes at a time, except the last one of each line so
+// that nothing is written past the end of the range.
+char *dumpLines(int fmt, const unsigned char *in, size_t n, char *p) {
+    const DumpFormat *f = &DUMP_FORMAT[fmt];
+    int stride = f->width + f->sep;
+    for (size_t i = 0; i < n; i += f->perLine) {
+        size_t k = n - i < (size_t)f->perLine ? n - i : (size_t)f->perLine;
+        if (fmt == DUMP_HEX) {
+            p = hexRun(in + i, k, p);
+            *p++ = '\n';
+            continue;
+        }
+        for (size_t j = 0; j + 1 < k; j++) {
+            memcpy(p, GLYPH[fmt][in[i + j]], 16);
+            p += stride;
+        }
+        memcpy(p, GLYPH[fmt][in[i + k - 1]], f->width);
+        p += f->width;
+        *p++ = '\n';
+    }
+    return p;
+}
+
+typedef struct {
+    int fmt;
+    const unsigned char *in;
+    size_t n;
+    char *out;
+} DumpJob;
+
+static void *dumpWorker(void *arg) {
+    DumpJob *job = arg;
+    dumpLines(job->fmt, job->in, job->n, job->out);
+    return NULL;
+}
+
+// Encode n bytes into out (dumpSize(fmt, n) bytes), split by whole lines
+// over up to threads workers
+void dumpParallel(int fmt, const unsigned char *in, size_t n, char *out, int threads) {
+    const DumpFormat *f = &DUMP_FORMAT[fmt];
+    size_t lines = (n + f->perLine - 1) / f->perLine;
+    if (threads > DUMP_MAX_THREADS) threads = DUMP_MAX_THREADS;
+    if (threads < 1 || lines < 1024) threads = 1;
+    DumpJob jobs[DUMP_MAX_THREADS];
+    size_t first = 0;
+    for (int t = 0; t < threads; t++) {
+        size_t last = lines * (t + 1) / threads;
+        size_t begin = first * f->perLine;
+        size_t end = last * f->perLine < n ? last * f->perLine : n;
+        jobs[t].fmt = fmt;
+        jobs[t].in = in + begin;
+        jobs[t].n = end - begin;
+        jobs[t].out = out + first * dumpLineLen(f);
+        first = last;
+    }
+#ifndef _WIN32
+    pthread_t tid[DUMP_MAX_THREADS];
+    int started = 0;
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&tid[t], NULL, dumpWorker, &jobs[t]) != 0) break;
+        started = t;
+    }
+    dumpWorker(&jobs[0]);
+    for (int t = started + 1; t < threads; t++) dumpWorker(&jobs[t]);
+    for (int t = 1; t <= started; t++) pthread_join(tid[t], NULL);
+#else
+    for (int t = 0; t < threads; t++) dumpWorker(&jobs[t]);
+#endif
+}
+
+int defaultThreads() {
+#ifdef _SC_NPROCESSORS_ONLN
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n > 0) return (int)n;
+#endif
+    return 1;
+}
+
+// Wall-clock seconds (nowSeconds() counts CPU time of all threads)
+double wallSeconds() {
+#ifndef _WIN32
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+    return nowSeconds();
+#endif
+}
+
+// --dump <format> <file|-> [threads]: write the file to out as text
+int runDump(int fmt, const char *path, int threads, FILE *out) {
+    const DumpFormat *f = &DUMP_FORMAT[fmt];
+    size_t block = (size_t)f->perLine * DUMP_BLOCK_LINES;
+    char *text = malloc(dumpSize(fmt, block) + 16);
+    if (!text) {
+        fprintf(stderr, "[!] Out of memory\n");
+        return 1;
+    }
+    initGlyphs();
+
+#ifndef _WIN32
+    if (strcmp(path, "-") != 0) {
+        int fd = open(path, O_RDONLY);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            fprintf(stderr, "[!] Cannot open %s\n", path);
+            if (fd >= 0) close(fd);
+            free(text);
+            return 1;
+        }
+        size_t size = (size_t)st.st_size;
+        const unsigned char *data = size ? mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0) : NULL;
+        close(fd);
+        if (data == MAP_FAILED) {
+            fprintf(stderr, "[!] Cannot map %s\n", path);
+            free(text);
+            return 1;
+        }
+        if (size) madvise((void *)data, size, MADV_SEQUENTIAL);
+        for (size_t off = 0; off < size; off += block) {
+            size_t n = size - off < block ? size - off : block;
+            dumpParallel(fmt, data + off, n, text, threads);
+            fwrite(text, 1, dumpSize(fmt, n), out);
+        }
+        if (size) munmap((void *)data, size);
+        free(text);
+        fflush(out);
+        return ferror(out) ? 1 : 0;
+    }
+#endif
+
+    // stdin, or files on platforms without mmap: read whole blocks
+    FILE *in = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    unsigned char *buf = malloc(block);
+    if (!in || !buf) {
+        fprintf(stderr, in ? "[!] Out of memory\n" : "[!] Cannot open %s\n", path);
+        free(text);
+        free(buf);
+        return 1;
+    }
+    size_t n;
+    while ((n = fread(buf, 1, block, in)) > 0) {
+        dumpParallel(fmt, buf, n, text, threads);
+        fwrite(text, 1, dumpSize(fmt, n), out);
+    }
+    if (in != stdin) fclose(in);
+    free(buf);
+    free(text);
+    fflush(out);
+    return ferror(out) ? 1 : 0;
+}
+
+// Streaming decoder state: spaces are squeezed out of each block and the
+// digits are decoded 16 (hex, bits) or 72 (octbits) at a time; an
+// incomplete group is kept for the next block.
+typedef struct {
+    int fmt;
+    char *digits;                 // digits not decoded yet
+    size_t nDigits;
+    unsigned long long consumed;  // digits decoded before digits[0]
+    unsigned char *bytes;         // decoded output of the current block
+    FILE *sink;                   // where bytes go, or...
+    unsigned char *mem;           // ...appended here when sink is NULL
+    size_t memLen, memCap;
+} Undumper;
+
+static int undumpInit(Undumper *u, int fmt, FILE *sink) {
+    initGlyphs();
+    memset(u, 0, sizeof(*u));
+    u->fmt = fmt;
+    u->sink = sink;
+    u->digits = malloc(UNDUMP_BLOCK + 128);
+    u->bytes = malloc(UNDUMP_BLOCK / 2 + 64);
+    return u->digits && u->bytes;
+}
+
+static void undumpFree(Undumper *u) {
+    free(u->digits);
+    free(u->bytes);
+}
+
+static void undumpError(const Undumper *u, size_t at, const char *what) {
+    fprintf(stderr, "[!] %s '%c' at digit %llu.\n", what, u->digits[at], u->consumed + at + 1);
+}
+
+// One byte from digitsPerByte validated digits
+static int undumpByte(int fmt, const char *p) {
+    if (fmt == DUMP_HEX) return digitValue(p[0]) << 4 | digitValue(p[1]);
+    // Eight '0'/'1' characters -> one byte: the multiply gathers the low
+    // bit of each character into the top byte (little-endian load)
+    uint64_t x;
+    memcpy(&x, p + (fmt == DUMP_OCTBITS), 8);
+    return (int)(((x & 0x0101010101010101ULL) * 0x8040201008040201ULL) >> 56);
+}
+
+// Decode as many whole groups as possible; final also decodes the last
+// bytes and rejects leftover digits. Returns 0, or 1 on bad input.
+static int undumpDecode(Undumper *u, int final) {
+    const DumpFormat *f = &DUMP_FORMAT[u->fmt];
+    const char *d = u->digits;
+    size_t n = u->nDigits, i = 0;
+    unsigned char *b = u->bytes;
+    uint64_t v;
+    int bad;
+
+    if (u->fmt == DUMP_HEX) {
+        for (; i + 16 <= n; i += 16, b += 8) {
+            if ((bad = chunkHex16(d + i, &v)) >= 0) { undumpError(u, i + bad, "Invalid hex digit"); return 1; }
+            for (int k = 0; k < 8; k++) b[k] = (unsigned char)(v >> (56 - 8 * k));
+        }
+    } else if (f->digitsPerByte == 8) {
+        for (; i + 16 <= n; i += 16, b += 2) {
+            if ((bad = chunkBin16(d + i, &v)) >= 0) { undumpError(u, i + bad, "Invalid binary digit"); return 1; }
+            b[0] = (unsigned char)(v >> 8);
+            b[1] = (unsigned char)v;
+        }
+    } else {
+        for (; i + 72 <= n; i += 72) {
+            size_t at = findInvalidDigit(d + i, 72, 2);
+            if (at < 72) { undumpError(u, i + at, "Invalid binary digit"); return 1; }
+            for (int k = 0; k < 72; k += 9) {
+                if (d[i + k] != '0') { undumpError(u, i + k, "Byte above 255, leading bit"); return 1; }
+                *b++ = (unsigned char)undumpByte(DUMP_OCTBITS, d + i + k);
+            }
+        }
+    }
+    // The last few bytes, one at a time
+    size_t per = (size_t)f->digitsPerByte;
+    if (final) {
+        for (; i + per <= n; i += per) {
+            size_t at = findInvalidDigit(d + i, per, f->digitBase);
+            if (at < per) { undumpError(u, i + at, "Invalid digit"); return 1; }
+            if (u->fmt == DUMP_OCTBITS && d[i] != '0') { undumpError(u, i, "Byte above 255, leading bit"); return 1; }
+            *b++ = (unsigned char)undumpByte(u->fmt, d + i);
+        }
+    }
+    if (final && i < n) {
+        fprintf(stderr, "[!] Input ends inside a byte (%zu digit%s left over).\n", n - i, n - i == 1 ? "" : "s");
+        return 1;
+    }
+
+    size_t got = (size_t)(b - u->bytes);
+    if (u->sink) {
+        fwrite(u->bytes, 1, got, u->sink);
+    } else {
+        if (u->memLen + got > u->memCap) {
+            size_t cap = u->memCap ? u->memCap : 1 << 20;
+            while (cap < u->memLen + got) cap *= 2;
+            unsigned char *mem = realloc(u->mem, cap);
+            if (!mem) { fprintf(stderr, "[!] Out of memory\n"); return 1; }
+            u->mem = mem;
+            u->memCap = cap;
+        }
+        memcpy(u->mem + u->memLen, u->bytes, got);
+        u->memLen += got;
+    }
+    memmove(u->digits, d + i, n - i);
+    u->nDigits = n - i;
+    u->consumed += i;
+    return 0;
+}
+
+// Copy text to out without spaces, tabs and line breaks (any byte <= ' ');
+// returns the end of out. With SSSE3, 16 bytes at a time: a whole chunk
+// when it has no spaces, otherwise two table-driven 8-byte left-packs.
+// out needs 16 bytes of slack.
+static char *squeezeSpace(const char *text, size_t len, char *out) {
+    size_t i = 0;
+#ifdef __SSSE3__
+    const __m128i space = _mm_set1_epi8(' ');
+    for (; i + 16 <= len; i += 16) {
+        __m128i c = _mm_loadu_si128((const __m128i *)(text + i));
+        unsigned keep = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(c, space), c)) ^ 0xFFFFu;
+        if (keep == 0xFFFF) {
+            _mm_storeu_si128((__m128i *)out, c);
+            out += 16;
+            continue;
+        }
+        unsigned lo = keep & 0xFF, hi = keep >> 8;
+        __m128i shufLo = _mm_loadl_epi64((const __m128i *)PACK8[lo]);
+        __m128i shufHi = _mm_add_epi8(_mm_loadl_epi64((const __m128i *)PACK8[hi]), _mm_set1_epi8(8));
+        _mm_storel_epi64((__m128i *)out, _mm_shuffle_epi8(c, shufLo));
+        out += PACK8N[lo];
+        _mm_storel_epi64((__m128i *)out, _mm_shuffle_epi8(c, shufHi));
+        out += PACK8N[hi];
+    }
+#endif
+    for (; i < len; i++) {
+        *out = text[i];
+        out += (unsigned char)text[i] > ' ';
+    }
+    return out;
+}
+
+// Feed len characters of text (any amount); returns 0, or 1 on bad input
+int undumpFeed(Undumper *u, const char *text, size_t len) {
+    while (len > 0) {
+        size_t take = len < UNDUMP_BLOCK ? len : UNDUMP_BLOCK;
+        u->nDigits = squeezeSpace(text, take, u->digits + u->nDigits) - u->digits;
+        if (undumpDecode(u, 0)) return 1;
+        text += take;
+        len -= take;
+    }
+    return 0;
+}
+
+int undumpFinish(Undumper *u) {
+    return undumpDecode(u, 1);
+}
+
+// --undump <format> [file|-]: text back to bytes on out
+int runUndump(int fmt, const char *path, FILE *out) {
+    FILE *in = !path || strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    char *buf = malloc(UNDUMP_BLOCK);
+    Undumper u;
+    if (!in || !buf || !undumpInit(&u, fmt, out)) {
+        fprintf(stderr, in ? "[!] Out of memory\n" : "[!] Cannot open %s\n", path);
+        return 1;
+    }
+    size_t n;
+    int bad = 0;
+    while (!bad && (n = fread(buf, 1, UNDUMP_BLOCK, in)) > 0) bad = undumpFeed(&u, buf, n);
+    if (!bad) bad = undumpFinish(&u);
+    if (in != stdin) fclose(in);
+    free(buf);
+    undumpFree(&u);
+    fflush(out);
+    return bad ? 2 : 0;
+}
+
+#ifndef _WIN32
+// Run xxd <args...> <path> with stdout on fd, without going through a shell
+// (the path may contain quotes); returns its exit status, 127 if not found
+static int runXxd(char *const args[], const char *path, int fd) {
+    char *argv[8];
+    int n = 0;
+    argv[n++] = "xxd";
+    for (int i = 0; args[i] && n < 6; i++) argv[n++] = args[i];
+    argv[n++] = (char *)path;
+    argv[n] = NULL;
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) return -1;
+    if (pid == 0) {
+        int devNull = open("/dev/null", O_WRONLY);
+        dup2(fd, STDOUT_FILENO);
+        if (devNull >= 0) dup2(devNull, STDERR_FILENO);
+        execvp("xxd", argv);
+        _exit(127);
+    }
+    int status;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) return -1;
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+#endif
+
+// --bench-dump <file> [threads]: every format in memory (encode, decode and
+// compare), then the hex and bin dumps of the file to /dev/null next to
+// xxd -p -u and xxd -b when xxd is installed
+int runDumpBench(const char *path, int threads) {
+    FILE *in = fopen(path, "rb");
+    if (!in) {
+        fprintf(stderr, "[!] Cannot open %s\n", path);
+        return 1;
+    }
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    rewind(in);
+    unsigned char *data = malloc(size > 0 ? (size_t)size : 1);
+    if (!data || fread(data, 1, (size_t)size, in) != (size_t)size) {
+        fprintf(stderr, "[!] Cannot read %s\n", path);
+        fclose(in);
+        free(data);
+        return 1;
+    }
+    fclose(in);
+    initGlyphs();
+
+    double mb = size / 1e6;
+    int failed = 0;
+    printf("\n------------------------------------\n");
+    printf("   Dump Benchmark (%.1f MB, %d thread%s)\n", mb, threads, threads == 1 ? "" : "s");
+    printf("------------------------------------\n");
+    for (int fmt = 0; fmt < DUMP_FORMATS; fmt++) {
+        // Same block size as --dump, so text stays in cache between the
+        // two directions; each block is checked against the input
+        size_t block = (size_t)DUMP_FORMAT[fmt].perLine * DUMP_BLOCK_LINES;
+        char *text = malloc(dumpSize(fmt, block) + 16);
+        Undumper u;
+        if (!text || !undumpInit(&u, fmt, NULL)) {
+            fprintf(stderr, "[!] Out of memory\n");
+            free(text);
+            free(data);
+            return 1;
+        }
+        double tDump = 0, tUndump = 0;
+        int same = 1;
+        for (size_t off = 0; off < (size_t)size && same; off += block) {
+            size_t n = (size_t)size - off < block ? (size_t)size - off : block;
+            size_t len = dumpSize(fmt, n);
+            double t0 = wallSeconds();
+            dumpParallel(fmt, data + off, n, text, threads);
+            double t1 = wallSeconds();
+            u.memLen = 0;
+            int bad = undumpFeed(&u, text, len) || undumpFinish(&u);
+            double t2 = wallSeconds();
+            same = !bad && u.memLen == n && memcmp(u.mem, data + off, n) == 0;
+            tDump += t1 - t0;
+            tUndump += t2 - t1;
+        }
+        failed |= !same;
+        printf(" %-8s dump %7.0f MB/s  undump %7.0f MB/s  (%s)\n", DUMP_FORMAT[fmt].name,
+               tDump > 0 ? mb / tDump : 0.0, tUndump > 0 ? mb / tUndump : 0.0,
+               same ? "round trip OK" : "MISMATCH");
+        free(u.mem);
+        undumpFree(&u);
+        free(text);
+    }
+    free(data);
+
+#ifndef _WIN32
+    FILE *null = fopen("/dev/null", "wb");
+    if (null) {
+        static const struct { int fmt; const char *label; char *const args[4]; } runs[] = {
+            { DUMP_HEX, "-p -u", { "-p", "-u", NULL } }, { DUMP_BIN, "-b", { "-b", NULL } },
+        };
+        int haveXxd = 1;
+        printf("------------------------------------\n");
+        for (int r = 0; r < 2; r++) {
+            double t0 = wallSeconds();
+            runDump(runs[r].fmt, path, threads, null);
+            double t1 = wallSeconds();
+            printf(" --dump %-4s %7.0f MB/s\n", DUMP_FORMAT[runs[r].fmt].name, t1 > t0 ? mb / (t1 - t0) : 0.0);
+            if (!haveXxd) continue;
+            t0 = wallSeconds();
+            int rc = runXxd(runs[r].args, path, fileno(null));
+            t1 = wallSeconds();
+            if (rc == 127) haveXxd = 0;
+            else if (rc == 0) printf(" xxd %-7s %7.0f MB/s\n", runs[r].label, t1 > t0 ? mb / (t1 - t0) : 0.0);
+        }
+        if (!haveXxd) printf(" (xxd not found, skipped)\n");
+        fclose(null);
+    }
+#endif
+    printf("------------------------------------\n");
+    return failed;
+}
+
+// --- Field Breakdown ---
+// Reads a bit pattern as a fixed-width two's-complement or unsigned integer
+// or as an IEEE-754 half/float/double split into sign, exponent and
+// mantissa. --fields runs the same decoding over a whole binary file a block
+// of words at a time: each step (load, sign-extend, field split, classify,
+// widen to double, reduce) is a separate loop over plain arrays that the
+// compiler vectorizes at -O3; only the CSV text is written word by word.
+#define WORD_BLOCK 65536
+
+typedef struct {
+    const char *name;
+    int bytes;
+    int isFloat;
+    int isSigned;
+    int expBits;        // IEEE-754 only
+    int manBits;
+    int digits;         // significant digits to print a value without loss
+} WordFormat;
+
+static const WordFormat WORD_FORMATS[] = {
+    { "i8",  1, 0, 1,  0,  0,  0 }, { "u8",  1, 0, 0,  0,  0,  0 },
+    { "i16", 2, 0, 1,  0,  0,  0 }, { "u16", 2, 0, 0,  0,  0,  0 },
+    { "i32", 4, 0, 1,  0,  0,  0 }, { "u32", 4, 0, 0,  0,  0,  0 },
+    { "i64", 8, 0, 1,  0,  0,  0 }, { "u64", 8, 0, 0,  0,  0,  0 },
+    { "f16", 2, 1, 1,  5, 10,  5 },
+    { "f32", 4, 1, 1,  8, 23,  9 },
+    { "f64", 8, 1, 1, 11, 52, 17 },
+};
+#define WORD_FORMAT_COUNT (int)(sizeof(WORD_FORMATS) / sizeof(WORD_FORMATS[0]))
+
+enum { FP_CLASS_ZERO, FP_CLASS_SUBNORMAL, FP_CLASS_NORMAL, FP_CLASS_INF, FP_CLASS_NAN, FP_CLASSES };
+static const char *FP_CLASS_NAMES[FP_CLASSES] = { "zero", "subnormal", "normal", "inf", "nan" };
+
+const WordFormat *wordFormatFind(const char *name) {
+    for (int i = 0; i < WORD_FORMAT_COUNT; i++) {
+        if (strcmp(WORD_FORMATS[i].name, name) == 0) return &WORD_FORMATS[i];
+    }
+    return NULL;
+}
+
+int64_t signExtend(uint64_t v, int bits) {
+    return (int64_t)(v << (64 - bits)) >> (64 - bits);
+}
+
+// Fields of one IEEE-754 pattern
+typedef struct {
+    unsigned sign;
+    unsigned exponent;      // biased, as stored
+    int unbiased;           // exponent minus bias (1 - bias for subnormals)
+    uint64_t mantissa;      // stored fraction bits
+    int cls;
+    double value;
+} FloatFields;
+
+// Any IEEE-754 binary format with an exponent of at most 11 bits, widened
+// to double by rebuilding the bit pattern (subnormals by scaling the
+// mantissa, since they may be normal numbers as doubles)
+double widenToDouble(uint64_t v, int expBits, int manBits) {
+    uint64_t sign = v >> (expBits + manBits) & 1;
+    uint64_t e = v >> manBits & ((1u << expBits) - 1);
+    uint64_t m = v & ((1ULL << manBits) - 1);
+    int bias = (1 << (expBits - 1)) - 1;
+    uint64_t bits;
+    double d;
+    if (e == 0) {
+        d = ldexp((double)m, 1 - bias - manBits);
+        return sign ? -d : d;
+    }
+    if (e == (1u << expBits) - 1) bits = 0x7FFULL << 52 | m << (52 - manBits);
+    else bits = (e - bias + 1023) << 52 | m << (52 - manBits);
+    memcpy(&d, &bits, sizeof(d));
+    return sign ? -d : d;
+}
+
+void splitFloat(uint64_t v, const WordFormat *f, FloatFields *out) {
+    unsigned emax = (1u << f->expBits) - 1;
+    int bias = (int)(emax >> 1);
+    out->sign = (unsigned)(v >> (f->expBits + f->manBits) & 1);
+    out->exponent = (unsigned)(v >> f->manBits) & emax;
+    out->mantissa = v & ((1ULL << f->manBits) - 1);
+    out->unbiased = out->exponent == 0 ? 1 - bias : (int)out->exponent - bias;
+    if (out->exponent == 0) out->cls = out->mantissa ? FP_CLASS_SUBNORMAL : FP_CLASS_ZERO;
+    else if (out->exponent == emax) out->cls = out->mantissa ? FP_CLASS_NAN : FP_CLASS_INF;
+    else out->cls = FP_CLASS_NORMAL;
+    out->value = widenToDouble(v, f->expBits, f->manBits);
+}
+
+// double -> binary16, rounding to nearest even
+uint16_t halfFromDouble(double x) {
+    uint64_t b;
+    memcpy(&b, &x, sizeof(b));
+    uint16_t sign = (uint16_t)(b >> 48 & 0x8000);
+    int e = (int)(b >> 52 & 0x7FF);
+    uint64_t m = b & ((1ULL << 52) - 1);
+    if (e == 0x7FF) return sign | 0x7C00 | (m ? 0x200 : 0);
+    int E = e - 1023 + 15;
+    if (E >= 31) return sign | 0x7C00;
+    int shift = 42;
+    if (E <= 0) {                       // subnormal half (or zero)
+        if (E < -10) return sign;
+        m |= 1ULL << 52;
+        shift = 43 - E;
+        E = 0;
+    }
+    uint64_t r = m >> shift, rem = m & ((1ULL << shift) - 1), half = 1ULL << (shift - 1);
+    if (rem > half || (rem == half && (r & 1))) r++;
+    return sign | (uint16_t)(((uint64_t)E << 10) + r);   // a carry moves into the exponent
+}
+
+static void printFloatFields(const char *label, const WordFormat *f, uint64_t v) {
+    FloatFields ff;
+    char exp[72], *p;
+    splitFloat(v, f, &ff);
+    initTables();
+    p = writeBin(ff.exponent, f->expBits, exp);
+    *p = '\0';
+    printf(" %-7s: 0x%0*llX  sign %u  exp %s (%+d)  mantissa 0x%0*llX\n", label,
+           f->bytes * 2, (unsigned long long)v, ff.sign, exp, ff.unbiased,
+           (f->manBits + 3) / 4, (unsigned long long)ff.mantissa);
+    printf("          = %.*g  (%s)\n", f->digits, ff.value, FP_CLASS_NAMES[ff.cls]);
+}
+
+// Show a pattern as every integer width and every IEEE-754 format. Input is
+// 0x-prefixed hex, a decimal integer (negative means two's complement) or a
+// real number, which is first rounded to each float format.
+void printBreakdown(const char *input) {
+    const WordFormat *f16 = wordFormatFind("f16"), *f32 = wordFormatFind("f32"), *f64 = wordFormatFind("f64");
+    char *end;
+    int isHex = input[0] == '0' && (input[1] == 'x' || input[1] == 'X');
+    int isReal = !isHex && strpbrk(input, ".eEiInN") != NULL;
+
+    printf("\n------------------------------------\n");
+    printf("   Bit Pattern Breakdown\n");
+    printf("------------------------------------\n");
+    if (isReal) {
+        double x = strtod(input, &end);
+        if (end == input || *end) {
+            printf(" [!] Invalid number.\n");
+            return;
+        }
+        float xf = (float)x;
+        uint32_t bf;
+        uint64_t bd;
+        memcpy(&bf, &xf, sizeof(bf));
+        memcpy(&bd, &x, sizeof(bd));
+        printFloatFields("half", f16, halfFromDouble(x));
+        printFloatFields("float", f32, bf);
+        printFloatFields("double", f64, bd);
+        printf("------------------------------------\n");
+        return;
+    }
+
+    errno = 0;
+    uint64_t v = input[0] == '-' ? (uint64_t)strtoll(input, &end, 10) : strtoull(input, &end, isHex ? 16 : 10);
+    if (end == input || *end || errno == ERANGE) {
+        printf(" [!] Invalid number.\n");
+        return;
+    }
+    for (int bits = 8; bits <= 64; bits *= 2) {
+        uint64_t low = bits == 64 ? v : v & ((1ULL << bits) - 1);
+        printf(" int%-4d: 0x%0*llX  signed %lld  unsigned %llu\n", bits, bits / 4,
+               (unsigned long long)low, (long long)signExtend(low, bits), (unsigned long long)low);
+    }
+    printf("------------------------------------\n");
+    printFloatFields("half", f16, v & 0xFFFF);
+    printFloatFields("float", f32, v & 0xFFFFFFFFULL);
+    printFloatFields("double", f64, v);
+    printf("------------------------------------\n");
+}
+
+// Running totals for the --fields summary
+typedef struct {
+    unsigned long long count, negative;
+    unsigned long long classes[FP_CLASSES];
+    int64_t imin, imax;
+    uint64_t umin, umax;
+    double fmin, fmax, sum;
+    unsigned long long finite;
+} FieldStats;
+
+// One block of n words, already loaded into raw[]. Fills the per-word
+// arrays the CSV writer needs and adds to st.
+typedef struct {
+    uint64_t raw[WORD_BLOCK];
+    int64_t sval[WORD_BLOCK];
+    uint64_t man[WORD_BLOCK];
+    uint32_t exp[WORD_BLOCK];
+    uint8_t sign[WORD_BLOCK];
+    uint8_t cls[WORD_BLOCK];
+    double val[WORD_BLOCK];
+} WordBlock;
+
+static void loadWords(WordBlock *w, const unsigned char *p, size_t n, int bytes, int bigEndian) {
+    uint64_t *restrict raw = w->raw;
+    switch (bytes) {
+        case 1:
+            for (size_t i = 0; i < n; i++) raw[i] = p[i];
+            break;
+        case 2:
+            for (size_t i = 0; i < n; i++) {
+                uint16_t x;
+                memcpy(&x, p + 2 * i, 2);
+                raw[i] = bigEndian ? __builtin_bswap16(x) : x;
+            }
+            break;
+        case 4:
+            for (size_t i = 0; i < n; i++) {
+                uint32_t x;
+                memcpy(&x, p + 4 * i, 4);
+                raw[i] = bigEndian ? __builtin_bswap32(x) : x;
+            }
+            break;
+        default:
+            for (size_t i = 0; i < n; i++) {
+                uint64_t x;
+                memcpy(&x, p + 8 * i, 8);
+                raw[i] = bigEndian ? __builtin_bswap64(x) : x;
+            }
+            break;
+    }
+}
+
+static void decodeInts(WordBlock *w, size_t n, const WordFormat *f, FieldStats *st) {
+    const uint64_t *restrict raw = w->raw;
+    int64_t *restrict sval = w->sval;
+    int shift = 64 - 8 * f->bytes;
+    if (f->isSigned) {
+        for (size_t i = 0; i < n; i++) sval[i] = (int64_t)(raw[i] << shift) >> shift;
+        int64_t lo = st->imin, hi = st->imax;
+        unsigned long long neg = 0;
+        double sum = 0;
+        for (size_t i = 0; i < n; i++) {
+            lo = sval[i] < lo ? sval[i] : lo;
+            hi = sval[i] > hi ? sval[i] : hi;
+            neg += sval[i] < 0;
+            sum += (double)sval[i];
+        }
+        st->imin = lo; st->imax = hi; st->negative += neg; st->sum += sum;
+    } else {
+        uint64_t lo = st->umin, hi = st->umax;
+        double sum = 0;
+        for (size_t i = 0; i < n; i++) {
+            lo = raw[i] < lo ? raw[i] : lo;
+            hi = raw[i] > hi ? raw[i] : hi;
+            sum += (double)raw[i];
+        }
+        st->umin = lo; st->umax = hi; st->sum += sum;
+    }
+    st->count += n;
+}
+
+static void decodeFloats(WordBlock *w, size_t n, const WordFormat *f, FieldStats *st) {
+    const uint64_t *restrict raw = w->raw;
+    uint64_t *restrict man = w->man;
+    uint32_t *restrict exp = w->exp;
+    uint8_t *restrict sign = w->sign, *restrict cls = w->cls;
+    double *restrict val = w->val;
+    int mb = f->manBits;
+    uint32_t emax = (1u << f->expBits) - 1;
+    uint64_t mmask = (1ULL << mb) - 1;
+
+    for (size_t i = 0; i < n; i++) {
+        sign[i] = (uint8_t)(raw[i] >> (f->expBits + mb) & 1);
+        exp[i] = (uint32_t)(raw[i] >> mb) & emax;
+        man[i] = raw[i] & mmask;
+    }
+    for (size_t i = 0; i < n; i++) {
+        uint8_t special = man[i] ? FP_CLASS_NAN : FP_CLASS_INF;
+        uint8_t low = man[i] ? FP_CLASS_SUBNORMAL : FP_CLASS_ZERO;
+        cls[i] = exp[i] == 0 ? low : exp[i] == emax ? special : FP_CLASS_NORMAL;
+    }
+    if (f->bytes == 4) {
+        for (size_t i = 0; i < n; i++) {
+            float x;
+            uint32_t b = (uint32_t)raw[i];
+            memcpy(&x, &b, sizeof(x));
+            val[i] = x;
+        }
+    } else if (f->bytes == 8) {
+        memcpy(val, raw, n * sizeof(double));
+    } else {
+        // widenToDouble() with selects instead of branches, so the loop
+        // vectorizes too. A subnormal m * 2^(1 - bias - mb) is built as
+        // (2^(1 - bias) with fraction m) - 2^(1 - bias).
+        int eb = f->expBits, bias = (int)(emax >> 1);
+        uint64_t rebias = (uint64_t)(1023 - bias), toSpecial = 0x7FF - emax - rebias;
+        double subBase = ldexp(1.0, 1 - bias);
+        for (size_t i = 0; i < n; i++) {
+            uint64_t r = raw[i];
+            uint64_t e = r >> mb & emax, m = (r & mmask) << (52 - mb);
+            uint64_t ef = e + rebias + (e == emax ? toSpecial : 0);
+            uint64_t nb = ef << 52 | m, sb = (rebias + 1) << 52 | m;
+            double dn, ds;
+            memcpy(&dn, &nb, sizeof(dn));
+            memcpy(&ds, &sb, sizeof(ds));
+            double d = e == 0 ? ds - subBase : dn;
+            val[i] = r >> (eb + mb) & 1 ? -d : d;
+        }
+    }
+
+    // Reductions: one pass per class count; min/max with inf/nan swapped
+    // for neutral values; the sum in four lanes since the compiler may not
+    // reorder floating-point additions
+    unsigned long long counts[FP_CLASSES];
+    for (int c = 0; c < FP_CLASSES; c++) {
+        unsigned long long k = 0;
+        for (size_t i = 0; i < n; i++) k += cls[i] == c;
+        counts[c] = k;
+        st->classes[c] += k;
+    }
+    double lo = st->fmin, hi = st->fmax, sum[4] = { 0, 0, 0, 0 };
+    unsigned long long neg = 0;
+    for (size_t i = 0; i < n; i++) {
+        int ok = cls[i] < FP_CLASS_INF;
+        double a = ok ? val[i] : HUGE_VAL, b = ok ? val[i] : -HUGE_VAL;
+        lo = a < lo ? a : lo;
+        hi = b > hi ? b : hi;
+        neg += sign[i];
+    }
+    for (size_t i = 0; i < n; i++) sum[i & 3] += cls[i] < FP_CLASS_INF ? val[i] : 0.0;
+    st->fmin = lo; st->fmax = hi; st->sum += (sum[0] + sum[1]) + (sum[2] + sum[3]);
+    st->finite += n - counts[FP_CLASS_INF] - counts[FP_CLASS_NAN];
+    st->negative += neg; st->count += n;
+}
+
+// CSV rows for one decoded block, index counting from first
+static char *writeFieldRows(const WordBlock *w, size_t n, const WordFormat *f,
+                            unsigned long long first, char *p) {
+    for (size_t i = 0; i < n; i++) {
+        p = writeDec(first + i, p);
+        *p++ = ',';
+        p = writeHex(w->raw[i], 8 * f->bytes, p);
+        *p++ = ',';
+        if (!f->isFloat) {
+            uint64_t mag = w->raw[i];
+            if (f->isSigned && w->sval[i] < 0) {
+                *p++ = '-';
+                mag = 0 - (uint64_t)w->sval[i];
+            }
+            p = writeDec(mag, p);
+        } else {
+            *p++ = (char)('0' + w->sign[i]);
+            *p++ = ',';
+            p = writeDec(w->exp[i], p);
+            *p++ = ',';
+            p = writeHex(w->man[i], f->manBits, p);
+            *p++ = ',';
+            p += sprintf(p, "%.*g", f->digits, w->val[i]);
+            *p++ = ',';
+            size_t len = strlen(FP_CLASS_NAMES[w->cls[i]]);
+            memcpy(p, FP_CLASS_NAMES[w->cls[i]], len);
+            p += len;
+        }
+        *p++ = '\n';
+    }
+    return p;
+}
+
+static void printFieldStats(const FieldStats *st, const WordFormat *f, double seconds) {
+    printf("\n------------------------------------\n");
+    printf("   Field Summary (%s, %llu words)\n", f->name, st->count);
+    printf("------------------------------------\n");
+    if (st->count == 0) {
+        printf(" No complete words.\n");
+    } else if (!f->isFloat) {
+        if (f->isSigned) {
+            printf(" Min         : %lld\n", (long long)st->imin);
+            printf(" Max         : %lld\n", (long long)st->imax);
+            printf(" Negative    : %llu\n", st->negative);
+        } else {
+            printf(" Min         : %llu\n", (unsigned long long)st->umin);
+            printf(" Max         : %llu\n", (unsigned long long)st->umax);
+        }
+        printf(" Mean        : %.10g\n", st->sum / st->count);
+    } else {
+        for (int c = 0; c < FP_CLASSES; c++) printf(" %-11s : %llu\n", FP_CLASS_NAMES[c], st->classes[c]);
+        printf(" Negative    : %llu\n", st->negative);
+        if (st->finite) {
+            printf(" Min         : %.*g\n", f->digits, st->fmin);
+            printf(" Max         : %.*g\n", f->digits, st->fmax);
+            printf(" Mean        : %.10g\n", st->sum / st->finite);
+        }
+    }
+    printf(" Throughput  : %.1f M words/s\n", seconds > 0 ? st->count / seconds / 1e6 : 0.0);
+    printf("------------------------------------\n");
+}
+
+// --fields <format> <file|-> [--be] [--summary]: decode every word of a
+// binary file; CSV rows "index,hex,value" for integers and
+// "index,hex,sign,exponent,mantissa,value,class" for floats, or only the
+// summary with --summary
+int runFields(const WordFormat *f, const char *path, int bigEndian, int summaryOnly) {
+    FILE *in = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    WordBlock *w = malloc(sizeof(WordBlock));
+    unsigned char *buf = malloc((size_t)WORD_BLOCK * f->bytes);
+    char *out = summaryOnly ? NULL : malloc((size_t)WORD_BLOCK * 128);
+    if (!in || !w || !buf || (!summaryOnly && !out)) {
+        fprintf(stderr, in ? "[!] Out of memory\n" : "[!] Cannot open %s\n", path);
+        free(w); free(buf); free(out);
+        return 1;
+    }
+    initTables();
+
+    FieldStats st;
+    memset(&st, 0, sizeof(st));
+    st.imin = INT64_MAX; st.imax = INT64_MIN;
+    st.umin = UINT64_MAX; st.umax = 0;
+    st.fmin = HUGE_VAL; st.fmax = -HUGE_VAL;
+
+    double t0 = wallSeconds();
+    size_t got, carry = 0;
+    while ((got = fread(buf + carry, 1, (size_t)WORD_BLOCK * f->bytes - carry, in)) > 0) {
+        got += carry;
+        size_t n = got / f->bytes;
+        carry = got - n * f->bytes;
+        unsigned long long first = st.count;
+        loadWords(w, buf, n, f->bytes, bigEndian);
+        if (f->isFloat) decodeFloats(w, n, f, &st);
+        else decodeInts(w, n, f, &st);
+        if (!summaryOnly) {
+            char *end = writeFieldRows(w, n, f, first, out);
+            fwrite(out, 1, (size_t)(end - out), stdout);
+        }
+        memmove(buf, buf + n * f->bytes, carry);
+    }
+    double t1 = wallSeconds();
+    if (carry) fprintf(stderr, "[!] %zu trailing byte%s ignored.\n", carry, carry == 1 ? "" : "s");
+    if (summaryOnly) printFieldStats(&st, f, t1 - t0);
+    fflush(stdout);
+
+    if (in != stdin) fclose(in);
+    free(w); free(buf); free(out);
+    return 0;
+}
+
 // --- Main Menu ---
-int main() {
+int main(int argc, char **argv) {
     int choice;
     char input[256];
-    unsigned long long dec;
+
+    if (argc >= 3 && strcmp(argv[1], "--batch") == 0) {
+        return runBatch(argv[2], argc >= 4 ? atoi(argv[3]) : 10);
+    }
+    if (argc >= 4 && strcmp(argv[1], "--big") == 0) {
+        return runBig(atoi(argv[2]), atoi(argv[3]), argc >= 5 ? argv[4] : NULL);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--bench-big") == 0) {
+        return runBigBench(argc >= 3 ? atol(argv[2]) : 1000000);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--bench-parse") == 0) {
+        return runParseBench(argc >= 3 ? atol(argv[2]) : 64);
+    }
+    if (argc >= 4 && strcmp(argv[1], "--dump") == 0) {
+        int fmt = dumpFormatFind(argv[2]);
+        if (fmt < 0) {
+            fprintf(stderr, "[!] Format must be hex, hexbits, octbits or bin\n");
+            return 1;
+        }
+        return runDump(fmt, argv[3], argc >= 5 ? atoi(argv[4]) : defaultThreads(), stdout);
+    }
+    if (argc >= 3 && strcmp(argv[1], "--undump") == 0) {
+        int fmt = dumpFormatFind(argv[2]);
+        if (fmt < 0) {
+            fprintf(stderr, "[!] Format must be hex, hexbits, octbits or bin\n");
+            return 1;
+        }
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        return runUndump(fmt, argc >= 4 ? argv[3] : NULL, stdout);
+    }
+    if (argc >= 3 && strcmp(argv[1], "--bench-dump") == 0) {
+        return runDumpBench(argv[2], argc >= 4 ? atoi(argv[3]) : defaultThreads());
+    }
+    if (argc >= 4 && strcmp(argv[1], "--fields") == 0) {
+        const WordFormat *f = wordFormatFind(argv[2]);
+        int bigEndian = 0, summaryOnly = 0;
+        if (!f) {
+            fprintf(stderr, "[!] Format must be i8, i16, i32, i64, u8, u16, u32, u64, f16, f32 or f64\n");
+            return 1;
+        }
+        for (int i = 4; i < argc; i++) {
+            if (strcmp(argv[i], "--be") == 0) bigEndian = 1;
+            else if (strcmp(argv[i], "--summary") == 0) summaryOnly = 1;
+        }
+        return runFields(f, argv[3], bigEndian, summaryOnly);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--bench") == 0) {
+        return runBench(argc >= 3 ? atol(argv[2]) : 1000000);
+    }
 
     while (1) {
         printf("\n====================================\n");
@@ -169,6 +2221,7 @@ int main() {
         printf(" [3] Hexadecimal → Binary, Decimal, Octal\n");
         printf(" [4] Decimal     → Binary, Octal, Hex\n");
         printf(" [5] Exit\n");
+        printf(" [6] Bit pattern → Signed ints, IEEE-754 fields\n");
         printf("------------------------------------\n");
         printf(" Choose option: ");
 
@@ -185,49 +2238,28 @@ int main() {
                 printf("\n Enter Binary: ");
                 if (!fgets(input, sizeof(input), stdin)) break;
                 input[strcspn(input, "\n")] = '\0';
-                if (!isValidBinary(input)) {
-                    printf("\n[!] Invalid binary number.\n");
-                    break;
-                }
-                dec = binToDec(input);
-                printAll(dec);
+                convertInput(input, 2, "binary");
                 break;
 
             case 2:
                 printf("\n Enter Octal: ");
                 if (!fgets(input, sizeof(input), stdin)) break;
                 input[strcspn(input, "\n")] = '\0';
-                if (!isValidOctal(input)) {
-                    printf("\n[!] Invalid octal number.\n");
-                    break;
-                }
-                dec = strtoull(input, NULL, 8);
-                printAll(dec);
+                convertInput(input, 8, "octal");
                 break;
 
             case 3:
                 printf("\n Enter Hexadecimal: ");
                 if (!fgets(input, sizeof(input), stdin)) break;
                 input[strcspn(input, "\n")] = '\0';
-                if (!isValidHex(input)) {
-                    printf("\n[!] Invalid hexadecimal number.\n");
-                    break;
-                }
-                dec = strtoull(input, NULL, 16);
-                printAll(dec);
+                convertInput(input, 16, "hexadecimal");
                 break;
 
             case 4:
                 printf("\n Enter Decimal: ");
                 if (!fgets(input, sizeof(input), stdin)) break;
                 input[strcspn(input, "\n")] = '\0';
-                char *end;
-                dec = strtoull(input, &end, 10);
-                if (*end != '\0') {
-                    printf("\n[!] Invalid decimal number.\n");
-                } else {
-                    printAll(dec);
-                }
+                convertInput(input, 10, "decimal");
                 break;
 
             case 5:
@@ -238,6 +2270,13 @@ int main() {
                 printf("====================================\n");
                 exit(0);
 
+            case 6:
+                printf("\n Enter value (0x hex, integer or real): ");
+                if (!fgets(input, sizeof(input), stdin)) break;
+                input[strcspn(input, "\n")] = '\0';
+                printBreakdown(input);
+                break;
+
             default:
                 printf("\n Invalid choice! Try again.\n");
         }
@@ -1,27 +1,70 @@
+// employee.c
+// Payroll: interactive entry, or batch runs over a CSV of employees
+// Compile: gcc -O2 employee.c -o employee -pthread
+// Batch:   ./employee --batch <employees.csv> [--threads <n>] [--tax <jurisdiction> <year>]
+//                     [--tax-config <file>] [--report fixed|csv|columns <out|->]
+//          ./employee --engine <employees.csv> [--threads <n>] [--tax ...] [--tax-config ...]
+//                     then change commands on stdin (help lists them)
+//          ./employee --post <employees.csv> <YYYY-MM> <ledger> [--jurisdiction <code>]
+//                     [--tax-config <file>]   appends the run as that period's segment
+//          ./employee --ledger <ledger> [<from YYYY-MM> [<to YYYY-MM>]] [--employee <email>]
+//          ./employee --reconcile <ledger> <year> [--jurisdiction <code>] [--tax-config <file>]
+//          ./employee --generate <rows> <employees.csv>
+//          ./employee --bench-tax [count] [--tax-config <file>]
+// CSV rows: name,age,email,salary[,label,amount]...
+// Build with -march=native to evaluate tax brackets 4 salaries at a time (AVX2).
+// Multiply-add contraction is switched off below, so the scalar and SIMD tax
+// code round the same way whatever -ffp-contract the build uses.
+
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// GCC fuses a * b + c into one FMA by default (and only where it sees fit),
+// which changes the last bit of some taxes; keep every product rounded
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
 
-// Max employees and max extra tax entries per employee
-#define MAX_EMPLOYEES 100
-#define MAX_EXTRA_TAX 5
+#define MAX_THREADS 64    // batch mode worker threads
 
 // Struct for extra tax with label + amount
 typedef struct {
-    char label[30];
+    const char *label;   // interned: every "SSS" is the same pointer
     double amount;
 } ExtraTax;
 
-// Employee struct with basic info + tax details
-typedef struct {
-    char name[50];       // Employee name
+// Employee struct with basic info + tax details. Records, their strings and
+// their deduction lists live in the payroll run's arena (see Interactive
+// records below), sized to what was entered.
+typedef struct Employee {
+    const char *name;    // Employee name
+    const char *email;   // Employee email
     int age;             // Employee age
-    char email[50];      // Employee email
+    int extraCount;      // Number of extra deductions
     double salary;       // Monthly salary
     double tax;          // Base tax (TRAIN law)
-    ExtraTax extraTaxes[MAX_EXTRA_TAX]; // Up to 5 extra deductions
-    int extraCount;      // Number of extra deductions
+    ExtraTax *extraTaxes; // extraCount extra deductions
     double totalTax;     // Base tax + all extras
     double netPay;       // Salary - totalTax
+    struct Employee *next; // Next employee in entry order
 } Employee;
 
 // Function to compute base monthly tax using TRAIN law
@@ -41,34 +84,2705 @@ double computeTax(double salary) {
     }
 }
 
-int main() {
-    Employee employees[MAX_EMPLOYEES]; // Array to store employees
-    int count = 0;                     // Current number of employees
-    char choice;                       // User choice to add more
+// ------------------ Tax tables ------------------
+// Brackets are data: one line per jurisdiction and year of the form
+//   PH 2018 0:0 250000:0.20 400000:0.25 800000:0.30 2000000:0.32 8000000:0.35
+// where each lower:rate[:base] gives a bracket's annual lower bound, its
+// marginal rate and optionally the tax due at the lower bound. Missing bases
+// are accumulated from the brackets below and rounded to cents, which gives
+// the same constants computeTax() has written out. A table applies from its
+// year until the next one of the same jurisdiction.
+#define MAX_BRACKETS   16
+#define MAX_TAX_TABLES 64
 
-    do {
-        if (count >= MAX_EMPLOYEES) {
-            printf("Employee list is full!\n");
+typedef struct {
+    char jurisdiction[16];
+    int year;
+    int count;
+    double lower[MAX_BRACKETS];     // annual lower bound; lower[0] is 0
+    double rate[MAX_BRACKETS];
+    double base[MAX_BRACKETS];      // annual tax at lower[k]
+    double monthly[MAX_BRACKETS];   // lower[k] / 12, compared with the salary
+} TaxTable;
+
+typedef struct {
+    TaxTable table[MAX_TAX_TABLES];
+    int count;
+} TaxTables;
+
+static const char *DEFAULT_TAX_CONFIG =
+    "# TRAIN law (RA 10963): annual lower bound:rate\n"
+    "PH 2018 0:0 250000:0.20 400000:0.25 800000:0.30 2000000:0.32 8000000:0.35\n"
+    "PH 2023 0:0 250000:0.15 400000:0.20 800000:0.25 2000000:0.30 8000000:0.35\n";
+
+static double roundCents(double x) {
+    double c = x * 100 + (x < 0 ? -0.5 : 0.5);
+    return (double)(long long)c / 100;
+}
+
+// Parse config text into tables; prints the first error and returns -1
+int parseTaxConfig(const char *text, TaxTables *out) {
+    int lineNo = 0;
+    out->count = 0;
+    while (*text) {
+        const char *eol = strchr(text, '\n');
+        size_t len = eol ? (size_t)(eol - text) : strlen(text);
+        char line[1024];
+        lineNo++;
+        if (len >= sizeof(line)) {
+            printf("Tax config line %d: too long\n", lineNo);
+            return -1;
+        }
+        memcpy(line, text, len);
+        line[len] = '\0';
+        text += len + (eol != NULL);
+
+        char *hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        char *tok = strtok(line, " \t\r");
+        if (!tok) continue;
+        if (out->count == MAX_TAX_TABLES) {
+            printf("Tax config line %d: more than %d tables\n", lineNo, MAX_TAX_TABLES);
+            return -1;
+        }
+        TaxTable *t = &out->table[out->count];
+        memset(t, 0, sizeof(*t));
+        snprintf(t->jurisdiction, sizeof(t->jurisdiction), "%s", tok);
+        tok = strtok(NULL, " \t\r");
+        if (!tok || (t->year = atoi(tok)) <= 0) {
+            printf("Tax config line %d: missing year\n", lineNo);
+            return -1;
+        }
+        while ((tok = strtok(NULL, " \t\r")) != NULL) {
+            double lower, rate, base;
+            int fields = sscanf(tok, "%lf:%lf:%lf", &lower, &rate, &base);
+            int k = t->count;
+            if (fields < 2 || k < 0 || k >= MAX_BRACKETS || rate < 0 || rate > 1 ||
+                (k == 0 && lower != 0) || (k > 0 && lower <= t->lower[k - 1])) {
+                printf("Tax config line %d: bad bracket '%s'\n", lineNo, tok);
+                return -1;
+            }
+            t->lower[k] = lower;
+            t->rate[k] = rate;
+            t->base[k] = fields == 3 ? base
+                       : k == 0 ? 0.0
+                       : roundCents(t->base[k - 1] + (lower - t->lower[k - 1]) * t->rate[k - 1]);
+            t->monthly[k] = lower / 12;
+            t->count++;
+        }
+        if (t->count == 0) {
+            printf("Tax config line %d: no brackets\n", lineNo);
+            return -1;
+        }
+        out->count++;
+    }
+    return 0;
+}
+
+// Load a config file, or the built-in TRAIN tables when path is NULL
+int loadTaxConfig(const char *path, TaxTables *out) {
+    if (!path) return parseTaxConfig(DEFAULT_TAX_CONFIG, out);
+    FILE *in = fopen(path, "rb");
+    if (!in) {
+        printf("Cannot read %s\n", path);
+        return -1;
+    }
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    rewind(in);
+    char *text = malloc(size > 0 ? (size_t)size + 1 : 1);
+    size_t got = text ? fread(text, 1, size > 0 ? (size_t)size : 0, in) : 0;
+    fclose(in);
+    if (!text) return -1;
+    text[got] = '\0';
+    int rc = parseTaxConfig(text, out);
+    free(text);
+    return rc;
+}
+
+// The table in force for a jurisdiction in a given year
+const TaxTable *findTaxTable(const TaxTables *tables, const char *jurisdiction, int year) {
+    const TaxTable *best = NULL;
+    for (int i = 0; i < tables->count; i++) {
+        const TaxTable *t = &tables->table[i];
+        if (strcmp(t->jurisdiction, jurisdiction) != 0 || t->year > year) continue;
+        if (!best || t->year > best->year) best = t;
+    }
+    return best;
+}
+
+// Monthly tax from a table. The bracket is the count of lower bounds the
+// salary is above, found with compares and selects instead of a branch
+// ladder; the final expression has the same shape as computeTax(), so the
+// results are identical bit for bit.
+double taxFromTable(const TaxTable *t, double salary) {
+    double base = t->base[0], lower = t->lower[0], rate = t->rate[0];
+    for (int k = 1; k < t->count; k++) {
+        int above = salary > t->monthly[k];
+        base = above ? t->base[k] : base;
+        lower = above ? t->lower[k] : lower;
+        rate = above ? t->rate[k] : rate;
+    }
+    return (base + (salary * 12 - lower) * rate) / 12;
+}
+
+// Monthly tax for a whole salary column: 4 salaries per step with AVX2,
+// 2 with SSE2, each bracket applied as a compare mask and blend
+void taxColumn(const TaxTable *t, const double *salary, double *tax, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256d twelve = _mm256_set1_pd(12.0);
+    for (; i + 4 <= n; i += 4) {
+        __m256d s = _mm256_loadu_pd(salary + i);
+        __m256d base = _mm256_set1_pd(t->base[0]);
+        __m256d lower = _mm256_set1_pd(t->lower[0]);
+        __m256d rate = _mm256_set1_pd(t->rate[0]);
+        for (int k = 1; k < t->count; k++) {
+            __m256d above = _mm256_cmp_pd(s, _mm256_set1_pd(t->monthly[k]), _CMP_GT_OQ);
+            base = _mm256_blendv_pd(base, _mm256_set1_pd(t->base[k]), above);
+            lower = _mm256_blendv_pd(lower, _mm256_set1_pd(t->lower[k]), above);
+            rate = _mm256_blendv_pd(rate, _mm256_set1_pd(t->rate[k]), above);
+        }
+        __m256d x = _mm256_sub_pd(_mm256_mul_pd(s, twelve), lower);
+        _mm256_storeu_pd(tax + i, _mm256_div_pd(_mm256_add_pd(base, _mm256_mul_pd(x, rate)), twelve));
+    }
+#elif defined(__SSE2__)
+    const __m128d twelve = _mm_set1_pd(12.0);
+    for (; i + 2 <= n; i += 2) {
+        __m128d s = _mm_loadu_pd(salary + i);
+        __m128d base = _mm_set1_pd(t->base[0]);
+        __m128d lower = _mm_set1_pd(t->lower[0]);
+        __m128d rate = _mm_set1_pd(t->rate[0]);
+        for (int k = 1; k < t->count; k++) {
+            __m128d above = _mm_cmpgt_pd(s, _mm_set1_pd(t->monthly[k]));
+            base = _mm_or_pd(_mm_and_pd(above, _mm_set1_pd(t->base[k])), _mm_andnot_pd(above, base));
+            lower = _mm_or_pd(_mm_and_pd(above, _mm_set1_pd(t->lower[k])), _mm_andnot_pd(above, lower));
+            rate = _mm_or_pd(_mm_and_pd(above, _mm_set1_pd(t->rate[k])), _mm_andnot_pd(above, rate));
+        }
+        __m128d x = _mm_sub_pd(_mm_mul_pd(s, twelve), lower);
+        _mm_storeu_pd(tax + i, _mm_div_pd(_mm_add_pd(base, _mm_mul_pd(x, rate)), twelve));
+    }
+#endif
+    for (; i < n; i++) tax[i] = taxFromTable(t, salary[i]);
+}
+
+// ------------------ Batch payroll ------------------
+// The interactive path keeps one Employee struct per person. Batch runs use
+// a column store instead: one array per field, strings kept in a shared
+// pool and deductions kept as (label, amount) lists indexed per row.
+// Each column pass touches only the arrays it needs, so a monthly run over
+// millions of rows streams through memory on every core.
+
+double nowSeconds() {
+#ifndef _WIN32
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+int defaultThreads() {
+#ifdef _SC_NPROCESSORS_ONLN
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n > 0) return (int)n;
+#endif
+    return 1;
+}
+
+void *xrealloc(void *p, size_t size) {
+    p = realloc(p, size ? size : 1);
+    if (!p) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+// --- String Pool ---
+// Strings are stored NUL-terminated, back to back in one buffer and named
+// by a 32-bit id; offset[id + 1] - offset[id] - 1 is the length. Names and
+// emails are appended as they come (poolAdd). Labels are interned
+// (poolIntern) so every "SSS" shares one id, which later passes use for
+// grouping and dependency tracking.
+typedef struct {
+    char *text;
+    size_t textLen, textCap;
+    uint32_t *offset;       // count + 1 entries
+    uint32_t count, cap;
+    uint64_t *slots;        // intern table: hash << 32 | (id + 1), 0 = empty
+    uint32_t mask, interned;
+} StringPool;
+
+static uint32_t hashBytes(const char *s, size_t len) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < len; i++) h = (h ^ (unsigned char)s[i]) * 0x100000001B3ULL;
+    h ^= h >> 29;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    return (uint32_t)(h ^ (h >> 32));
+}
+
+void poolInit(StringPool *p) {
+    memset(p, 0, sizeof(*p));
+    p->mask = 255;
+    p->slots = calloc(p->mask + 1, sizeof(uint64_t));
+    p->offset = xrealloc(NULL, sizeof(uint32_t));
+    p->offset[0] = 0;
+}
+
+void poolFree(StringPool *p) {
+    free(p->text);
+    free(p->offset);
+    free(p->slots);
+}
+
+static inline const char *poolGet(const StringPool *p, uint32_t id) {
+    return p->text + p->offset[id];
+}
+
+static inline uint32_t poolLen(const StringPool *p, uint32_t id) {
+    return p->offset[id + 1] - p->offset[id] - 1;
+}
+
+// Append s[0..len) as a new string (no lookup) and return its id
+uint32_t poolAdd(StringPool *p, const char *s, size_t len) {
+    if (p->textLen + len + 1 > UINT32_MAX) {
+        fprintf(stderr, "String pool full (4 GB)\n");
+        exit(1);
+    }
+    if (p->textLen + len + 1 > p->textCap) {
+        p->textCap = (p->textCap ? p->textCap * 2 : 1 << 16) + len;
+        p->text = xrealloc(p->text, p->textCap);
+    }
+    if (p->count + 2 > p->cap) {
+        p->cap = p->cap ? p->cap * 2 : 1024;
+        p->offset = xrealloc(p->offset, sizeof(uint32_t) * p->cap);
+    }
+    uint32_t id = p->count++;
+    memcpy(p->text + p->textLen, s, len);
+    p->text[p->textLen + len] = '\0';
+    p->textLen += len + 1;
+    p->offset[id + 1] = (uint32_t)p->textLen;
+    return id;
+}
+
+static void poolGrowSlots(StringPool *p) {
+    uint32_t mask = p->mask * 2 + 1;
+    uint64_t *slots = calloc((size_t)mask + 1, sizeof(uint64_t));
+    if (!slots) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    for (uint32_t i = 0; i <= p->mask; i++) {
+        if (!p->slots[i]) continue;
+        uint32_t h = (uint32_t)(p->slots[i] >> 32) & mask;
+        while (slots[h]) h = (h + 1) & mask;
+        slots[h] = p->slots[i];
+    }
+    free(p->slots);
+    p->slots = slots;
+    p->mask = mask;
+}
+
+// Id of s[0..len), adding it on first sight
+uint32_t poolIntern(StringPool *p, const char *s, size_t len) {
+    uint32_t hash = hashBytes(s, len), h = hash & p->mask;
+    while (p->slots[h]) {
+        uint32_t id = (uint32_t)p->slots[h] - 1;
+        if ((uint32_t)(p->slots[h] >> 32) == hash && poolLen(p, id) == len &&
+            memcmp(poolGet(p, id), s, len) == 0) return id;
+        h = (h + 1) & p->mask;
+    }
+    uint32_t id = poolAdd(p, s, len);
+    p->slots[h] = (uint64_t)hash << 32 | (id + 1);
+    if (++p->interned * 2 > p->mask) poolGrowSlots(p);
+    return id;
+}
+
+// Drop every string with id >= count (and its intern slot, if any), for
+// undoing the strings of a rejected row. Intern slots are removed with
+// backward-shift deletion so later lookups still find every probe chain.
+void poolTruncate(StringPool *p, uint32_t count) {
+    for (uint32_t id = p->count; id-- > count;) {
+        uint32_t h = hashBytes(poolGet(p, id), poolLen(p, id)) & p->mask;
+        while (p->slots[h] && (uint32_t)p->slots[h] != id + 1) h = (h + 1) & p->mask;
+        if (!p->slots[h]) continue;             // added, not interned
+        p->slots[h] = 0;
+        p->interned--;
+        for (uint32_t j = (h + 1) & p->mask; p->slots[j]; j = (j + 1) & p->mask) {
+            uint32_t home = (uint32_t)(p->slots[j] >> 32) & p->mask;
+            if (((j - home) & p->mask) >= ((j - h) & p->mask)) {
+                p->slots[h] = p->slots[j];
+                p->slots[j] = 0;
+                h = j;
+            }
+        }
+    }
+    if (count < p->count) {
+        p->textLen = p->offset[count];
+        p->count = count;
+    }
+}
+
+// Id of an interned string, or UINT32_MAX if it was never interned
+uint32_t poolFind(const StringPool *p, const char *s, size_t len) {
+    uint32_t hash = hashBytes(s, len), h = hash & p->mask;
+    while (p->slots[h]) {
+        uint32_t id = (uint32_t)p->slots[h] - 1;
+        if ((uint32_t)(p->slots[h] >> 32) == hash && poolLen(p, id) == len &&
+            memcmp(poolGet(p, id), s, len) == 0) return id;
+        h = (h + 1) & p->mask;
+    }
+    return UINT32_MAX;
+}
+
+// --- Payroll Store ---
+typedef struct {
+    size_t n, cap;
+    uint32_t *name, *email;     // string pool ids
+    int *age;
+    double *salary;             // inputs
+    double *tax, *totalTax, *netPay;    // outputs of payrollCompute()
+    uint32_t *dedStart;         // row i owns deductions dedStart[i] .. dedStart[i+1]-1
+    uint32_t *dedLabel;         // string pool id of each deduction label
+    double *dedAmount;
+    size_t dedCount, dedCap;
+    StringPool strings;
+    const TaxTable *taxTable;   // brackets used by payrollCompute()
+} PayrollStore;
+
+void storeInit(PayrollStore *s) {
+    memset(s, 0, sizeof(*s));
+    poolInit(&s->strings);
+    s->dedStart = xrealloc(NULL, sizeof(uint32_t));
+    s->dedStart[0] = 0;
+}
+
+void storeFree(PayrollStore *s) {
+    free(s->name); free(s->email); free(s->age); free(s->salary);
+    free(s->tax); free(s->totalTax); free(s->netPay);
+    free(s->dedStart); free(s->dedLabel); free(s->dedAmount);
+    poolFree(&s->strings);
+}
+
+static void storeReserve(PayrollStore *s, size_t rows) {
+    if (rows <= s->cap) return;
+    size_t cap = s->cap ? s->cap : 1024;
+    while (cap < rows) cap *= 2;
+    s->name = xrealloc(s->name, sizeof(uint32_t) * cap);
+    s->email = xrealloc(s->email, sizeof(uint32_t) * cap);
+    s->age = xrealloc(s->age, sizeof(int) * cap);
+    s->salary = xrealloc(s->salary, sizeof(double) * cap);
+    s->tax = xrealloc(s->tax, sizeof(double) * cap);
+    s->totalTax = xrealloc(s->totalTax, sizeof(double) * cap);
+    s->netPay = xrealloc(s->netPay, sizeof(double) * cap);
+    s->dedStart = xrealloc(s->dedStart, sizeof(uint32_t) * (cap + 1));
+    s->cap = cap;
+}
+
+static void storeAddDeduction(PayrollStore *s, uint32_t label, double amount) {
+    if (s->dedCount == s->dedCap) {
+        s->dedCap = s->dedCap ? s->dedCap * 2 : 4096;
+        s->dedLabel = xrealloc(s->dedLabel, sizeof(uint32_t) * s->dedCap);
+        s->dedAmount = xrealloc(s->dedAmount, sizeof(double) * s->dedCap);
+    }
+    s->dedLabel[s->dedCount] = label;
+    s->dedAmount[s->dedCount] = amount;
+    s->dedCount++;
+}
+
+// --- CSV Ingest ---
+// Fields are separated by commas; a field may be "quoted" (with "" for a
+// quote) so names can contain commas. A first line starting with "name" is
+// taken as a header.
+
+// Next field of the line [*pos, end); returns its length and sets *out.
+// Quoted fields are unescaped into buf.
+static size_t nextField(const char **pos, const char *end, const char **out, char *buf, size_t bufSize) {
+    const char *p = *pos;
+    if (p < end && *p == '"') {
+        size_t n = 0;
+        p++;
+        while (p < end) {
+            if (*p == '"') {
+                if (p + 1 < end && p[1] == '"') p++;
+                else { p++; break; }
+            }
+            if (n + 1 < bufSize) buf[n++] = *p;
+            p++;
+        }
+        while (p < end && *p != ',') p++;
+        *pos = p < end ? p + 1 : end;
+        *out = buf;
+        return n;
+    }
+    const char *start = p;
+    while (p < end && *p != ',') p++;
+    *pos = p < end ? p + 1 : end;
+    *out = start;
+    return (size_t)(p - start);
+}
+
+// Decimal amount such as 12345.67. Up to 15 significant digits this is
+// exact: the digits form an exact integer and one correctly rounded
+// division by a power of ten gives the same double strtod() would.
+static int parseAmount(const char *s, size_t len, double *out) {
+    static const double POW10[] = { 1, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8,
+                                    1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+    size_t i = 0;
+    int neg = 0, digits = 0, frac = -1;
+    uint64_t v = 0;
+    while (i < len && s[i] == ' ') i++;
+    if (i < len && (s[i] == '-' || s[i] == '+')) neg = s[i++] == '-';
+    for (; i < len; i++) {
+        unsigned d = (unsigned char)s[i] - '0';
+        if (d < 10) {
+            v = v * 10 + d;
+            digits++;
+            if (frac >= 0) frac++;
+        } else if (s[i] == '.' && frac < 0) {
+            frac = 0;
+        } else {
             break;
         }
+    }
+    while (i < len && (s[i] == ' ' || s[i] == '\r')) i++;
+    if (digits == 0) return 0;
+    if (i < len || digits > 15) {       // exponent, junk or too long: ask libc
+        char tmp[64], *stop;
+        if (len >= sizeof(tmp)) return 0;
+        memcpy(tmp, s, len);
+        tmp[len] = '\0';
+        *out = strtod(tmp, &stop);
+        while (*stop == ' ' || *stop == '\r') stop++;
+        return stop != tmp && *stop == '\0';
+    }
+    double x = frac > 0 ? (double)v / POW10[frac] : (double)v;
+    *out = neg ? -x : x;
+    return 1;
+}
+
+static int parseInt(const char *s, size_t len, int *out) {
+    size_t i = 0;
+    int v = 0, any = 0;
+    while (i < len && s[i] == ' ') i++;
+    for (; i < len && s[i] >= '0' && s[i] <= '9' && v < 100000000; i++, any = 1) v = v * 10 + (s[i] - '0');
+    while (i < len && (s[i] == ' ' || s[i] == '\r')) i++;
+    *out = v;
+    return any && i == len;
+}
+
+// Undo the deductions and strings a rejected line had already added
+static int rejectLine(PayrollStore *s, size_t dedCount, uint32_t stringCount) {
+    s->dedCount = dedCount;
+    poolTruncate(&s->strings, stringCount);
+    return 0;
+}
+
+// Parse one CSV line into a new row; returns 0 if a field is malformed,
+// leaving the store and its string pool as they were
+static int ingestLine(PayrollStore *s, const char *p, const char *end) {
+    char buf[256];
+    const char *f;
+    size_t len;
+    size_t row = s->n;
+    size_t dedBefore = s->dedCount;
+    uint32_t stringsBefore = s->strings.count;
+
+    storeReserve(s, row + 1);
+    len = nextField(&p, end, &f, buf, sizeof(buf));
+    s->name[row] = poolAdd(&s->strings, f, len);
+    len = nextField(&p, end, &f, buf, sizeof(buf));
+    if (!parseInt(f, len, &s->age[row])) return rejectLine(s, dedBefore, stringsBefore);
+    len = nextField(&p, end, &f, buf, sizeof(buf));
+    s->email[row] = poolAdd(&s->strings, f, len);
+    len = nextField(&p, end, &f, buf, sizeof(buf));
+    if (!parseAmount(f, len, &s->salary[row]) || s->salary[row] < 0) return rejectLine(s, dedBefore, stringsBefore);
+    while (p < end) {
+        uint32_t label;
+        double amount;
+        len = nextField(&p, end, &f, buf, sizeof(buf));
+        label = poolIntern(&s->strings, f, len);
+        len = nextField(&p, end, &f, buf, sizeof(buf));
+        if (!parseAmount(f, len, &amount) || amount < 0) return rejectLine(s, dedBefore, stringsBefore);
+        if (amount > 0) storeAddDeduction(s, label, amount);  // 0 means none, as in the prompt
+    }
+    s->n = row + 1;
+    s->dedStart[s->n] = (uint32_t)s->dedCount;
+    return 1;
+}
+
+// Load rows from [data, data + size); returns the number of bad lines
+static size_t ingestBuffer(PayrollStore *s, const char *data, size_t size) {
+    const char *p = data, *end = data + size;
+    size_t lineNo = 0, bad = 0;
+    while (p < end) {
+        const char *nl = memchr(p, '\n', (size_t)(end - p));
+        const char *lineEnd = nl ? nl : end;
+        const char *trim = lineEnd;
+        if (trim > p && trim[-1] == '\r') trim--;
+        lineNo++;
+        if (trim > p && !(lineNo == 1 && strncmp(p, "name", 4) == 0)) {
+            if (!ingestLine(s, p, trim)) {
+                if (bad++ < 10) fprintf(stderr, "Line %zu: invalid row skipped\n", lineNo);
+            }
+        }
+        p = nl ? nl + 1 : end;
+    }
+    return bad;
+}
+
+// Load a CSV file ("-" for stdin); returns -1 if it cannot be read
+long ingestFile(PayrollStore *s, const char *path) {
+#ifndef _WIN32
+    if (strcmp(path, "-") != 0) {
+        int fd = open(path, O_RDONLY);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            if (fd >= 0) close(fd);
+            return -1;
+        }
+        size_t size = (size_t)st.st_size;
+        if (size == 0) { close(fd); return 0; }
+        const char *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) return -1;
+        madvise((void *)data, size, MADV_SEQUENTIAL);
+        size_t bad = ingestBuffer(s, data, size);
+        munmap((void *)data, size);
+        return (long)bad;
+    }
+#endif
+    FILE *in = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    if (!in) return -1;
+    size_t len = 0, cap = 1 << 20, got;
+    char *data = xrealloc(NULL, cap);
+    while ((got = fread(data + len, 1, cap - len, in)) > 0) {
+        len += got;
+        if (len == cap) data = xrealloc(data, cap *= 2);
+    }
+    if (in != stdin) fclose(in);
+    size_t bad = ingestBuffer(s, data, len);
+    free(data);
+    return (long)bad;
+}
+
+// --- Parallel Passes ---
+// Rows are split into equal ranges, one per thread. Each pass is a plain
+// loop over a few columns; partial totals are summed per range and merged.
+typedef struct {
+    double gross, baseTax, deductions, totalTax, net;
+} PayrollTotals;
+
+typedef struct {
+    PayrollStore *s;
+    size_t begin, end;
+    PayrollTotals totals;
+    void *ctx;          // the caller's, passed through
+    int index;          // which range this is, 0 .. threads-1
+} PayrollJob;
+
+typedef void *(*PayrollWorker)(void *);
+
+// Run worker over [0, n) split into up to threads ranges; the jobs array
+// keeps each range's result for the caller to merge
+void parallelRows(PayrollStore *s, size_t n, int threads, PayrollWorker worker, PayrollJob *jobs, void *ctx) {
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if ((size_t)threads > n / 4096 + 1) threads = (int)(n / 4096 + 1);
+    for (int t = 0; t < threads; t++) {
+        memset(&jobs[t], 0, sizeof(jobs[t]));
+        jobs[t].s = s;
+        jobs[t].begin = n * t / threads;
+        jobs[t].end = n * (t + 1) / threads;
+        jobs[t].ctx = ctx;
+        jobs[t].index = t;
+    }
+    for (int t = threads; t < MAX_THREADS; t++) memset(&jobs[t], 0, sizeof(jobs[t]));
+#ifndef _WIN32
+    pthread_t tid[MAX_THREADS];
+    int started = 0;
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&tid[t], NULL, worker, &jobs[t]) != 0) break;
+        started = t;
+    }
+    worker(&jobs[0]);
+    for (int t = started + 1; t < threads; t++) worker(&jobs[t]);
+    for (int t = 1; t <= started; t++) pthread_join(tid[t], NULL);
+#else
+    for (int t = 0; t < threads; t++) worker(&jobs[t]);
+#endif
+}
+
+// tax, totalTax and netPay for one range of rows, the same arithmetic as
+// the interactive path (totalTax = tax, then each deduction added in order)
+static void *computeWorker(void *arg) {
+    PayrollJob *job = arg;
+    PayrollStore *s = job->s;
+    const double *salary = s->salary;
+    double *tax = s->tax, *totalTax = s->totalTax, *netPay = s->netPay;
+    const uint32_t *start = s->dedStart;
+    const double *amount = s->dedAmount;
+    PayrollTotals t = { 0, 0, 0, 0, 0 };
+
+    taxColumn(s->taxTable, salary + job->begin, tax + job->begin, job->end - job->begin);
+    for (size_t i = job->begin; i < job->end; i++) {
+        double total = tax[i];
+        for (uint32_t k = start[i]; k < start[i + 1]; k++) total += amount[k];
+        totalTax[i] = total;
+    }
+    for (size_t i = job->begin; i < job->end; i++) netPay[i] = salary[i] - totalTax[i];
+    for (size_t i = job->begin; i < job->end; i++) {
+        t.gross += salary[i];
+        t.baseTax += tax[i];
+        t.totalTax += totalTax[i];
+        t.net += netPay[i];
+    }
+    t.deductions = t.totalTax - t.baseTax;
+    job->totals = t;
+    return NULL;
+}
+
+PayrollTotals payrollCompute(PayrollStore *s, int threads) {
+    PayrollJob jobs[MAX_THREADS];
+    PayrollTotals sum = { 0, 0, 0, 0, 0 };
+    parallelRows(s, s->n, threads, computeWorker, jobs, NULL);
+    for (int t = 0; t < MAX_THREADS; t++) {
+        sum.gross += jobs[t].totals.gross;
+        sum.baseTax += jobs[t].totals.baseTax;
+        sum.deductions += jobs[t].totals.deductions;
+        sum.totalTax += jobs[t].totals.totalTax;
+        sum.net += jobs[t].totals.net;
+    }
+    return sum;
+}
+
+// --- Reports ---
+// Rows are formatted straight into large buffers, several ranges at once,
+// and each buffer goes out with one fwrite() on an unbuffered stream, that
+// is one write() per chunk. Amounts are printed from integer cents; the
+// rare values where x * 100 lands too close to a half cent to round
+// safely go through snprintf(), so the text is always what "%.2f" gives.
+//   fixed    the interactive summary table
+//   csv      name,age,email,salary,tax,total_tax,net_pay[,label,amount]...
+//   columns  binary, little-endian on x86:
+//              "PAYCOLS1", u64 rows, u64 deductions, u64 strings, u64 text bytes
+//              u32 name[rows], u32 email[rows]      string ids
+//              i32 age[rows]
+//              f64 salary, tax, total_tax, net_pay [rows each]
+//              u32 ded_start[rows + 1], u32 ded_label[deductions]
+//              f64 ded_amount[deductions]
+//              u32 string_offset[strings + 1], text (NUL-terminated strings)
+#define REPORT_CHUNK_ROWS 16384
+#define REPORT_FLUSH      (1 << 20)   // single-threaded writers flush at this size
+
+typedef enum { REPORT_FIXED, REPORT_CSV, REPORT_COLUMNS, REPORT_FORMAT_COUNT } ReportFormat;
+
+static const char *REPORT_FORMAT_NAMES[REPORT_FORMAT_COUNT] = { "fixed", "csv", "columns" };
+
+typedef struct {
+    char *data;
+    size_t len, cap;
+} ReportBuffer;
+
+typedef struct {
+    const PayrollStore *s;
+    ReportFormat format;
+    size_t base;                    // first row of the current round
+    ReportBuffer buf[MAX_THREADS];
+} ReportWriter;
+
+static const char DIGIT_PAIRS[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+int reportFormatFind(const char *name) {
+    for (int i = 0; i < REPORT_FORMAT_COUNT; i++) {
+        if (strcmp(REPORT_FORMAT_NAMES[i], name) == 0) return i;
+    }
+    return -1;
+}
+
+static void reportReserve(ReportBuffer *b, size_t more) {
+    if (b->len + more <= b->cap) return;
+    size_t cap = b->cap ? b->cap : 1 << 20;
+    while (cap < b->len + more) cap *= 2;
+    b->data = xrealloc(b->data, cap);
+    b->cap = cap;
+}
+
+static char *putUnsigned(char *p, unsigned long long v) {
+    char tmp[24];
+    char *t = tmp + sizeof(tmp);
+    while (v >= 100) {
+        t -= 2;
+        memcpy(t, DIGIT_PAIRS + 2 * (v % 100), 2);
+        v /= 100;
+    }
+    if (v >= 10) {
+        t -= 2;
+        memcpy(t, DIGIT_PAIRS + 2 * v, 2);
+    } else {
+        *--t = (char)('0' + v);
+    }
+    size_t len = (size_t)(tmp + sizeof(tmp) - t);
+    memcpy(p, t, len);
+    return p + len;
+}
+
+static char *putInt(char *p, long long v) {
+    if (v < 0) {
+        *p++ = '-';
+        return putUnsigned(p, 0ULL - (unsigned long long)v);
+    }
+    return putUnsigned(p, (unsigned long long)v);
+}
+
+// x as "%.2f" would print it
+static char *putCents(char *p, double x) {
+    double y = x * 100;
+    if (y > -1e12 && y < 1e12) {
+        long long c = (long long)(y < 0 ? y - 0.5 : y + 0.5);
+        double off = y - (double)c;
+        uint64_t bits;
+        memcpy(&bits, &x, sizeof(bits));
+        if (off > -0.499 && off < 0.499 && !(c == 0 && (bits >> 63))) {
+            if (c < 0) {
+                *p++ = '-';
+                c = -c;
+            }
+            p = putUnsigned(p, (unsigned long long)c / 100);
+            *p++ = '.';
+            memcpy(p, DIGIT_PAIRS + 2 * (c % 100), 2);
+            return p + 2;
+        }
+    }
+    return p + sprintf(p, "%.2f", x);
+}
+
+// Field then spaces up to width, as "%-<width>s" does
+static char *putLeft(char *p, const char *text, size_t len, size_t width) {
+    memcpy(p, text, len);
+    p += len;
+    while (len++ < width) *p++ = ' ';
+    return p;
+}
+
+static char *putLeftCents(char *p, double x, size_t width) {
+    char *start = p;
+    p = putCents(p, x);
+    while ((size_t)(p - start) < width) *p++ = ' ';
+    return p;
+}
+
+// Bytes a row can take at most, given its text lengths
+static size_t reportRowBound(size_t textLen, size_t deductions) {
+    return 2048 + 2 * textLen + deductions * 400;      // "%.2f" of a huge amount runs to 300+ digits
+}
+
+// The summary table's heading, exactly as main() printed it
+void reportFixedHeader(ReportBuffer *b) {
+    reportReserve(b, 512);
+    b->len += (size_t)sprintf(b->data + b->len, "\n%-20s %-5s %-25s %-12s %-12s %-12s %-12s\n",
+                              "Employee Name", "Age", "Email", "Salary", "Base Tax", "Total Tax", "Net Pay");
+    b->len += (size_t)sprintf(b->data + b->len, "%s\n",
+        "---------------------------------------------------------------------------------------------------------");
+}
+
+// One employee's line of the summary table; the caller reserves space
+static char *reportFixedRow(char *p, const char *name, size_t nameLen, int age,
+                            const char *email, size_t emailLen, const double money[4]) {
+    char num[24];
+    size_t numLen = (size_t)(putInt(num, age) - num);
+    p = putLeft(p, name, nameLen, 20);
+    *p++ = ' ';
+    p = putLeft(p, num, numLen, 5);
+    *p++ = ' ';
+    p = putLeft(p, email, emailLen, 25);
+    for (int k = 0; k < 4; k++) {
+        *p++ = ' ';
+        p = putLeftCents(p, money[k], 12);
+    }
+    *p++ = '\n';
+    return p;
+}
+
+static char *reportFixedExtra(char *p, int first, const char *label, size_t labelLen, double amount) {
+    if (first) {
+        memcpy(p, "   Extra Taxes:\n", 16);
+        p += 16;
+    }
+    memcpy(p, "      ", 6);
+    p += 6;
+    memcpy(p, label, labelLen);
+    p += labelLen;
+    *p++ = ':';
+    *p++ = ' ';
+    p = putCents(p, amount);
+    *p++ = '\n';
+    return p;
+}
+
+// A CSV field, quoted when it holds a comma, quote or line break
+static char *putCsvField(char *p, const char *text, size_t len) {
+    if (!memchr(text, ',', len) && !memchr(text, '"', len) && !memchr(text, '\n', len)) {
+        memcpy(p, text, len);
+        return p + len;
+    }
+    *p++ = '"';
+    for (size_t i = 0; i < len; i++) {
+        if (text[i] == '"') *p++ = '"';
+        *p++ = text[i];
+    }
+    *p++ = '"';
+    return p;
+}
+
+static void *reportWorker(void *arg) {
+    PayrollJob *job = arg;
+    ReportWriter *w = job->ctx;
+    const PayrollStore *s = w->s;
+    const StringPool *pool = &s->strings;
+    ReportBuffer *b = &w->buf[job->index];
+    b->len = 0;
+    for (size_t i = w->base + job->begin; i < w->base + job->end; i++) {
+        const char *name = poolGet(pool, s->name[i]), *email = poolGet(pool, s->email[i]);
+        size_t nameLen = poolLen(pool, s->name[i]), emailLen = poolLen(pool, s->email[i]);
+        uint32_t d0 = s->dedStart[i], d1 = s->dedStart[i + 1];
+        size_t textLen = nameLen + emailLen;
+        for (uint32_t k = d0; k < d1; k++) textLen += poolLen(pool, s->dedLabel[k]);
+        reportReserve(b, reportRowBound(textLen, d1 - d0));
+        char *p = b->data + b->len;
+        if (w->format == REPORT_FIXED) {
+            const double money[4] = { s->salary[i], s->tax[i], s->totalTax[i], s->netPay[i] };
+            p = reportFixedRow(p, name, nameLen, s->age[i], email, emailLen, money);
+            for (uint32_t k = d0; k < d1; k++) {
+                p = reportFixedExtra(p, k == d0, poolGet(pool, s->dedLabel[k]),
+                                     poolLen(pool, s->dedLabel[k]), s->dedAmount[k]);
+            }
+        } else {
+            p = putCsvField(p, name, nameLen);
+            *p++ = ',';
+            p = putInt(p, s->age[i]);
+            *p++ = ',';
+            p = putCsvField(p, email, emailLen);
+            *p++ = ',';
+            p = putCents(p, s->salary[i]);
+            *p++ = ',';
+            p = putCents(p, s->tax[i]);
+            *p++ = ',';
+            p = putCents(p, s->totalTax[i]);
+            *p++ = ',';
+            p = putCents(p, s->netPay[i]);
+            for (uint32_t k = d0; k < d1; k++) {
+                *p++ = ',';
+                p = putCsvField(p, poolGet(pool, s->dedLabel[k]), poolLen(pool, s->dedLabel[k]));
+                *p++ = ',';
+                p = putCents(p, s->dedAmount[k]);
+            }
+            *p++ = '\n';
+        }
+        b->len = (size_t)(p - b->data);
+    }
+    return NULL;
+}
+
+static int writeColumn(FILE *out, const void *data, size_t size) {
+    return size == 0 || fwrite(data, 1, size, out) == size;
+}
+
+static int reportColumns(FILE *out, const PayrollStore *s) {
+    const StringPool *pool = &s->strings;
+    uint64_t head[4] = { s->n, s->dedCount, pool->count, pool->textLen };
+    size_t n = s->n, m = s->dedCount;
+    return writeColumn(out, "PAYCOLS1", 8) && writeColumn(out, head, sizeof(head)) &&
+           writeColumn(out, s->name, sizeof(uint32_t) * n) && writeColumn(out, s->email, sizeof(uint32_t) * n) &&
+           writeColumn(out, s->age, sizeof(int) * n) && writeColumn(out, s->salary, sizeof(double) * n) &&
+           writeColumn(out, s->tax, sizeof(double) * n) && writeColumn(out, s->totalTax, sizeof(double) * n) &&
+           writeColumn(out, s->netPay, sizeof(double) * n) &&
+           writeColumn(out, s->dedStart, sizeof(uint32_t) * (n + 1)) &&
+           writeColumn(out, s->dedLabel, sizeof(uint32_t) * m) &&
+           writeColumn(out, s->dedAmount, sizeof(double) * m) &&
+           writeColumn(out, pool->offset, sizeof(uint32_t) * (pool->count + 1)) &&
+           writeColumn(out, pool->text, pool->textLen);
+}
+
+// Write a computed store to path ("-" for stdout); returns 0 on success
+int writeReport(const PayrollStore *s, ReportFormat format, const char *path, int threads) {
+    FILE *out = strcmp(path, "-") == 0 ? stdout : fopen(path, "wb");
+    if (!out) {
+        printf("Cannot write %s\n", path);
+        return 1;
+    }
+    if (out == stdout) fflush(out);    // chunks are larger than its buffer, so they go straight out
+    else setvbuf(out, NULL, _IONBF, 0);
+    int ok = 1;
+    if (format == REPORT_COLUMNS) {
+        ok = reportColumns(out, s);
+    } else {
+        ReportWriter *w = calloc(1, sizeof(ReportWriter));
+        PayrollJob jobs[MAX_THREADS];
+        if (!w) {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+        w->s = s;
+        w->format = format;
+        if (threads < 1) threads = 1;
+        if (threads > MAX_THREADS) threads = MAX_THREADS;
+        if (format == REPORT_FIXED) {
+            reportFixedHeader(&w->buf[0]);
+        } else {
+            static const char CSV_HEADER[] = "name,age,email,salary,tax,total_tax,net_pay,label,amount\n";
+            reportReserve(&w->buf[0], sizeof(CSV_HEADER));
+            memcpy(w->buf[0].data, CSV_HEADER, sizeof(CSV_HEADER) - 1);
+            w->buf[0].len = sizeof(CSV_HEADER) - 1;
+        }
+        ok = writeColumn(out, w->buf[0].data, w->buf[0].len);
+        // Each round formats one chunk per thread, then writes them in order
+        size_t round = (size_t)threads * REPORT_CHUNK_ROWS;
+        for (w->base = 0; ok && w->base < s->n; w->base += round) {
+            size_t rows = s->n - w->base < round ? s->n - w->base : round;
+            parallelRows((PayrollStore *)s, rows, threads, reportWorker, jobs, w);
+            for (int t = 0; ok && t < MAX_THREADS && jobs[t].end > jobs[t].begin; t++) {
+                ok = writeColumn(out, w->buf[t].data, w->buf[t].len);
+            }
+        }
+        for (int t = 0; t < MAX_THREADS; t++) free(w->buf[t].data);
+        free(w);
+    }
+    if (out != stdout) ok = fclose(out) == 0 && ok;
+    if (!ok) printf("Error writing %s\n", path);
+    return !ok;
+}
+
+// --- Batch Mode ---
+int runBatch(const char *path, int threads, const TaxTable *table, int format, const char *reportPath) {
+    PayrollStore s;
+    storeInit(&s);
+    s.taxTable = table;
+    double t0 = nowSeconds();
+    long bad = ingestFile(&s, path);
+    double t1 = nowSeconds();
+    if (bad < 0) {
+        printf("Cannot read %s\n", path);
+        storeFree(&s);
+        return 1;
+    }
+    PayrollTotals t = payrollCompute(&s, threads);
+    double t2 = nowSeconds();
+    int reportRc = reportPath ? writeReport(&s, (ReportFormat)format, reportPath, threads) : 0;
+    double t3 = nowSeconds();
+
+    printf("\n==============================================\n");
+    printf(" Payroll batch: %s\n", path);
+    printf(" Tax table    : %s %d (%d brackets)\n", table->jurisdiction, table->year, table->count);
+    printf("==============================================\n");
+    printf(" Employees        : %zu\n", s.n);
+    if (bad) printf(" Skipped rows     : %ld\n", bad);
+    printf(" Deductions       : %zu (%u distinct labels)\n", s.dedCount, s.strings.interned);
+    printf(" Gross salary     : %.2f\n", t.gross);
+    printf(" Base tax         : %.2f\n", t.baseTax);
+    printf(" Extra deductions : %.2f\n", t.deductions);
+    printf(" Total tax        : %.2f\n", t.totalTax);
+    printf(" Net pay          : %.2f\n", t.net);
+    printf("----------------------------------------------\n");
+    printf(" Ingest  : %.3f s\n", t1 - t0);
+    printf(" Compute : %.3f s (%d thread%s)\n", t2 - t1, threads, threads == 1 ? "" : "s");
+    if (reportPath) printf(" Report  : %.3f s (%s, %s)\n", t3 - t2, REPORT_FORMAT_NAMES[format], reportPath);
+    printf("==============================================\n");
+    storeFree(&s);
+    return reportRc ? 1 : bad ? 2 : 0;
+}
+
+// Salary with its bit pattern moved by delta units in the last place
+static double ulpStep(double x, int delta) {
+    int64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits += delta;
+    memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+// --bench-tax [count]: computeTax() against the PH 2018 table, scalar and
+// column-wide, on random salaries plus every bracket edge and its
+// neighbours; any result that differs in a single bit is a mismatch
+int runTaxBench(long count, const TaxTables *tables) {
+    const TaxTable *t = findTaxTable(tables, "PH", 2018);
+    if (!t) {
+        printf("No PH 2018 table to check computeTax() against\n");
+        return 1;
+    }
+    if (count < 1000) count = 1000;
+    size_t n = (size_t)count;
+    double *salary = xrealloc(NULL, sizeof(double) * n);
+    double *ref = xrealloc(NULL, sizeof(double) * n);
+    double *scalar = xrealloc(NULL, sizeof(double) * n);
+    double *column = xrealloc(NULL, sizeof(double) * n);
+
+    size_t edges = 0;
+    for (int k = 0; k < t->count; k++) {
+        for (int d = -2; d <= 2; d++) salary[edges++] = ulpStep(t->monthly[k], d);
+    }
+    salary[edges++] = 0.01;
+    uint64_t r = 0x2545F4914F6CDD1DULL;
+    for (size_t i = edges; i < n; i++) {
+        r ^= r << 13; r ^= r >> 7; r ^= r << 17;
+        salary[i] = (double)(r % 120000000) / 100;       // 0 .. 1.2M a month, in cents
+    }
+
+    double t0 = nowSeconds();
+    for (size_t i = 0; i < n; i++) ref[i] = computeTax(salary[i]);
+    double t1 = nowSeconds();
+    for (size_t i = 0; i < n; i++) scalar[i] = taxFromTable(t, salary[i]);
+    double t2 = nowSeconds();
+    taxColumn(t, salary, column, n);
+    double t3 = nowSeconds();
+
+    size_t badScalar = 0, badColumn = 0;
+    for (size_t i = 0; i < n; i++) {
+        badScalar += memcmp(&ref[i], &scalar[i], sizeof(double)) != 0;
+        badColumn += memcmp(&ref[i], &column[i], sizeof(double)) != 0;
+    }
+
+    printf("\n==============================================\n");
+    printf(" Tax bracket benchmark (%zu salaries)\n", n);
+    printf("==============================================\n");
+    printf(" computeTax()     : %6.2f ns/salary\n", (t1 - t0) * 1e9 / n);
+    printf(" Table, scalar    : %6.2f ns/salary  (%zu mismatches)\n", (t2 - t1) * 1e9 / n, badScalar);
+    printf(" Table, column    : %6.2f ns/salary  (%zu mismatches)\n", (t3 - t2) * 1e9 / n, badColumn);
+    printf("==============================================\n");
+    free(salary); free(ref); free(scalar); free(column);
+    return badScalar || badColumn;
+}
+
+// Synthetic workforce for trying the batch modes
+int runGenerate(long rows, const char *path) {
+    static const char *LABELS[] = { "SSS", "PhilHealth", "Pag-IBIG", "HMO", "Loan" };
+    FILE *out = fopen(path, "wb");
+    if (!out) {
+        printf("Cannot write %s\n", path);
+        return 1;
+    }
+    char *buf = xrealloc(NULL, 1 << 20);
+    setvbuf(out, buf, _IOFBF, 1 << 20);
+    uint64_t r = 0x9E3779B97F4A7C15ULL;
+    fprintf(out, "name,age,email,salary,label,amount\n");
+    for (long i = 0; i < rows; i++) {
+        r ^= r << 13; r ^= r >> 7; r ^= r << 17;
+        // Salaries from 12k to about 1.2M a month, about half under 100k
+        double u = (double)(r >> 11) / 9007199254740992.0;
+        long cents = (long)(1200000 * (1.0 + 99.0 * u * u * u * u));
+        fprintf(out, "Employee %ld,%d,emp%ld@example.com,%ld.%02ld", i, 21 + (int)(r % 45), i,
+                cents / 100, cents % 100);
+        int extras = (int)((r >> 8) % 4);
+        for (int k = 0; k < extras; k++) {
+            fprintf(out, ",%s,%d.%02d", LABELS[(r >> (16 + 4 * k)) % 5],
+                    100 + (int)((r >> (24 + 8 * k)) % 2000), (int)((r >> 40) % 100));
+        }
+        fputc('\n', out);
+    }
+    fclose(out);
+    free(buf);
+    return 0;
+}
+
+// ------------------ Incremental payroll ------------------
+// A PayrollEngine keeps a computed store current under small changes. It
+// records which rows depend on what:
+//   - brackets: rows are kept ordered by salary, so the rows whose tax a
+//     table change can move are one suffix, found by binary search;
+//   - deductions: the entries of each label are listed together, so a new
+//     rule for "SSS" visits only the SSS entries.
+// Only those rows get tax, totalTax and netPay recomputed (with the same
+// arithmetic as computeWorker(), so results match a full run bit for bit)
+// and the totals move by each row's new minus old values.
+//
+// The same engine answers queries: an email hash, salary bands with running
+// sums, and tax and net pay histograms are moved by the same deltas, so
+// dashboards read current figures without a pass over every row.
+
+// How a label's amount is worked out for every entry with that label
+typedef enum { RULE_ENTERED, RULE_FIXED, RULE_RATE } RuleKind;
+
+typedef struct {
+    RuleKind kind;
+    double value;       // the fixed amount, or the rate on the salary
+    double min, max;    // RULE_RATE bounds; max 0 means no cap
+} DeductionRule;
+
+// Salary bands: below 100, then the R10 series (100, 125, 160 .. 800) for
+// every decade up to 8e9, so a band holds at most a 25% salary step
+#define BAND_COUNT   81
+// Tax and net pay histograms: 64 buckets per power of two from 1 to 2^48
+// (about 1% wide), with everything below 1 in bucket 0
+#define HIST_BUCKETS (1 + 48 * 64)
+
+typedef struct {
+    size_t count;
+    double salary, tax, totalTax, net;
+} PayrollBand;
+
+typedef struct {
+    PayrollStore *s;
+    TaxTable table;             // brackets in force, a private copy
+    PayrollTotals totals;       // kept current by deltas
+    int threads;
+    uint32_t *bySalary;         // rows in salary order
+    double *sortedSalary;       // salary[bySalary[p]]
+    uint32_t labelCount, labelMask;
+    uint32_t *labelId;          // string pool id of dense label k
+    uint32_t *labelSlots;       // open addressing: pool id -> dense label + 1
+    uint32_t *labelStart;       // entries of label k: labelEntry[labelStart[k] .. labelStart[k+1]-1]
+    uint32_t *labelEntry;
+    uint32_t *entryRow;         // row owning each deduction entry
+    uint32_t *entryLabel;       // dense label of each deduction entry
+    double *entered;            // amounts as read, used by RULE_ENTERED
+    DeductionRule *rules;       // per dense label
+    double *labelSum;           // current amount per dense label
+    size_t touched;             // rows recomputed by the last change
+    uint32_t *emailSlots;       // open addressing: email hash -> row + 1
+    uint32_t emailMask;
+    uint8_t *rowBand;           // salary band of each row
+    PayrollBand band[BAND_COUNT];
+    uint64_t taxHist[HIST_BUCKETS], netHist[HIST_BUCKETS];
+} PayrollEngine;
+
+static double BAND_LOWER[BAND_COUNT];
+
+static void initBands() {
+    static const int R10[10] = { 100, 125, 160, 200, 250, 315, 400, 500, 630, 800 };
+    double scale = 1;
+    int b = 1;
+    BAND_LOWER[0] = -1e308;
+    for (int decade = 0; decade < 8; decade++, scale *= 10) {
+        for (int j = 0; j < 10; j++) BAND_LOWER[b++] = R10[j] * scale;
+    }
+}
+
+static int salaryBand(double x) {
+    int lo = 0, hi = BAND_COUNT;
+    while (hi - lo > 1) {
+        int mid = (lo + hi) / 2;
+        if (BAND_LOWER[mid] <= x) lo = mid;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Histogram bucket from the exponent and top 6 mantissa bits
+static int histBucket(double x) {
+    if (!(x >= 1)) return 0;
+    uint64_t u;
+    memcpy(&u, &x, sizeof(u));
+    int e = (int)(u >> 52) - 1023;
+    if (e > 47) return HIST_BUCKETS - 1;
+    return 1 + e * 64 + (int)((u >> 46) & 63);
+}
+
+static double histLower(int b) {
+    if (b == 0) return 0;
+    b--;
+    uint64_t u = (uint64_t)(b / 64 + 1023) << 52 | (uint64_t)(b % 64) << 46;
+    double x;
+    memcpy(&x, &u, sizeof(x));
+    return x;
+}
+
+static void bandAdd(PayrollBand *b, const PayrollStore *s, uint32_t i, double sign) {
+    if (sign > 0) b->count++;
+    else b->count--;
+    b->salary += sign * s->salary[i];
+    b->tax += sign * s->tax[i];
+    b->totalTax += sign * s->totalTax[i];
+    b->net += sign * s->netPay[i];
+}
+
+// Add (sign 1) or remove (sign -1) a row's current values in the indexes
+static void indexRow(PayrollEngine *e, uint32_t i, double sign) {
+    const PayrollStore *s = e->s;
+    bandAdd(&e->band[e->rowBand[i]], s, i, sign);
+    e->taxHist[histBucket(s->tax[i])] += sign > 0 ? 1 : (uint64_t)-1;
+    e->netHist[histBucket(s->netPay[i])] += sign > 0 ? 1 : (uint64_t)-1;
+}
+
+// Bands, histograms and label sums from scratch
+static void indexRebuild(PayrollEngine *e) {
+    const PayrollStore *s = e->s;
+    memset(e->band, 0, sizeof(e->band));
+    memset(e->taxHist, 0, sizeof(e->taxHist));
+    memset(e->netHist, 0, sizeof(e->netHist));
+    for (size_t i = 0; i < s->n; i++) indexRow(e, (uint32_t)i, 1);
+    memset(e->labelSum, 0, sizeof(double) * (e->labelCount + 1));
+    for (size_t k = 0; k < s->dedCount; k++) e->labelSum[e->entryLabel[k]] += s->dedAmount[k];
+}
+
+// Unsigned key with the same order as the double
+static inline uint64_t salaryKey(double x) {
+    uint64_t u;
+    memcpy(&u, &x, sizeof(u));
+    return (u >> 63) ? ~u : u | 0x8000000000000000ULL;
+}
+
+// Row ids in salary order: LSD radix sort on 16-bit digits, skipping digits
+// every key shares. Stable, so equal salaries stay in row order.
+static void sortBySalary(const double *salary, size_t n, uint32_t *rows, double *sorted) {
+    uint64_t *key = xrealloc(NULL, sizeof(uint64_t) * n), *key2 = xrealloc(NULL, sizeof(uint64_t) * n);
+    uint32_t *row = rows, *row2 = xrealloc(NULL, sizeof(uint32_t) * n), *spare = row2;
+    size_t *count = xrealloc(NULL, sizeof(size_t) * 65536);
+    for (size_t i = 0; i < n; i++) {
+        key[i] = salaryKey(salary[i]);
+        row[i] = (uint32_t)i;
+    }
+    for (int shift = 0; n > 0 && shift < 64; shift += 16) {
+        memset(count, 0, sizeof(size_t) * 65536);
+        for (size_t i = 0; i < n; i++) count[(key[i] >> shift) & 0xFFFF]++;
+        if (count[(key[0] >> shift) & 0xFFFF] == n) continue;
+        size_t sum = 0;
+        for (int d = 0; d < 65536; d++) {
+            size_t c = count[d];
+            count[d] = sum;
+            sum += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            size_t pos = count[(key[i] >> shift) & 0xFFFF]++;
+            key2[pos] = key[i];
+            row2[pos] = row[i];
+        }
+        uint64_t *k = key; key = key2; key2 = k;
+        uint32_t *r = row; row = row2; row2 = r;
+    }
+    if (row != rows) {
+        memcpy(rows, row, sizeof(uint32_t) * n);
+        spare = row;
+    }
+    for (size_t i = 0; i < n; i++) sorted[i] = salary[rows[i]];
+    free(key); free(key2); free(spare); free(count);
+}
+
+// First position in salary order whose salary is above x
+static size_t salaryUpperBound(const PayrollEngine *e, double x) {
+    size_t lo = 0, hi = e->s->n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (e->sortedSalary[mid] > x) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+// First position in salary order whose salary is at least x
+static size_t salaryLowerBound(const PayrollEngine *e, double x) {
+    size_t lo = 0, hi = e->s->n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (e->sortedSalary[mid] >= x) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+// Dense label number of a string pool id, UINT32_MAX if no entry has it
+static uint32_t engineLabel(const PayrollEngine *e, uint32_t id) {
+    uint32_t h = (id * 2654435761u) & e->labelMask;
+    while (e->labelSlots[h]) {
+        uint32_t k = e->labelSlots[h] - 1;
+        if (e->labelId[k] == id) return k;
+        h = (h + 1) & e->labelMask;
+    }
+    return UINT32_MAX;
+}
+
+static uint32_t engineAddLabel(PayrollEngine *e, uint32_t id) {
+    uint32_t h = (id * 2654435761u) & e->labelMask;
+    while (e->labelSlots[h]) {
+        uint32_t k = e->labelSlots[h] - 1;
+        if (e->labelId[k] == id) return k;
+        h = (h + 1) & e->labelMask;
+    }
+    uint32_t k = e->labelCount++;
+    e->labelId[k] = id;
+    e->labelSlots[h] = k + 1;
+    return k;
+}
+
+static double ruleAmount(const DeductionRule *r, double entered, double salary) {
+    double a;
+    switch (r->kind) {
+        case RULE_FIXED: return r->value;
+        case RULE_RATE:
+            a = roundCents(salary * r->value);
+            if (a < r->min) a = r->min;
+            if (r->max > 0 && a > r->max) a = r->max;
+            return a;
+        default: return entered;
+    }
+}
+
+// Compute the store in full and build the dependency indexes
+void engineBuild(PayrollEngine *e, PayrollStore *s, const TaxTable *table, int threads) {
+    size_t n = s->n, m = s->dedCount;
+    memset(e, 0, sizeof(*e));
+    e->s = s;
+    e->table = *table;
+    e->threads = threads;
+    s->taxTable = &e->table;
+    e->totals = payrollCompute(s, threads);
+
+    e->bySalary = xrealloc(NULL, sizeof(uint32_t) * n);
+    e->sortedSalary = xrealloc(NULL, sizeof(double) * n);
+    sortBySalary(s->salary, n, e->bySalary, e->sortedSalary);
+
+    uint32_t labels = s->strings.interned + 1;
+    e->labelMask = 15;
+    while (e->labelMask < labels * 2) e->labelMask = e->labelMask * 2 + 1;
+    e->labelSlots = calloc((size_t)e->labelMask + 1, sizeof(uint32_t));
+    e->labelId = xrealloc(NULL, sizeof(uint32_t) * labels);
+    if (!e->labelSlots) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    uint32_t *dense = e->entryLabel = xrealloc(NULL, sizeof(uint32_t) * m);
+    for (size_t k = 0; k < m; k++) dense[k] = engineAddLabel(e, s->dedLabel[k]);
+    e->labelStart = calloc((size_t)e->labelCount + 1, sizeof(uint32_t));
+    e->labelEntry = xrealloc(NULL, sizeof(uint32_t) * m);
+    e->entryRow = xrealloc(NULL, sizeof(uint32_t) * m);
+    if (!e->labelStart) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    for (size_t k = 0; k < m; k++) e->labelStart[dense[k] + 1]++;
+    for (uint32_t k = 0; k < e->labelCount; k++) e->labelStart[k + 1] += e->labelStart[k];
+    uint32_t *fill = xrealloc(NULL, sizeof(uint32_t) * (e->labelCount + 1));
+    memcpy(fill, e->labelStart, sizeof(uint32_t) * (e->labelCount + 1));
+    for (size_t k = 0; k < m; k++) e->labelEntry[fill[dense[k]]++] = (uint32_t)k;
+    for (size_t i = 0; i < n; i++) {
+        for (uint32_t k = s->dedStart[i]; k < s->dedStart[i + 1]; k++) e->entryRow[k] = (uint32_t)i;
+    }
+    free(fill);
+
+    e->entered = xrealloc(NULL, sizeof(double) * m);
+    memcpy(e->entered, s->dedAmount, sizeof(double) * m);
+    e->rules = calloc((size_t)e->labelCount + 1, sizeof(DeductionRule));   // all RULE_ENTERED
+    e->labelSum = xrealloc(NULL, sizeof(double) * (e->labelCount + 1));
+
+    e->emailMask = 15;
+    while (e->emailMask < n * 2) e->emailMask = e->emailMask * 2 + 1;
+    e->emailSlots = calloc((size_t)e->emailMask + 1, sizeof(uint32_t));
+    if (!e->emailSlots) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    for (size_t i = 0; i < n; i++) {
+        uint32_t id = s->email[i];
+        uint32_t h = hashBytes(poolGet(&s->strings, id), poolLen(&s->strings, id)) & e->emailMask;
+        while (e->emailSlots[h]) h = (h + 1) & e->emailMask;
+        e->emailSlots[h] = (uint32_t)i + 1;
+    }
+    e->rowBand = xrealloc(NULL, n);
+    initBands();
+    for (size_t i = 0; i < n; i++) e->rowBand[i] = (uint8_t)salaryBand(s->salary[i]);
+    indexRebuild(e);
+}
+
+void engineFree(PayrollEngine *e) {
+    free(e->bySalary); free(e->sortedSalary);
+    free(e->labelId); free(e->labelSlots); free(e->labelStart); free(e->labelEntry);
+    free(e->entryRow); free(e->entryLabel); free(e->entered); free(e->rules);
+    free(e->labelSum); free(e->emailSlots); free(e->rowBand);
+}
+
+// Recompute one row and move the totals by its change (gross is the
+// caller's, since only a salary correction changes it)
+static void engineRecompute(PayrollEngine *e, uint32_t i) {
+    PayrollStore *s = e->s;
+    double tax = taxFromTable(&e->table, s->salary[i]);
+    double total = tax;
+    for (uint32_t k = s->dedStart[i]; k < s->dedStart[i + 1]; k++) total += s->dedAmount[k];
+    double net = s->salary[i] - total;
+    e->totals.baseTax += tax - s->tax[i];
+    e->totals.totalTax += total - s->totalTax[i];
+    e->totals.deductions += (total - tax) - (s->totalTax[i] - s->tax[i]);
+    e->totals.net += net - s->netPay[i];
+    s->tax[i] = tax;
+    s->totalTax[i] = total;
+    s->netPay[i] = net;
+}
+
+// Recompute a row whose salary is unchanged: it stays in its band, and
+// the histograms only move when a value crosses into another bucket
+static void engineRefreshRow(PayrollEngine *e, uint32_t i) {
+    PayrollStore *s = e->s;
+    PayrollBand *b = &e->band[e->rowBand[i]];
+    double tax = s->tax[i], total = s->totalTax[i], net = s->netPay[i];
+    engineRecompute(e, i);
+    b->tax += s->tax[i] - tax;
+    b->totalTax += s->totalTax[i] - total;
+    b->net += s->netPay[i] - net;
+    int from = histBucket(tax), to = histBucket(s->tax[i]);
+    if (from != to) {
+        e->taxHist[from]--;
+        e->taxHist[to]++;
+    }
+    from = histBucket(net);
+    to = histBucket(s->netPay[i]);
+    if (from != to) {
+        e->netHist[from]--;
+        e->netHist[to]++;
+    }
+}
+
+// Switch to another table. Rows at or below the first bracket bound where
+// the tables differ keep their tax, so only the salaries above the lower of
+// the two bounds are revisited. A few of them are walked in salary order;
+// past 1/128 of the workforce the scattered reads cost more than one
+// sequential pass over the salary column picking the same rows, and past
+// half a full threaded rerun is cheaper still.
+void engineSetTable(PayrollEngine *e, const TaxTable *t) {
+    const TaxTable *old = &e->table;
+    int k = 0;
+    while (k < old->count && k < t->count && old->lower[k] == t->lower[k] &&
+           old->rate[k] == t->rate[k] && old->base[k] == t->base[k]) k++;
+    size_t from;
+    if (k == old->count && k == t->count) from = e->s->n;
+    else if (k == 0) from = 0;
+    else {
+        double bound = k < old->count ? old->monthly[k] : t->monthly[k];
+        if (k < old->count && k < t->count && t->monthly[k] < bound) bound = t->monthly[k];
+        from = salaryUpperBound(e, bound);
+    }
+    e->table = *t;
+    e->touched = e->s->n - from;
+    if (e->touched * 2 > e->s->n) {
+        e->totals = payrollCompute(e->s, e->threads);
+        indexRebuild(e);
+        return;
+    }
+    if (e->touched * 128 > e->s->n) {
+        double bound = e->sortedSalary[from];
+        for (size_t i = 0; i < e->s->n; i++) {
+            if (e->s->salary[i] >= bound) engineRefreshRow(e, (uint32_t)i);
+        }
+        return;
+    }
+    for (size_t p = from; p < e->s->n; p++) engineRefreshRow(e, e->bySalary[p]);
+}
+
+// Give every entry of a label a new rule; returns -1 if no entry has it
+int engineSetRule(PayrollEngine *e, uint32_t label, const DeductionRule *rule) {
+    PayrollStore *s = e->s;
+    uint32_t d = engineLabel(e, label);
+    if (d == UINT32_MAX) return -1;
+    e->rules[d] = *rule;
+    e->touched = 0;
+    for (uint32_t j = e->labelStart[d]; j < e->labelStart[d + 1]; j++) {
+        uint32_t k = e->labelEntry[j], i = e->entryRow[k];
+        double amount = ruleAmount(rule, e->entered[k], s->salary[i]);
+        if (amount == s->dedAmount[k]) continue;
+        e->labelSum[d] += amount - s->dedAmount[k];
+        s->dedAmount[k] = amount;
+        engineRefreshRow(e, i);
+        e->touched++;
+    }
+    return 0;
+}
+
+// Correct one salary: the row moves within the salary order (one memmove
+// of the rows between its old and new place) and its salary-based
+// deductions are re-evaluated
+void engineSetSalary(PayrollEngine *e, uint32_t i, double salary) {
+    PayrollStore *s = e->s;
+    double old = s->salary[i];
+    size_t p = salaryUpperBound(e, old);
+    while (e->bySalary[--p] != i) {}
+    if (salary > old) {
+        size_t q = salaryUpperBound(e, salary) - 1;
+        memmove(e->bySalary + p, e->bySalary + p + 1, sizeof(uint32_t) * (q - p));
+        memmove(e->sortedSalary + p, e->sortedSalary + p + 1, sizeof(double) * (q - p));
+        p = q;
+    } else if (salary < old) {
+        size_t q = salaryUpperBound(e, salary);
+        memmove(e->bySalary + q + 1, e->bySalary + q, sizeof(uint32_t) * (p - q));
+        memmove(e->sortedSalary + q + 1, e->sortedSalary + q, sizeof(double) * (p - q));
+        p = q;
+    }
+    e->bySalary[p] = i;
+    e->sortedSalary[p] = salary;
+
+    indexRow(e, i, -1);
+    e->totals.gross += salary - old;
+    s->salary[i] = salary;
+    e->rowBand[i] = (uint8_t)salaryBand(salary);
+    for (uint32_t k = s->dedStart[i]; k < s->dedStart[i + 1]; k++) {
+        double amount = ruleAmount(&e->rules[e->entryLabel[k]], e->entered[k], salary);
+        e->labelSum[e->entryLabel[k]] += amount - s->dedAmount[k];
+        s->dedAmount[k] = amount;
+    }
+    engineRecompute(e, i);
+    indexRow(e, i, 1);
+    e->touched = 1;
+}
+
+// Correct the entered amount of a row's deduction; the row's deduction
+// list is fixed at load time, so the label must already be on the row
+int engineSetDeduction(PayrollEngine *e, uint32_t i, uint32_t label, double amount) {
+    PayrollStore *s = e->s;
+    for (uint32_t k = s->dedStart[i]; k < s->dedStart[i + 1]; k++) {
+        if (s->dedLabel[k] != label) continue;
+        double effective = ruleAmount(&e->rules[e->entryLabel[k]], amount, s->salary[i]);
+        e->entered[k] = amount;
+        e->labelSum[e->entryLabel[k]] += effective - s->dedAmount[k];
+        s->dedAmount[k] = effective;
+        engineRefreshRow(e, i);
+        e->touched = 1;
+        return 0;
+    }
+    return -1;
+}
+
+// --- Queries ---
+// Rows whose email is exactly email; returns how many, storing up to max
+size_t engineFindEmail(const PayrollEngine *e, const char *email, uint32_t *rows, size_t max) {
+    const PayrollStore *s = e->s;
+    size_t len = strlen(email), found = 0;
+    uint32_t h = hashBytes(email, len) & e->emailMask;
+    for (; e->emailSlots[h]; h = (h + 1) & e->emailMask) {
+        uint32_t i = e->emailSlots[h] - 1;
+        if (poolLen(&s->strings, s->email[i]) != len ||
+            memcmp(poolGet(&s->strings, s->email[i]), email, len) != 0) continue;
+        if (found < max) rows[found] = i;
+        found++;
+    }
+    return found;
+}
+
+// Sums over salaries in [lo, hi]. Bands that lie wholly inside the range
+// come from their running sums. For the two edge bands, found through the
+// salary order, whichever is smaller is visited: the rows inside the range,
+// or the band's rows outside it (subtracted from the band sums). *first is
+// where the range starts in salary order.
+PayrollBand engineRange(const PayrollEngine *e, double lo, double hi, size_t *first) {
+    const PayrollStore *s = e->s;
+    PayrollBand r = { 0, 0, 0, 0, 0 };
+    size_t p0 = salaryLowerBound(e, lo), p1 = salaryUpperBound(e, hi);
+    *first = p0;
+    if (p0 >= p1) return r;
+    int bLo = salaryBand(lo), bHi = salaryBand(hi);
+    for (int b = bLo; b <= bHi; b++) {
+        if (b == bLo || b == bHi) {
+            size_t start = b == 0 ? 0 : salaryLowerBound(e, BAND_LOWER[b]);
+            size_t end = b + 1 == BAND_COUNT ? s->n : salaryLowerBound(e, BAND_LOWER[b + 1]);
+            size_t from = start > p0 ? start : p0, to = end < p1 ? end : p1;
+            if (from >= to) continue;
+            if (from > start || to < end) {
+                if ((to - from) * 2 <= end - start) {
+                    for (size_t p = from; p < to; p++) bandAdd(&r, s, e->bySalary[p], 1);
+                    continue;
+                }
+                for (size_t p = start; p < from; p++) bandAdd(&r, s, e->bySalary[p], -1);
+                for (size_t p = to; p < end; p++) bandAdd(&r, s, e->bySalary[p], -1);
+            }
+        }
+        r.count += e->band[b].count;
+        r.salary += e->band[b].salary;
+        r.tax += e->band[b].tax;
+        r.totalTax += e->band[b].totalTax;
+        r.net += e->band[b].net;
+    }
+    return r;
+}
+
+static void heapDown(uint32_t *heap, size_t n, size_t i, const double *key) {
+    for (;;) {
+        size_t c = 2 * i + 1;
+        if (c >= n) return;
+        if (c + 1 < n && key[heap[c + 1]] < key[heap[c]]) c++;
+        if (key[heap[c]] >= key[heap[i]]) return;
+        uint32_t t = heap[c]; heap[c] = heap[i]; heap[i] = t;
+        i = c;
+    }
+}
+
+// How much salary - tax(salary) can rise as the salary falls. Rates are at
+// most 1, so within a bracket it never does; only a base given explicitly
+// above the bracket below's tax at that bound makes it step down there.
+// Derived bases are rounded to cents, so allow a little for that too.
+static double taxStepSlack(const TaxTable *t) {
+    double slack = 0.01;
+    for (int k = 1; k < t->count; k++) {
+        double step = t->base[k] - (t->base[k - 1] + (t->lower[k] - t->lower[k - 1]) * t->rate[k - 1]);
+        if (step > 0) slack += step;
+    }
+    return slack / 12;
+}
+
+// The k highest net pays, best first; returns how many were found. With
+// deductions never negative, net pay is at most salary - tax(salary), and no
+// lower salary can beat that by more than taxStepSlack(). Rows are taken
+// from the top of the salary order until that bound falls below the k-th
+// best net pay seen. *visited reports how many rows that took.
+size_t engineTopNet(const PayrollEngine *e, size_t k, uint32_t *out, size_t *visited) {
+    const PayrollStore *s = e->s;
+    size_t n = 0, p = s->n;
+    double slack = taxStepSlack(&e->table);
+    while (p > 0) {
+        double salary = e->sortedSalary[p - 1];
+        if (n == k && salary - taxFromTable(&e->table, salary) + slack < s->netPay[out[0]]) break;
+        uint32_t i = e->bySalary[--p];
+        if (n < k) {
+            out[n++] = i;
+            for (size_t j = n - 1; j > 0 && s->netPay[out[(j - 1) / 2]] > s->netPay[out[j]]; j = (j - 1) / 2) {
+                uint32_t t = out[j]; out[j] = out[(j - 1) / 2]; out[(j - 1) / 2] = t;
+            }
+        } else if (s->netPay[i] > s->netPay[out[0]]) {
+            out[0] = i;
+            heapDown(out, n, 0, s->netPay);
+        }
+    }
+    *visited = s->n - p;
+    for (size_t m = n; m > 1; m--) {        // heap sort: smallest to the back
+        uint32_t t = out[0]; out[0] = out[m - 1]; out[m - 1] = t;
+        heapDown(out, m - 1, 0, s->netPay);
+    }
+    return n;
+}
+
+// Salary at percentile pct (nearest rank), exact from the salary order
+double engineSalaryPercentile(const PayrollEngine *e, double pct) {
+    if (e->s->n == 0) return 0;
+    return e->sortedSalary[(size_t)(pct / 100 * (e->s->n - 1) + 0.5)];
+}
+
+// Percentile from a histogram, interpolated within its bucket (about 1%)
+static double histPercentile(const uint64_t *hist, size_t n, double pct) {
+    double rank = pct / 100 * (n ? n - 1 : 0);
+    uint64_t below = 0;
+    for (int b = 0; b < HIST_BUCKETS; b++) {
+        if (!hist[b] || below + hist[b] <= rank) {
+            below += hist[b];
+            continue;
+        }
+        double lo = histLower(b), hi = histLower(b + 1);
+        return lo + (hi - lo) * (rank - below + 0.5) / hist[b];
+    }
+    return 0;
+}
+
+// --- Engine Mode ---
+static void printEngineTotals(const PayrollTotals *t) {
+    printf(" Gross %.2f  Base tax %.2f  Deductions %.2f  Total tax %.2f  Net %.2f\n",
+           t->gross, t->baseTax, t->deductions, t->totalTax, t->net);
+}
+
+static void printEngineRow(const PayrollEngine *e, uint32_t i) {
+    const PayrollStore *s = e->s;
+    printf(" #%u %s <%s> age %d: salary %.2f, tax %.2f, total tax %.2f, net %.2f\n", i,
+           poolGet(&s->strings, s->name[i]), poolGet(&s->strings, s->email[i]), s->age[i],
+           s->salary[i], s->tax[i], s->totalTax[i], s->netPay[i]);
+    for (uint32_t k = s->dedStart[i]; k < s->dedStart[i + 1]; k++) {
+        printf("    %s: %.2f (entered %.2f)\n", poolGet(&s->strings, s->dedLabel[k]),
+               s->dedAmount[k], e->entered[k]);
+    }
+}
+
+// Full rerun into the store, compared bit for bit with the incremental
+// results; the totals are then reset to the full run's sums
+static void engineVerify(PayrollEngine *e) {
+    PayrollStore *s = e->s;
+    size_t n = s->n, bad = 0;
+    double *tax = xrealloc(NULL, sizeof(double) * n);
+    double *total = xrealloc(NULL, sizeof(double) * n);
+    double *net = xrealloc(NULL, sizeof(double) * n);
+    memcpy(tax, s->tax, sizeof(double) * n);
+    memcpy(total, s->totalTax, sizeof(double) * n);
+    memcpy(net, s->netPay, sizeof(double) * n);
+    double t0 = nowSeconds();
+    PayrollTotals full = payrollCompute(s, e->threads);
+    double t1 = nowSeconds();
+    for (size_t i = 0; i < n; i++) {
+        bad += memcmp(&tax[i], &s->tax[i], sizeof(double)) != 0 ||
+               memcmp(&total[i], &s->totalTax[i], sizeof(double)) != 0 ||
+               memcmp(&net[i], &s->netPay[i], sizeof(double)) != 0;
+    }
+    printf(" Full rerun: %.3f ms, %zu row mismatches\n", (t1 - t0) * 1e3, bad);
+    printf(" Total drift: gross %.2g, tax %.2g, net %.2g\n", e->totals.gross - full.gross,
+           e->totals.totalTax - full.totalTax, e->totals.net - full.net);
+    e->totals = full;
+    indexRebuild(e);
+    free(tax); free(total); free(net);
+}
+
+static const char *ENGINE_HELP =
+    " table <jurisdiction> <year>        switch to another configured table\n"
+    " bracket <k> <lower>:<rate>[:<base>] edit or append bracket k; later bases are re-derived\n"
+    " rule <label> fixed <amount>         same amount for every entry of the label\n"
+    " rule <label> rate <r> [min] [max]   salary * r, clamped to [min, max]\n"
+    " rule <label> entered                back to the amounts in the file\n"
+    " salary <row> <amount>               correct one salary\n"
+    " deduct <row> <label> <amount>       correct one entered deduction\n"
+    " find <email>                        rows with that email\n"
+    " range <lo> <hi> [rows]              sums over salaries in [lo, hi], first rows listed\n"
+    " top <k>                             highest net pays\n"
+    " group [<lo> <hi>]                   deductions per label, optionally for a salary range\n"
+    " pct                                 salary (exact), tax and net pay (~1%) percentiles\n"
+    " bands                               salary band histogram\n"
+    " show <row> | totals | verify | help | quit\n";
+
+// A command's numeric arguments are whole tokens, parsed as the CSV fields
+// are; a bad one is reported and the command leaves the engine unchanged
+static int commandAmount(const char *text, int allowZero, double *out) {
+    if (!parseAmount(text, strlen(text), out) || *out - *out != 0 || *out < 0 || (*out == 0 && !allowZero)) {
+        printf(" Bad amount '%s'\n", text);
+        return 0;
+    }
+    return 1;
+}
+
+static int commandRow(const PayrollStore *s, const char *text, uint32_t *row) {
+    int v;
+    if (!parseInt(text, strlen(text), &v) || (size_t)v >= s->n) {
+        printf(" No row '%s' (%zu rows, numbered from 0)\n", text, s->n);
+        return 0;
+    }
+    *row = (uint32_t)v;
+    return 1;
+}
+
+static void printRangeLine(const char *what, const PayrollBand *b) {
+    printf(" %-22s %9zu  avg salary %12.2f  avg net %12.2f  total tax %16.2f\n", what, b->count,
+           b->count ? b->salary / b->count : 0, b->count ? b->net / b->count : 0, b->totalTax);
+}
+
+// Deduction sums per label over every row, or over salaries in [lo, hi]
+static void printGroups(const PayrollEngine *e, int ranged, double lo, double hi) {
+    const PayrollStore *s = e->s;
+    size_t *count = calloc((size_t)e->labelCount + 1, sizeof(size_t));
+    double *sum = calloc((size_t)e->labelCount + 1, sizeof(double));
+    if (!count || !sum) {
+        free(count); free(sum);
+        return;
+    }
+    if (ranged) {
+        size_t p1 = salaryUpperBound(e, hi);
+        for (size_t p = salaryLowerBound(e, lo); p < p1; p++) {
+            uint32_t i = e->bySalary[p];
+            for (uint32_t k = s->dedStart[i]; k < s->dedStart[i + 1]; k++) {
+                count[e->entryLabel[k]]++;
+                sum[e->entryLabel[k]] += s->dedAmount[k];
+            }
+        }
+    } else {
+        for (uint32_t d = 0; d < e->labelCount; d++) {
+            count[d] = e->labelStart[d + 1] - e->labelStart[d];
+            sum[d] = e->labelSum[d];
+        }
+    }
+    for (uint32_t d = 0; d < e->labelCount; d++) {
+        if (!count[d]) continue;
+        printf(" %-20s %9zu entries  total %16.2f  avg %10.2f\n", poolGet(&s->strings, e->labelId[d]),
+               count[d], sum[d], sum[d] / count[d]);
+    }
+    free(count);
+    free(sum);
+}
+
+// --engine: load, compute once, then apply change commands read from stdin
+int runEngine(const char *path, int threads, const TaxTable *table, const TaxTables *tables) {
+    PayrollStore s;
+    PayrollEngine e;
+    storeInit(&s);
+    double t0 = nowSeconds();
+    long bad = ingestFile(&s, path);
+    if (bad < 0) {
+        printf("Cannot read %s\n", path);
+        storeFree(&s);
+        return 1;
+    }
+    double t1 = nowSeconds();
+    engineBuild(&e, &s, table, threads);
+    double t2 = nowSeconds();
+    printf(" %zu employees, %zu deductions, %u labels; ingest %.3f s, compute and index %.3f s\n",
+           s.n, s.dedCount, e.labelCount, t1 - t0, t2 - t1);
+    printEngineTotals(&e.totals);
+
+    char line[512];
+    while (fgets(line, sizeof(line), stdin)) {
+        char cmd[32] = "", a[128] = "", b[128] = "", c[64] = "", d[64] = "", f[64] = "";
+        int args = sscanf(line, "%31s %127s %127s %63s %63s %63s", cmd, a, b, c, d, f);
+        if (args < 1 || cmd[0] == '#') continue;
+        double start = nowSeconds();
+        int changed = 1, timed = 0;
+        if (strcmp(cmd, "quit") == 0 || strcmp(cmd, "exit") == 0) {
+            break;
+        } else if (strcmp(cmd, "help") == 0) {
+            printf("%s", ENGINE_HELP);
+            changed = 0;
+        } else if (strcmp(cmd, "totals") == 0) {
+            printEngineTotals(&e.totals);
+            changed = 0;
+        } else if (strcmp(cmd, "verify") == 0) {
+            engineVerify(&e);
+            changed = 0;
+        } else if (strcmp(cmd, "show") == 0 && args >= 2) {
+            uint32_t row;
+            if (!commandRow(&s, a, &row)) continue;
+            printEngineRow(&e, row);
+            changed = 0;
+        } else if (strcmp(cmd, "find") == 0 && args >= 2) {
+            uint32_t rows[8];
+            size_t found = engineFindEmail(&e, a, rows, 8);
+            for (size_t j = 0; j < found && j < 8; j++) printEngineRow(&e, rows[j]);
+            if (!found) printf(" No employee with email %s\n", a);
+            else if (found > 8) printf(" ... %zu rows in all\n", found);
+            changed = 0;
+            timed = 1;
+        } else if (strcmp(cmd, "range") == 0 && args >= 3) {
+            double lo, hi;
+            int limit = 0;
+            size_t first;
+            if (!commandAmount(a, 1, &lo) || !commandAmount(b, 1, &hi)) continue;
+            if (args >= 4 && !parseInt(c, strlen(c), &limit)) {
+                printf(" Bad row count '%s'\n", c);
+                continue;
+            }
+            PayrollBand r = engineRange(&e, lo, hi, &first);
+            printRangeLine("Salaries in range", &r);
+            for (size_t j = 0; j < (size_t)limit && j < r.count; j++) printEngineRow(&e, e.bySalary[first + j]);
+            changed = 0;
+            timed = 1;
+        } else if (strcmp(cmd, "top") == 0 && args >= 2) {
+            int count;
+            if (!parseInt(a, strlen(a), &count) || count < 1) {
+                printf(" Bad count '%s'\n", a);
+                continue;
+            }
+            size_t k = (size_t)count, visited;
+            uint32_t *rows = xrealloc(NULL, sizeof(uint32_t) * k);
+            size_t found = engineTopNet(&e, k, rows, &visited);
+            for (size_t j = 0; j < found; j++) {
+                printf(" %3zu. net %12.2f  salary %12.2f  %s <%s>\n", j + 1, s.netPay[rows[j]],
+                       s.salary[rows[j]], poolGet(&s.strings, s.name[rows[j]]),
+                       poolGet(&s.strings, s.email[rows[j]]));
+            }
+            printf(" (%zu rows visited)\n", visited);
+            free(rows);
+            changed = 0;
+            timed = 1;
+        } else if (strcmp(cmd, "group") == 0 && args != 2) {
+            double lo = 0, hi = 0;
+            if (args >= 3 && (!commandAmount(a, 1, &lo) || !commandAmount(b, 1, &hi))) continue;
+            printGroups(&e, args >= 3, lo, hi);
+            changed = 0;
+            timed = 1;
+        } else if (strcmp(cmd, "pct") == 0) {
+            static const double PCT[] = { 1, 10, 25, 50, 75, 90, 99 };
+            printf(" %-6s %14s %14s %14s\n", "pct", "salary", "tax", "net pay");
+            for (int j = 0; j < 7; j++) {
+                printf(" p%-5g %14.2f %14.2f %14.2f\n", PCT[j], engineSalaryPercentile(&e, PCT[j]),
+                       histPercentile(e.taxHist, s.n, PCT[j]), histPercentile(e.netHist, s.n, PCT[j]));
+            }
+            changed = 0;
+            timed = 1;
+        } else if (strcmp(cmd, "bands") == 0) {
+            for (int b = 0; b < BAND_COUNT; b++) {
+                char what[64];
+                if (!e.band[b].count) continue;
+                if (b == 0) snprintf(what, sizeof(what), "below %.0f", BAND_LOWER[1]);
+                else if (b + 1 == BAND_COUNT) snprintf(what, sizeof(what), "%.0f and up", BAND_LOWER[b]);
+                else snprintf(what, sizeof(what), "%.0f - %.0f", BAND_LOWER[b], BAND_LOWER[b + 1]);
+                printRangeLine(what, &e.band[b]);
+            }
+            changed = 0;
+            timed = 1;
+        } else if (strcmp(cmd, "table") == 0 && args >= 3) {
+            const TaxTable *t = findTaxTable(tables, a, atoi(b));
+            if (!t) {
+                printf(" No tax table for %s %s\n", a, b);
+                continue;
+            }
+            engineSetTable(&e, t);
+        } else if (strcmp(cmd, "bracket") == 0 && args >= 3) {
+            TaxTable t = e.table;
+            int k = atoi(a);
+            double lower, rate, base;
+            int fields = sscanf(b, "%lf:%lf:%lf", &lower, &rate, &base);
+            if (fields < 2 || k < 0 || k > t.count || k >= MAX_BRACKETS || rate < 0 || rate > 1 ||
+                (k == 0 && lower != 0) || (k > 0 && lower <= t.lower[k - 1]) ||
+                (k + 1 < t.count && lower >= t.lower[k + 1])) {
+                printf(" Bad bracket '%s'\n", b);
+                continue;
+            }
+            if (k == t.count) t.count++;
+            t.lower[k] = lower;
+            t.rate[k] = rate;
+            t.monthly[k] = lower / 12;
+            t.base[k] = fields == 3 ? base
+                      : k == 0 ? 0.0
+                      : roundCents(t.base[k - 1] + (lower - t.lower[k - 1]) * t.rate[k - 1]);
+            for (int j = k + 1; j < t.count; j++) {
+                t.base[j] = roundCents(t.base[j - 1] + (t.lower[j] - t.lower[j - 1]) * t.rate[j - 1]);
+            }
+            engineSetTable(&e, &t);
+        } else if (strcmp(cmd, "rule") == 0 && args >= 3) {
+            DeductionRule r = { RULE_ENTERED, 0, 0, 0 };
+            if (strcmp(b, "fixed") == 0 && args >= 4) {
+                r.kind = RULE_FIXED;
+                if (!commandAmount(c, 0, &r.value)) continue;
+            } else if (strcmp(b, "rate") == 0 && args >= 4) {
+                r.kind = RULE_RATE;
+                if (!commandAmount(c, 0, &r.value) || (args >= 5 && !commandAmount(d, 1, &r.min)) ||
+                    (args >= 6 && !commandAmount(f, 1, &r.max))) {
+                    continue;
+                }
+                if (r.value > 1 || (r.max > 0 && r.max < r.min)) {
+                    printf(" Bad rate rule (rate up to 1, max 0 or at least min)\n");
+                    continue;
+                }
+            } else if (strcmp(b, "entered") != 0) {
+                printf(" Unknown rule '%s'\n", b);
+                continue;
+            }
+            uint32_t label = poolFind(&s.strings, a, strlen(a));
+            if (label == UINT32_MAX || engineSetRule(&e, label, &r) != 0) {
+                printf(" No deductions labelled %s\n", a);
+                continue;
+            }
+        } else if (strcmp(cmd, "salary") == 0 && args >= 3) {
+            uint32_t row;
+            double amount;
+            if (!commandRow(&s, a, &row) || !commandAmount(b, 0, &amount)) continue;
+            engineSetSalary(&e, row, amount);
+        } else if (strcmp(cmd, "deduct") == 0 && args >= 4) {
+            uint32_t row, label = poolFind(&s.strings, b, strlen(b));
+            double amount;
+            if (!commandRow(&s, a, &row) || !commandAmount(c, 0, &amount)) continue;
+            if (label == UINT32_MAX || engineSetDeduction(&e, row, label, amount) != 0) {
+                printf(" Row %s has no %s deduction\n", a, b);
+                continue;
+            }
+        } else {
+            printf(" Unknown or incomplete command (try help)\n");
+            continue;
+        }
+        if (changed) {
+            printf(" %zu rows recomputed in %.3f ms\n", e.touched, (nowSeconds() - start) * 1e3);
+            printEngineTotals(&e.totals);
+        } else if (timed) {
+            printf(" answered in %.3f ms\n", (nowSeconds() - start) * 1e3);
+        }
+    }
+    engineFree(&e);
+    storeFree(&s);
+    return 0;
+}
+
+// ------------------ Year-to-date ledger ------------------
+// Each posted payroll run is appended to a ledger file as one immutable
+// segment keyed by its period (yyyymm); periods only move forward. A
+// segment holds every employee seen so far in its year, in first-seen
+// order, with this period's amounts and the running sums since January:
+//   LedgerHeader                 period, row counts, period and YTD totals
+//   f64 month[4][rows]           gross, base tax, deductions, net pay
+//   f64 ytd[4][rows]             the same, summed over the year so far
+//   u32 key[rows]                offset of the employee's email in text
+//   u32 slot[slotCount]          open addressing: hash of email -> row + 1
+//   text, padded to 8 bytes
+// Posting a month reads only the previous segment's YTD columns, so the
+// December segment already holds the year: reconciliation and per-period
+// queries read one segment, or only headers, never every month's rows.
+enum { LEDGER_GROSS, LEDGER_TAX, LEDGER_DEDUCTIONS, LEDGER_NET, LEDGER_COLUMNS };
+
+static const char *LEDGER_COLUMN_NAMES[LEDGER_COLUMNS] = { "Gross", "Base tax", "Deductions", "Net pay" };
+
+typedef struct {
+    char magic[8];              // "PAYSEG01"
+    int32_t period;             // yyyymm
+    int32_t reserved;
+    uint64_t rows;              // employees seen this year up to this period
+    uint64_t present;           // of which were paid this period
+    uint64_t slotCount;         // a power of two
+    uint64_t textBytes;
+    uint64_t bytes;             // whole segment, header included
+    double month[LEDGER_COLUMNS];
+    double ytd[LEDGER_COLUMNS];
+} LedgerHeader;
+
+// A segment's columns, pointing into the mapped ledger
+typedef struct {
+    const LedgerHeader *h;
+    const double *month[LEDGER_COLUMNS];
+    const double *ytd[LEDGER_COLUMNS];
+    const uint32_t *key, *slot;
+    const char *text;
+} LedgerSegment;
+
+typedef struct {
+    char *data;
+    size_t size;
+    int mapped;
+} LedgerFile;
+
+static size_t ledgerSegmentBytes(uint64_t rows, uint64_t slots, uint64_t text) {
+    size_t bytes = sizeof(LedgerHeader) + rows * 2 * LEDGER_COLUMNS * sizeof(double) +
+                   (rows + slots) * sizeof(uint32_t) + text;
+    return (bytes + 7) & ~(size_t)7;
+}
+
+// "2024-03", "2024-3" or "202403" as 202403; 0 if it is not a valid month
+// (nothing may follow the month)
+int parsePeriod(const char *s) {
+    int year = 0, month = 0, i, digits = 0;
+    for (i = 0; i < 4; i++) {
+        if (s[i] < '0' || s[i] > '9') return 0;
+        year = year * 10 + (s[i] - '0');
+    }
+    int dash = s[i] == '-';
+    i += dash;
+    for (; s[i] >= '0' && s[i] <= '9' && digits < 2; i++, digits++) month = month * 10 + (s[i] - '0');
+    if (s[i] != '\0' || digits == 0 || (!dash && digits != 2)) return 0;
+    if (year >= 1900 && month >= 1 && month <= 12) return year * 100 + month;
+    return 0;
+}
+
+// Map a ledger (a missing file is an empty ledger); returns -1 on error
+int ledgerOpen(LedgerFile *f, const char *path) {
+    memset(f, 0, sizeof(*f));
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return -1;
+    }
+    f->size = (size_t)st.st_size;
+    if (f->size > 0) {
+        f->data = mmap(NULL, f->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (f->data == MAP_FAILED) {
+            close(fd);
+            return -1;
+        }
+        f->mapped = 1;
+    }
+    close(fd);
+#else
+    FILE *in = fopen(path, "rb");
+    if (!in) return 0;
+    size_t cap = 1 << 20, got;
+    f->data = xrealloc(NULL, cap);
+    while ((got = fread(f->data + f->size, 1, cap - f->size, in)) > 0) {
+        f->size += got;
+        if (f->size == cap) f->data = xrealloc(f->data, cap *= 2);
+    }
+    fclose(in);
+#endif
+    return 0;
+}
+
+void ledgerClose(LedgerFile *f) {
+#ifndef _WIN32
+    if (f->mapped) munmap(f->data, f->size);
+    else free(f->data);
+#else
+    free(f->data);
+#endif
+    memset(f, 0, sizeof(*f));
+}
+
+// Segment at byte offset *pos, advancing *pos past it; 0 at the end, -1 if
+// the ledger is damaged. Every header field is checked against the bytes
+// left before it is used to place a column; row contents (keys, slots) are
+// checked where they are followed: ledgerFind() and ledgerCheckKeys().
+int ledgerNext(const LedgerFile *f, size_t *pos, LedgerSegment *seg) {
+    if (*pos >= f->size) return 0;
+    size_t left = f->size - *pos;
+    const LedgerHeader *h = (const LedgerHeader *)(f->data + *pos);
+    if (left < sizeof(LedgerHeader) || memcmp(h->magic, "PAYSEG01", 8) != 0) return -1;
+    // Bound each count by the bytes left first, so the size sum cannot overflow
+    if (h->rows > UINT32_MAX - 1 || h->rows > left / (2 * LEDGER_COLUMNS * sizeof(double)) ||
+        h->slotCount > left / sizeof(uint32_t) || h->textBytes > left || h->present > h->rows) {
+        return -1;
+    }
+    if (h->slotCount <= h->rows || (h->slotCount & (h->slotCount - 1)) != 0 ||
+        h->period % 100 < 1 || h->period % 100 > 12 ||
+        h->bytes != ledgerSegmentBytes(h->rows, h->slotCount, h->textBytes) || h->bytes > left) {
+        return -1;
+    }
+    const char *p = (const char *)(h + 1);
+    seg->h = h;
+    for (int c = 0; c < LEDGER_COLUMNS; c++, p += h->rows * sizeof(double)) seg->month[c] = (const double *)p;
+    for (int c = 0; c < LEDGER_COLUMNS; c++, p += h->rows * sizeof(double)) seg->ytd[c] = (const double *)p;
+    seg->key = (const uint32_t *)p;
+    seg->slot = seg->key + h->rows;
+    seg->text = (const char *)(seg->slot + h->slotCount);
+    if (h->textBytes ? seg->text[h->textBytes - 1] != '\0' : h->rows != 0) return -1;
+    *pos += h->bytes;
+    return 1;
+}
+
+// 1 if every key points inside the segment's text (which ledgerNext()
+// found to end in a '\0'), so the emails can be read as strings
+int ledgerCheckKeys(const LedgerSegment *seg) {
+    for (uint64_t i = 0; i < seg->h->rows; i++) {
+        if (seg->key[i] >= seg->h->textBytes) return 0;
+    }
+    return 1;
+}
+
+// Row of email in a segment, or -1 (also for a damaged slot)
+long ledgerFind(const LedgerSegment *seg, const char *email) {
+    size_t len = strlen(email);
+    uint64_t mask = seg->h->slotCount - 1, h = hashBytes(email, len) & mask;
+    for (uint64_t probes = 0; seg->slot[h] && probes <= mask; h = (h + 1) & mask, probes++) {
+        uint32_t row = seg->slot[h] - 1;
+        if (row >= seg->h->rows || seg->key[row] >= seg->h->textBytes) return -1;
+        if (strcmp(seg->text + seg->key[row], email) == 0) return row;
+    }
+    return -1;
+}
+
+// A segment being built in memory
+typedef struct {
+    LedgerHeader h;
+    double *month[LEDGER_COLUMNS], *ytd[LEDGER_COLUMNS];
+    uint32_t *key, *slot;
+    char *text;
+    size_t cap, textCap;
+} LedgerBuild;
+
+static uint32_t buildRow(LedgerBuild *b, const char *email, size_t len) {
+    uint64_t mask = b->h.slotCount - 1, h = hashBytes(email, len) & mask;
+    for (; b->slot[h]; h = (h + 1) & mask) {
+        uint32_t row = b->slot[h] - 1;
+        const char *k = b->text + b->key[row];
+        if (strncmp(k, email, len) == 0 && k[len] == '\0') return row;
+    }
+    uint32_t row = (uint32_t)b->h.rows++;
+    if (b->h.textBytes + len + 1 > b->textCap) {
+        b->textCap = (b->textCap ? b->textCap * 2 : 1 << 16) + len;
+        b->text = xrealloc(b->text, b->textCap);
+    }
+    memcpy(b->text + b->h.textBytes, email, len);
+    b->text[b->h.textBytes + len] = '\0';
+    b->key[row] = (uint32_t)b->h.textBytes;
+    b->h.textBytes += len + 1;
+    for (int c = 0; c < LEDGER_COLUMNS; c++) b->month[c][row] = b->ytd[c][row] = 0;
+    b->slot[h] = row + 1;
+    return row;
+}
+
+// Refill the first `slots` entries of the table from the rows' keys
+static void rehashLedgerBuild(LedgerBuild *b, uint64_t slots) {
+    memset(b->slot, 0, sizeof(uint32_t) * slots);
+    for (size_t i = 0; i < b->h.rows; i++) {
+        const char *k = b->text + b->key[i];
+        uint64_t h = hashBytes(k, strlen(k)) & (slots - 1);
+        while (b->slot[h]) h = (h + 1) & (slots - 1);
+        b->slot[h] = (uint32_t)i + 1;
+    }
+    b->h.slotCount = slots;
+}
+
+static int writeLedgerSegment(FILE *out, const LedgerBuild *b) {
+    static const char zeros[8] = { 0 };
+    size_t rows = b->h.rows;
+    int ok = fwrite(&b->h, sizeof(b->h), 1, out) == 1;
+    for (int c = 0; ok && c < LEDGER_COLUMNS; c++) ok = writeColumn(out, b->month[c], rows * sizeof(double));
+    for (int c = 0; ok && c < LEDGER_COLUMNS; c++) ok = writeColumn(out, b->ytd[c], rows * sizeof(double));
+    ok = ok && writeColumn(out, b->key, rows * sizeof(uint32_t)) &&
+         writeColumn(out, b->slot, b->h.slotCount * sizeof(uint32_t)) &&
+         writeColumn(out, b->text, b->h.textBytes);
+    size_t used = sizeof(LedgerHeader) + rows * 2 * LEDGER_COLUMNS * sizeof(double) +
+                  (rows + b->h.slotCount) * sizeof(uint32_t) + b->h.textBytes;
+    return ok && writeColumn(out, zeros, b->h.bytes - used);
+}
+
+// --post: compute a CSV for a period and append it to the ledger
+int runPost(const char *csv, const char *periodText, const char *path, const TaxTables *tables,
+            const char *jurisdiction, int threads) {
+    int period = parsePeriod(periodText);
+    if (!period) {
+        printf("Bad period %s (use YYYY-MM)\n", periodText);
+        return 1;
+    }
+    const TaxTable *table = findTaxTable(tables, jurisdiction, period / 100);
+    if (!table) {
+        printf("No tax table for %s %d\n", jurisdiction, period / 100);
+        return 1;
+    }
+    LedgerFile f;
+    LedgerSegment seg, last = { NULL };
+    size_t pos = 0;
+    int rc, segments = 0;
+    if (ledgerOpen(&f, path) != 0) {
+        printf("Cannot read %s\n", path);
+        return 1;
+    }
+    while ((rc = ledgerNext(&f, &pos, &seg)) > 0) {
+        last = seg;
+        segments++;
+    }
+    if (rc < 0) {
+        printf("%s: damaged segment at byte %zu\n", path, pos);
+        ledgerClose(&f);
+        return 1;
+    }
+    if (segments && last.h->period / 100 == period / 100 && !ledgerCheckKeys(&last)) {
+        printf("%s: damaged segment for %d-%02d\n", path, last.h->period / 100, last.h->period % 100);
+        ledgerClose(&f);
+        return 1;
+    }
+    if (segments && last.h->period >= period) {
+        printf("%s already has period %d; runs are appended in order\n", path, last.h->period);
+        ledgerClose(&f);
+        return 1;
+    }
+
+    double t0 = nowSeconds();
+    PayrollStore s;
+    storeInit(&s);
+    s.taxTable = table;
+    long bad = ingestFile(&s, csv);
+    if (bad < 0) {
+        printf("Cannot read %s\n", csv);
+        storeFree(&s);
+        ledgerClose(&f);
+        return 1;
+    }
+    payrollCompute(&s, threads);
+    double t1 = nowSeconds();
+
+    // Start from the previous segment of the same year, then add this run
+    const LedgerSegment *prev = segments && last.h->period / 100 == period / 100 ? &last : NULL;
+    size_t prevRows = prev ? prev->h->rows : 0;
+    LedgerBuild b;
+    memset(&b, 0, sizeof(b));
+    memcpy(b.h.magic, "PAYSEG01", 8);
+    b.h.period = period;
+    b.cap = prevRows + s.n;
+    b.h.slotCount = 16;
+    while (b.h.slotCount < b.cap * 2) b.h.slotCount *= 2;
+    for (int c = 0; c < LEDGER_COLUMNS; c++) {
+        b.month[c] = xrealloc(NULL, sizeof(double) * b.cap);
+        b.ytd[c] = xrealloc(NULL, sizeof(double) * b.cap);
+    }
+    b.key = xrealloc(NULL, sizeof(uint32_t) * b.cap);
+    b.slot = calloc(b.h.slotCount, sizeof(uint32_t));
+    if (!b.slot) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    if (prev) {
+        b.textCap = prev->h->textBytes + 1;
+        b.text = xrealloc(NULL, b.textCap);
+        memcpy(b.text, prev->text, prev->h->textBytes);
+        b.h.textBytes = prev->h->textBytes;
+        memcpy(b.key, prev->key, sizeof(uint32_t) * prevRows);
+        for (int c = 0; c < LEDGER_COLUMNS; c++) {
+            memcpy(b.ytd[c], prev->ytd[c], sizeof(double) * prevRows);
+            memset(b.month[c], 0, sizeof(double) * prevRows);
+        }
+        b.h.rows = prevRows;
+        rehashLedgerBuild(&b, b.h.slotCount);
+    }
+    for (size_t i = 0; i < s.n; i++) {
+        uint32_t row = buildRow(&b, poolGet(&s.strings, s.email[i]), poolLen(&s.strings, s.email[i]));
+        b.month[LEDGER_GROSS][row] += s.salary[i];
+        b.month[LEDGER_TAX][row] += s.tax[i];
+        b.month[LEDGER_DEDUCTIONS][row] += s.totalTax[i] - s.tax[i];
+        b.month[LEDGER_NET][row] += s.netPay[i];
+    }
+    for (int c = 0; c < LEDGER_COLUMNS; c++) {
+        double month = 0, ytd = 0;
+        for (size_t i = 0; i < b.h.rows; i++) {
+            b.ytd[c][i] += b.month[c][i];
+            month += b.month[c][i];
+            ytd += b.ytd[c][i];
+        }
+        b.h.month[c] = month;
+        b.h.ytd[c] = ytd;
+    }
+    for (size_t i = 0; i < b.h.rows; i++) b.h.present += b.month[LEDGER_GROSS][i] != 0;
+
+    // The table was sized for every row being new; shrink it when most
+    // employees carried over so segments do not grow month after month
+    uint64_t slots = 16;
+    while (slots < b.h.rows * 2) slots *= 2;
+    if (slots < b.h.slotCount) rehashLedgerBuild(&b, slots);
+    b.h.bytes = ledgerSegmentBytes(b.h.rows, b.h.slotCount, b.h.textBytes);
+    ledgerClose(&f);
+
+    FILE *out = fopen(path, "ab");
+    int ok = out != NULL;
+    if (ok) {
+        setvbuf(out, NULL, _IONBF, 0);
+        ok = writeLedgerSegment(out, &b);
+        ok = fclose(out) == 0 && ok;
+    }
+    double t2 = nowSeconds();
+    if (!ok) printf("Error appending to %s\n", path);
+    else {
+        printf(" Posted %d-%02d to %s: %zu paid, %llu on the year's roll (%ld bad rows)\n",
+               period / 100, period % 100, path, s.n, (unsigned long long)b.h.rows, bad);
+        printf(" Period gross %.2f, base tax %.2f; YTD gross %.2f, base tax %.2f\n",
+               b.h.month[LEDGER_GROSS], b.h.month[LEDGER_TAX], b.h.ytd[LEDGER_GROSS], b.h.ytd[LEDGER_TAX]);
+        printf(" Compute %.3f s, YTD update and append %.3f s\n", t1 - t0, t2 - t1);
+    }
+    for (int c = 0; c < LEDGER_COLUMNS; c++) {
+        free(b.month[c]);
+        free(b.ytd[c]);
+    }
+    free(b.key); free(b.slot); free(b.text);
+    storeFree(&s);
+    return ok ? 0 : 1;
+}
+
+// --ledger: period totals from segment headers, or one employee's rows
+int runLedger(const char *path, int from, int to, const char *email) {
+    LedgerFile f;
+    LedgerSegment seg;
+    size_t pos = 0;
+    int rc;
+    if (ledgerOpen(&f, path) != 0 || !f.size) {
+        printf("Cannot read %s\n", path);
+        ledgerClose(&f);
+        return 1;
+    }
+    if (email) printf(" %s\n", email);
+    printf(" %-8s %10s", "Period", email ? "" : "Paid");
+    for (int c = 0; c < LEDGER_COLUMNS; c++) printf(" %16s", LEDGER_COLUMN_NAMES[c]);
+    printf(" %16s %16s\n", "YTD gross", "YTD base tax");
+    while ((rc = ledgerNext(&f, &pos, &seg)) > 0) {
+        const LedgerHeader *h = seg.h;
+        if (h->period < from || h->period > to) continue;
+        const double *month = h->month, *ytd = h->ytd;
+        double m[LEDGER_COLUMNS], y[LEDGER_COLUMNS];
+        if (email) {
+            long row = ledgerFind(&seg, email);
+            if (row < 0) continue;
+            for (int c = 0; c < LEDGER_COLUMNS; c++) {
+                m[c] = seg.month[c][row];
+                y[c] = seg.ytd[c][row];
+            }
+            month = m;
+            ytd = y;
+            printf(" %4d-%02d  %10s", h->period / 100, h->period % 100, "");
+        } else {
+            printf(" %4d-%02d  %10llu", h->period / 100, h->period % 100, (unsigned long long)h->present);
+        }
+        for (int c = 0; c < LEDGER_COLUMNS; c++) printf(" %16.2f", month[c]);
+        printf(" %16.2f %16.2f\n", ytd[LEDGER_GROSS], ytd[LEDGER_TAX]);
+    }
+    if (rc < 0) printf(" %s: damaged segment at byte %zu\n", path, pos);
+    ledgerClose(&f);
+    return rc < 0;
+}
+
+// --reconcile: the year's last segment against the tax due on each
+// employee's YTD gross, with the table in force that year. Tax due covers
+// the months posted (the YTD gross spread over them, taxed monthly), so it
+// compares with what was withheld in those months; until all twelve months
+// are posted the result is provisional, lists the missing months and
+// projects the full year.
+int runReconcile(const char *path, int year, const TaxTables *tables, const char *jurisdiction) {
+    const TaxTable *table = findTaxTable(tables, jurisdiction, year);
+    LedgerFile f;
+    LedgerSegment seg, last = { NULL };
+    size_t pos = 0;
+    int rc, months = 0;
+    unsigned posted = 0;            // bit m - 1 set once month m is in the ledger
+    if (!table) {
+        printf("No tax table for %s %d\n", jurisdiction, year);
+        return 1;
+    }
+    if (ledgerOpen(&f, path) != 0) {
+        printf("Cannot read %s\n", path);
+        return 1;
+    }
+    while ((rc = ledgerNext(&f, &pos, &seg)) > 0) {
+        if (seg.h->period / 100 == year) {
+            last = seg;
+            months++;
+            posted |= 1u << (seg.h->period % 100 - 1);
+        }
+    }
+    if (rc < 0 || !months) {
+        printf(rc < 0 ? "%s: damaged segment\n" : "%s: no runs posted for %d\n", path, year);
+        ledgerClose(&f);
+        return 1;
+    }
+    double t0 = nowSeconds();
+    const double *gross = last.ytd[LEDGER_GROSS], *withheld = last.ytd[LEDGER_TAX];
+    double due = 0, refunds = 0, balance = 0;
+    size_t over = 0, under = 0;
+    for (size_t i = 0; i < last.h->rows; i++) {
+        double owed = taxFromTable(table, gross[i] / months) * months;
+        double diff = withheld[i] - owed;
+        due += owed;
+        if (diff > 0.005) { refunds += diff; over++; }
+        else if (diff < -0.005) { balance -= diff; under++; }
+    }
+    double t1 = nowSeconds();
+    printf("\n==============================================\n");
+    int final = posted == 0xfff;
+    printf(" %s %d (%s %d table), through %d-%02d\n", final ? "Reconciliation" : "Provisional reconciliation",
+           year, table->jurisdiction, table->year, last.h->period / 100, last.h->period % 100);
+    printf("==============================================\n");
+    printf(" Months posted    : %d\n", months);
+    if (!final) {
+        static const char *MONTHS[12] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                          "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+        printf(" Months missing   :");
+        for (int m = 0; m < 12; m++) {
+            if (!(posted >> m & 1)) printf(" %s", MONTHS[m]);
+        }
+        printf("\n");
+    }
+    printf(" Employees        : %llu\n", (unsigned long long)last.h->rows);
+    printf(" YTD gross        : %.2f\n", last.h->ytd[LEDGER_GROSS]);
+    printf(" Tax withheld     : %.2f\n", last.h->ytd[LEDGER_TAX]);
+    if (final) {
+        printf(" Annual tax due   : %.2f\n", due);
+    } else {
+        printf(" Tax due to date  : %.2f\n", due);
+        printf(" Projected annual : %.2f (tax due at this rate for 12 months)\n", due * 12 / months);
+    }
+    printf(" Over-withheld    : %.2f (%zu employees)\n", refunds, over);
+    printf(" Under-withheld   : %.2f (%zu employees)\n", balance, under);
+    printf(" Extra deductions : %.2f\n", last.h->ytd[LEDGER_DEDUCTIONS]);
+    printf("----------------------------------------------\n");
+    printf(" Reconcile : %.3f s (one segment of %llu)\n", t1 - t0, (unsigned long long)last.h->rows);
+    printf("==============================================\n");
+    ledgerClose(&f);
+    return 0;
+}
+
+// ------------------ Interactive records ------------------
+// Everything a payroll run enters is bump-allocated from one arena: the
+// Employee records, their name and email text and their deduction lists,
+// each sized to what was typed. Labels are interned so repeats share one
+// string. The run ends with a single arenaFree().
+#define ARENA_BLOCK (64 * 1024)
+
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t used, size;
+    double data[];       // double keeps the payload aligned for records
+} ArenaBlock;
+
+typedef struct {
+    ArenaBlock *head;
+    const char **labels; // intern table, NULL = empty
+    uint32_t labelMask, labelCount;
+} Arena;
+
+void *arenaAlloc(Arena *a, size_t size) {
+    size = (size + 7) & ~(size_t)7;
+    ArenaBlock *b = a->head;
+    if (!b || b->used + size > b->size) {
+        size_t cap = size > ARENA_BLOCK ? size : ARENA_BLOCK;
+        b = xrealloc(NULL, sizeof(ArenaBlock) + cap);
+        b->next = a->head;
+        b->used = 0;
+        b->size = cap;
+        a->head = b;
+    }
+    void *p = (char *)b->data + b->used;
+    b->used += size;
+    return p;
+}
+
+char *arenaString(Arena *a, const char *s, size_t len) {
+    char *p = arenaAlloc(a, len + 1);
+    memcpy(p, s, len);
+    p[len] = '\0';
+    return p;
+}
+
+// The arena's copy of label, shared by every deduction with that label
+const char *arenaIntern(Arena *a, const char *s, size_t len) {
+    if (a->labelCount * 2 >= a->labelMask) {
+        uint32_t mask = a->labelMask ? a->labelMask * 2 + 1 : 63;
+        const char **labels = calloc((size_t)mask + 1, sizeof(char *));
+        if (!labels) {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+        for (uint32_t i = 0; a->labels && i <= a->labelMask; i++) {
+            if (!a->labels[i]) continue;
+            uint32_t h = hashBytes(a->labels[i], strlen(a->labels[i])) & mask;
+            while (labels[h]) h = (h + 1) & mask;
+            labels[h] = a->labels[i];
+        }
+        free(a->labels);
+        a->labels = labels;
+        a->labelMask = mask;
+    }
+    uint32_t h = hashBytes(s, len) & a->labelMask;
+    for (; a->labels[h]; h = (h + 1) & a->labelMask) {
+        if (strncmp(a->labels[h], s, len) == 0 && a->labels[h][len] == '\0') return a->labels[h];
+    }
+    a->labelCount++;
+    return a->labels[h] = arenaString(a, s, len);
+}
+
+void arenaFree(Arena *a) {
+    while (a->head) {
+        ArenaBlock *next = a->head->next;
+        free(a->head);
+        a->head = next;
+    }
+    free(a->labels);
+    memset(a, 0, sizeof(*a));
+}
+
+// Read the rest of a line after skipping leading blanks and newlines (what
+// scanf(" %[^\n]") did, without its fixed-size buffer) into a scratch
+// buffer that grows as needed and is reused; returns the length, or -1 at
+// end of input
+long readLine(char **buf, size_t *cap) {
+    int c;
+    size_t len = 0;
+    while ((c = getchar()) != EOF && (c == ' ' || c == '\t' || c == '\n' || c == '\r')) {}
+    if (c == EOF) return -1;
+    while (c != EOF && c != '\n') {
+        if (len + 1 >= *cap) {
+            *cap = *cap ? *cap * 2 : 128;
+            *buf = xrealloc(*buf, *cap);
+        }
+        (*buf)[len++] = (char)c;
+        c = getchar();
+    }
+    while (len > 0 && ((*buf)[len - 1] == '\r' || (*buf)[len - 1] == ' ')) len--;
+    return (long)len;
+}
+
+int main(int argc, char **argv) {
+    Arena arena = { NULL, NULL, 0, 0 }; // Holds every record of this run
+    Employee *employees = NULL;        // Employees in entry order
+    Employee *last = NULL;
+    char choice = 'n';                 // User choice to add more
+    char *line = NULL;                 // Scratch for typed text
+    size_t lineCap = 0;
+    ExtraTax *extras = NULL;           // Scratch for one employee's deductions
+    int extrasCap = 0;
+
+    if (argc >= 2 && (strcmp(argv[1], "--batch") == 0 || strcmp(argv[1], "--engine") == 0 ||
+                      strcmp(argv[1], "--bench-tax") == 0)) {
+        const char *path = NULL, *config = NULL, *jurisdiction = "PH", *reportPath = NULL;
+        int threads = defaultThreads(), year = 2018, format = REPORT_FIXED;
+        long number = -1;
+        for (int i = 2; i < argc; i++) {
+            if (strcmp(argv[i], "--tax") == 0 && i + 2 < argc) {
+                jurisdiction = argv[i + 1];
+                year = atoi(argv[i + 2]);
+                i += 2;
+            } else if (strcmp(argv[i], "--tax-config") == 0 && i + 1 < argc) {
+                config = argv[++i];
+            } else if (strcmp(argv[i], "--report") == 0 && i + 2 < argc) {
+                if ((format = reportFormatFind(argv[i + 1])) < 0) {
+                    printf("Unknown report format %s (fixed, csv or columns)\n", argv[i + 1]);
+                    return 1;
+                }
+                reportPath = argv[i + 2];
+                i += 2;
+            } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+                if ((threads = atoi(argv[++i])) < 1) {
+                    printf("Bad thread count %s\n", argv[i]);
+                    return 1;
+                }
+            } else if (!path && strcmp(argv[1], "--bench-tax") != 0) {
+                path = argv[i];
+            } else if (number < 0 && strcmp(argv[1], "--bench-tax") == 0) {
+                number = atol(argv[i]);
+            } else {
+                printf("Unexpected argument %s\n", argv[i]);
+                return 1;
+            }
+        }
+        TaxTables *tables = malloc(sizeof(TaxTables));
+        if (!tables || loadTaxConfig(config, tables) != 0) return 1;
+        int rc;
+        if (strcmp(argv[1], "--bench-tax") == 0) {
+            rc = runTaxBench(number > 0 ? number : 10000000, tables);
+        } else if (!path) {
+            printf("Usage: %s %s <employees.csv> [--threads <n>]\n", argv[0], argv[1]);
+            rc = 1;
+        } else {
+            const TaxTable *table = findTaxTable(tables, jurisdiction, year);
+            if (!table) {
+                printf("No tax table for %s %d\n", jurisdiction, year);
+                rc = 1;
+            } else {
+                rc = strcmp(argv[1], "--engine") == 0 ? runEngine(path, threads, table, tables)
+                                                      : runBatch(path, threads, table, format, reportPath);
+            }
+        }
+        free(tables);
+        return rc;
+    }
+    if (argc >= 3 && (strcmp(argv[1], "--post") == 0 || strcmp(argv[1], "--ledger") == 0 ||
+                      strcmp(argv[1], "--reconcile") == 0)) {
+        const char *arg[3] = { NULL, NULL, NULL }, *config = NULL, *jurisdiction = "PH", *email = NULL;
+        int args = 0;
+        for (int i = 2; i < argc; i++) {
+            if (strcmp(argv[i], "--tax-config") == 0 && i + 1 < argc) config = argv[++i];
+            else if (strcmp(argv[i], "--jurisdiction") == 0 && i + 1 < argc) jurisdiction = argv[++i];
+            else if (strcmp(argv[i], "--employee") == 0 && i + 1 < argc) email = argv[++i];
+            else if (args < 3) arg[args++] = argv[i];
+        }
+        if (strcmp(argv[1], "--ledger") == 0) {
+            int from = arg[1] ? parsePeriod(arg[1]) : 0, to = arg[2] ? parsePeriod(arg[2]) : 999912;
+            if ((arg[1] && !from) || !to) {
+                printf("Bad period (use YYYY-MM)\n");
+                return 1;
+            }
+            return runLedger(arg[0], from, arg[1] && !arg[2] ? from : to, email);
+        }
+        if (!arg[1] || (strcmp(argv[1], "--post") == 0 && !arg[2])) {
+            printf("Usage: %s --post <employees.csv> <YYYY-MM> <ledger>\n"
+                   "       %s --reconcile <ledger> <year>\n", argv[0], argv[0]);
+            return 1;
+        }
+        TaxTables *tables = malloc(sizeof(TaxTables));
+        if (!tables || loadTaxConfig(config, tables) != 0) return 1;
+        int rc = strcmp(argv[1], "--post") == 0
+                     ? runPost(arg[0], arg[1], arg[2], tables, jurisdiction, defaultThreads())
+                     : runReconcile(arg[0], atoi(arg[1]), tables, jurisdiction);
+        free(tables);
+        return rc;
+    }
+    if (argc >= 4 && strcmp(argv[1], "--generate") == 0) {
+        return runGenerate(atol(argv[2]), argv[3]);
+    }
+
+    do {
+        Employee *emp = arenaAlloc(&arena, sizeof(Employee));
+        long len;
 
         // Get employee basic details
         printf("\nEnter employee name: ");
-        scanf(" %[^\n]s", employees[count].name);
+        if ((len = readLine(&line, &lineCap)) < 0) break;
+        emp->name = arenaString(&arena, line, (size_t)len);
 
         printf("Enter employee age: ");
-        scanf("%d", &employees[count].age);
+        scanf("%d", &emp->age);
 
         printf("Enter employee email: ");
-        scanf(" %[^\n]s", employees[count].email);
+        if ((len = readLine(&line, &lineCap)) < 0) break;
+        emp->email = arenaString(&arena, line, (size_t)len);
 
         // Salary and tax calculation
         printf("Enter monthly salary: ");
-        scanf("%lf", &employees[count].salary);
+        scanf("%lf", &emp->salary);
 
-        employees[count].tax = computeTax(employees[count].salary);
-        employees[count].extraCount = 0;
-        employees[count].totalTax = employees[count].tax;
+        emp->tax = computeTax(emp->salary);
+        emp->extraCount = 0;
+        emp->extraTaxes = NULL;
+        emp->totalTax = emp->tax;
+        emp->next = NULL;
 
         // Ask if employee has extra taxes (SSS, PhilHealth, etc.)
         char extraChoice;
@@ -76,67 +2790,79 @@ int main() {
         scanf(" %c", &extraChoice);
 
         if (extraChoice == 'y' || extraChoice == 'Y') {
-            for (int i = 0; i < MAX_EXTRA_TAX; i++) {
+            for (int i = 0; ; i++) {
                 double extra;
-                char label[30];
 
                 // Ask for label (e.g., SSS, PhilHealth, Pag-IBIG)
                 printf("Enter label for extra tax #%d: ", i + 1);
-                scanf(" %[^\n]s", label);
+                if ((len = readLine(&line, &lineCap)) < 0) break;
 
                 // Ask for amount (enter 0 to stop early)
-                printf("Enter amount for %s (or 0 to stop): ", label);
-                scanf("%lf", &extra);
-
-                if (extra <= 0) break; // Stop if user enters 0
+                printf("Enter amount for %.*s (or 0 to stop): ", (int)len, line);
+                if (scanf("%lf", &extra) != 1 || extra <= 0) break; // Stop if user enters 0
 
-                // Store label + amount
-                strcpy(employees[count].extraTaxes[employees[count].extraCount].label, label);
-                employees[count].extraTaxes[employees[count].extraCount].amount = extra;
+                // Collect label + amount; the list is copied to the arena once it is complete
+                if (i == extrasCap) {
+                    extrasCap = extrasCap ? extrasCap * 2 : 8;
+                    extras = xrealloc(extras, sizeof(ExtraTax) * extrasCap);
+                }
+                extras[i].label = arenaIntern(&arena, line, (size_t)len);
+                extras[i].amount = extra;
 
                 // Update totals
-                employees[count].extraCount++;
-                employees[count].totalTax += extra;
+                emp->extraCount++;
+                emp->totalTax += extra;
+            }
+            if (emp->extraCount > 0) {
+                emp->extraTaxes = arenaAlloc(&arena, sizeof(ExtraTax) * emp->extraCount);
+                memcpy(emp->extraTaxes, extras, sizeof(ExtraTax) * emp->extraCount);
             }
         }
 
         // Compute Net Pay
-        employees[count].netPay = employees[count].salary - employees[count].totalTax;
+        emp->netPay = emp->salary - emp->totalTax;
 
-        // Move to next employee
-        count++;
+        // Append to the list
+        if (last) last->next = emp;
+        else employees = emp;
+        last = emp;
 
         printf("Do you want to add another employee? (y/n): ");
-        scanf(" %c", &choice);
+        if (scanf(" %c", &choice) != 1) break;
 
     } while (choice == 'y' || choice == 'Y');
 
-    // Print summary table
-    printf("\n%-20s %-5s %-25s %-12s %-12s %-12s %-12s\n",
-           "Employee Name", "Age", "Email", "Salary", "Base Tax", "Total Tax", "Net Pay");
-    printf("---------------------------------------------------------------------------------------------------------\n");
+    // Print summary table: rows are formatted into one buffer that is
+    // written out each time it passes REPORT_FLUSH bytes
+    ReportBuffer report = { NULL, 0, 0 };
+    reportFixedHeader(&report);
 
     // Loop through employees and print their info
-    for (int i = 0; i < count; i++) {
-        printf("%-20s %-5d %-25s %-12.2f %-12.2f %-12.2f %-12.2f\n",
-               employees[i].name,
-               employees[i].age,
-               employees[i].email,
-               employees[i].salary,
-               employees[i].tax,
-               employees[i].totalTax,
-               employees[i].netPay);
+    for (const Employee *emp = employees; emp; emp = emp->next) {
+        const double money[4] = { emp->salary, emp->tax, emp->totalTax, emp->netPay };
+        size_t nameLen = strlen(emp->name), emailLen = strlen(emp->email), textLen = nameLen + emailLen;
+        for (int j = 0; j < emp->extraCount; j++) textLen += strlen(emp->extraTaxes[j].label);
+        reportReserve(&report, reportRowBound(textLen, (size_t)emp->extraCount));
+        char *p = reportFixedRow(report.data + report.len, emp->name, nameLen, emp->age,
+                                 emp->email, emailLen, money);
 
         // Print extra taxes if any
-        if (employees[i].extraCount > 0) {
-            printf("   Extra Taxes:\n");
-            for (int j = 0; j < employees[i].extraCount; j++) {
-                printf("      %s: %.2f\n",
-                       employees[i].extraTaxes[j].label,
-                       employees[i].extraTaxes[j].amount);
-            }
+        for (int j = 0; j < emp->extraCount; j++) {
+            p = reportFixedExtra(p, j == 0, emp->extraTaxes[j].label,
+                                 strlen(emp->extraTaxes[j].label), emp->extraTaxes[j].amount);
+        }
+        report.len = (size_t)(p - report.data);
+        if (report.len >= REPORT_FLUSH) {
+            fwrite(report.data, 1, report.len, stdout);
+            report.len = 0;
         }
     }
+    fwrite(report.data, 1, report.len, stdout);
+    free(report.data);
 
+    // The whole run is released at once
+    free(line);
+    free(extras);
+    arenaFree(&arena);
     return 0;
 }
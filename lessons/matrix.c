@@ -0,0 +1,550 @@
+// Code originally made by Tonie
+// Used for lessons on arrays and matrices in C (follows arrays.c)
+// This code grows the 2D array from arrays.c into a dense matrix module:
+// row-major aligned storage, element-wise operations, transpose, and a
+// cache-blocked matrix multiply that runs on several threads
+// Compile: gcc -O2 -march=native matrix.c -o matrix -pthread
+//          (without -mavx2 -mfma the multiply uses the plain C kernel)
+// Demo:    ./matrix
+// Bench:   ./matrix --bench [max size] [--threads <n>] [--naive-max <size>]
+//          (GFLOP/s of the naive triple loop and the blocked multiply for
+//          sizes 64, 128, ... up to max size, default 4096)
+
+// libraries
+#define _POSIX_C_SOURCE 200112L     // posix_memalign under -std=c11
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define MATRIX_AVX2 1
+#endif
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#else
+#include <malloc.h>
+#endif
+
+// ------------------ STORAGE SECTION ------------------
+// A matrix is one block of doubles, row after row. Each row starts on a
+// 64-byte boundary (stride is rounded up to 8 doubles), so rows line up
+// with cache lines and with 256-bit loads.
+#define MATRIX_ALIGN 64
+#define MATRIX_STRIDE_STEP (MATRIX_ALIGN / sizeof(double))
+
+typedef struct {
+    int rows, cols;
+    int stride;         // doubles from one row to the next
+    double *data;       // NULL if creation failed
+} Matrix;
+
+#define AT(m, i, j) ((m)->data[(size_t)(i) * (m)->stride + (j)])
+
+static void *alignedAlloc(size_t bytes) {
+#ifdef _WIN32
+    return _aligned_malloc(bytes, MATRIX_ALIGN);
+#else
+    void *p = NULL;
+    return posix_memalign(&p, MATRIX_ALIGN, bytes) == 0 ? p : NULL;
+#endif
+}
+
+static void alignedFree(void *p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+// Zero-filled rows x cols matrix; check .data for NULL
+Matrix matrixCreate(int rows, int cols) {
+    Matrix m = { rows, cols, 0, NULL };
+    m.stride = (int)((cols + MATRIX_STRIDE_STEP - 1) / MATRIX_STRIDE_STEP * MATRIX_STRIDE_STEP);
+    size_t bytes = (size_t)rows * m.stride * sizeof(double);
+    m.data = alignedAlloc(bytes ? bytes : MATRIX_ALIGN);
+    if (m.data) memset(m.data, 0, bytes);
+    return m;
+}
+
+void matrixFree(Matrix *m) {
+    alignedFree(m->data);
+    m->data = NULL;
+}
+
+void matrixPrint(const Matrix *m) {
+    for (int i = 0; i < m->rows; i++) {
+        for (int j = 0; j < m->cols; j++) {
+            printf("%g\t", AT(m, i, j));
+        }
+        printf("\n"); // move to next row
+    }
+}
+
+// Fill with values in [-1, 1) from a small xorshift generator
+void matrixRandom(Matrix *m, uint64_t seed) {
+    uint64_t x = seed * 0x9E3779B97F4A7C15ULL + 1;
+    for (int i = 0; i < m->rows; i++) {
+        for (int j = 0; j < m->cols; j++) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            AT(m, i, j) = (double)(x >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+        }
+    }
+}
+
+// ------------------ ELEMENT-WISE SECTION ------------------
+typedef enum { MATRIX_ADD, MATRIX_SUB, MATRIX_MUL, MATRIX_DIV } MatrixOp;
+
+// out = a op b, element by element; out may be a or b. The op switch sits
+// outside the row loop so each case is a simple loop the compiler
+// vectorizes. Returns -1 if the shapes differ.
+int matrixMap(MatrixOp op, const Matrix *a, const Matrix *b, Matrix *out) {
+    if (a->rows != b->rows || a->cols != b->cols || a->rows != out->rows || a->cols != out->cols) return -1;
+    for (int i = 0; i < a->rows; i++) {
+        const double *x = &AT(a, i, 0), *y = &AT(b, i, 0);
+        double *z = &AT(out, i, 0);
+        int j, n = a->cols;
+        switch (op) {
+            case MATRIX_ADD: for (j = 0; j < n; j++) z[j] = x[j] + y[j]; break;
+            case MATRIX_SUB: for (j = 0; j < n; j++) z[j] = x[j] - y[j]; break;
+            case MATRIX_MUL: for (j = 0; j < n; j++) z[j] = x[j] * y[j]; break;
+            case MATRIX_DIV: for (j = 0; j < n; j++) z[j] = x[j] / y[j]; break;
+        }
+    }
+    return 0;
+}
+
+// out = alpha * a (out may be a)
+int matrixScale(const Matrix *a, double alpha, Matrix *out) {
+    if (a->rows != out->rows || a->cols != out->cols) return -1;
+    for (int i = 0; i < a->rows; i++) {
+        const double *x = &AT(a, i, 0);
+        double *z = &AT(out, i, 0);
+        for (int j = 0; j < a->cols; j++) z[j] = alpha * x[j];
+    }
+    return 0;
+}
+
+// Largest |a - b| over all elements
+double matrixMaxDiff(const Matrix *a, const Matrix *b) {
+    double worst = 0;
+    for (int i = 0; i < a->rows; i++) {
+        for (int j = 0; j < a->cols; j++) {
+            double d = fabs(AT(a, i, j) - AT(b, i, j));
+            if (d > worst) worst = d;
+        }
+    }
+    return worst;
+}
+
+// ------------------ TRANSPOSE SECTION ------------------
+// Done in 32 x 32 tiles: a tile of the source and of the destination
+// (8 KB each) both stay in L1, so neither side is walked down a column
+// of the whole matrix.
+#define TRANSPOSE_TILE 32
+
+int matrixTranspose(const Matrix *a, Matrix *t) {
+    if (t->rows != a->cols || t->cols != a->rows || t->data == a->data) return -1;
+    for (int i0 = 0; i0 < a->rows; i0 += TRANSPOSE_TILE) {
+        int i1 = i0 + TRANSPOSE_TILE < a->rows ? i0 + TRANSPOSE_TILE : a->rows;
+        for (int j0 = 0; j0 < a->cols; j0 += TRANSPOSE_TILE) {
+            int j1 = j0 + TRANSPOSE_TILE < a->cols ? j0 + TRANSPOSE_TILE : a->cols;
+            for (int i = i0; i < i1; i++) {
+                for (int j = j0; j < j1; j++) AT(t, j, i) = AT(a, i, j);
+            }
+        }
+    }
+    return 0;
+}
+
+// ------------------ MULTIPLY SECTION ------------------
+// c = a * b, the textbook way: one dot product per element, walking b down
+// a column (a new cache line for every k once b is large)
+int matrixMultiplyNaive(const Matrix *a, const Matrix *b, Matrix *c) {
+    if (a->cols != b->rows || c->rows != a->rows || c->cols != b->cols) return -1;
+    for (int i = 0; i < a->rows; i++) {
+        for (int j = 0; j < b->cols; j++) {
+            double sum = 0;
+            for (int k = 0; k < a->cols; k++) sum += AT(a, i, k) * AT(b, k, j);
+            AT(c, i, j) = sum;
+        }
+    }
+    return 0;
+}
+
+// --- Blocked Multiply ---
+// The loops follow the usual GotoBLAS layout:
+//   for each NC-wide column panel of b
+//     for each KC-deep slice: pack b[KC x NC] into NR-wide strips
+//       for each MC-tall block of a: pack a[MC x KC] into MR-tall strips
+//         for each MR x NR tile of c: micro-kernel over KC
+// A packed b strip (KC x NR, 16 KB) stays in L1, the packed a block
+// (MC x KC, 192 KB) in L2 and the b panel (KC x NC, 2 MB) in L3. The
+// micro-kernel keeps its 6 x 8 tile of c in twelve 256-bit registers.
+#define MR 6
+#define NR 8
+#define MC 96               // multiple of MR
+#define KC 256
+#define NC 1024             // multiple of NR
+#define MAX_THREADS 64
+
+// Pack rows [0, mc) x cols [0, kc) of a (starting at src) into MR-row
+// strips, each stored k-major: dst[strip][k][r]. Short strips are zero
+// padded so the kernel never branches on the edge.
+static void packA(const double *src, int lda, int mc, int kc, double *dst) {
+    for (int i = 0; i < mc; i += MR) {
+        int rows = mc - i < MR ? mc - i : MR;
+        for (int k = 0; k < kc; k++) {
+            for (int r = 0; r < rows; r++) dst[r] = src[(size_t)(i + r) * lda + k];
+            for (int r = rows; r < MR; r++) dst[r] = 0;
+            dst += MR;
+        }
+    }
+}
+
+// Pack rows [0, kc) x cols [0, nc) of b into NR-column strips,
+// dst[strip][k][j], zero padded on the right
+static void packB(const double *src, int ldb, int kc, int nc, double *dst) {
+    for (int j = 0; j < nc; j += NR) {
+        int cols = nc - j < NR ? nc - j : NR;
+        for (int k = 0; k < kc; k++) {
+            const double *row = src + (size_t)k * ldb + j;
+            for (int x = 0; x < cols; x++) dst[x] = row[x];
+            for (int x = cols; x < NR; x++) dst[x] = 0;
+            dst += NR;
+        }
+    }
+}
+
+#ifdef MATRIX_AVX2
+static inline void addRow(double *row, __m256d lo, __m256d hi) {
+    _mm256_storeu_pd(row, _mm256_add_pd(_mm256_loadu_pd(row), lo));
+    _mm256_storeu_pd(row + 4, _mm256_add_pd(_mm256_loadu_pd(row + 4), hi));
+}
+#endif
+
+// c[0..MR) x [0..NR) += a strip * b strip over kc; tile is written
+// straight to c when whole, otherwise through a scratch tile
+static void microKernel(int kc, const double *a, const double *b, double *c, int ldc, int rows, int cols) {
+    double tile[MR * NR];
+#ifdef MATRIX_AVX2
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+    __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+    for (int k = 0; k < kc; k++, a += MR, b += NR) {
+        __m256d b0 = _mm256_load_pd(b), b1 = _mm256_load_pd(b + 4), x;
+        x = _mm256_broadcast_sd(a + 0);
+        c00 = _mm256_fmadd_pd(x, b0, c00);
+        c01 = _mm256_fmadd_pd(x, b1, c01);
+        x = _mm256_broadcast_sd(a + 1);
+        c10 = _mm256_fmadd_pd(x, b0, c10);
+        c11 = _mm256_fmadd_pd(x, b1, c11);
+        x = _mm256_broadcast_sd(a + 2);
+        c20 = _mm256_fmadd_pd(x, b0, c20);
+        c21 = _mm256_fmadd_pd(x, b1, c21);
+        x = _mm256_broadcast_sd(a + 3);
+        c30 = _mm256_fmadd_pd(x, b0, c30);
+        c31 = _mm256_fmadd_pd(x, b1, c31);
+        x = _mm256_broadcast_sd(a + 4);
+        c40 = _mm256_fmadd_pd(x, b0, c40);
+        c41 = _mm256_fmadd_pd(x, b1, c41);
+        x = _mm256_broadcast_sd(a + 5);
+        c50 = _mm256_fmadd_pd(x, b0, c50);
+        c51 = _mm256_fmadd_pd(x, b1, c51);
+    }
+    if (rows == MR && cols == NR) {
+        addRow(c + 0 * (size_t)ldc, c00, c01);
+        addRow(c + 1 * (size_t)ldc, c10, c11);
+        addRow(c + 2 * (size_t)ldc, c20, c21);
+        addRow(c + 3 * (size_t)ldc, c30, c31);
+        addRow(c + 4 * (size_t)ldc, c40, c41);
+        addRow(c + 5 * (size_t)ldc, c50, c51);
+        return;
+    }
+    _mm256_storeu_pd(tile + 0 * NR, c00); _mm256_storeu_pd(tile + 0 * NR + 4, c01);
+    _mm256_storeu_pd(tile + 1 * NR, c10); _mm256_storeu_pd(tile + 1 * NR + 4, c11);
+    _mm256_storeu_pd(tile + 2 * NR, c20); _mm256_storeu_pd(tile + 2 * NR + 4, c21);
+    _mm256_storeu_pd(tile + 3 * NR, c30); _mm256_storeu_pd(tile + 3 * NR + 4, c31);
+    _mm256_storeu_pd(tile + 4 * NR, c40); _mm256_storeu_pd(tile + 4 * NR + 4, c41);
+    _mm256_storeu_pd(tile + 5 * NR, c50); _mm256_storeu_pd(tile + 5 * NR + 4, c51);
+#else
+    // Same tile in plain C; the fixed-size inner loops unroll and the
+    // compiler keeps what it can of the tile in registers
+    memset(tile, 0, sizeof(tile));
+    for (int k = 0; k < kc; k++, a += MR, b += NR) {
+        for (int r = 0; r < MR; r++) {
+            for (int x = 0; x < NR; x++) tile[r * NR + x] += a[r] * b[x];
+        }
+    }
+#endif
+    for (int r = 0; r < rows; r++) {
+        for (int x = 0; x < cols; x++) c[(size_t)r * ldc + x] += tile[r * NR + x];
+    }
+}
+
+typedef struct {
+    const Matrix *a, *b;
+    Matrix *c;
+    int rowBegin, rowEnd;   // rows of c this thread computes
+    double *packedA, *packedB;
+} MultiplyJob;
+
+static void *multiplyWorker(void *arg) {
+    MultiplyJob *job = arg;
+    const Matrix *a = job->a, *b = job->b;
+    Matrix *c = job->c;
+    int n = b->cols, depth = a->cols;
+
+    for (int i = job->rowBegin; i < job->rowEnd; i++) memset(&AT(c, i, 0), 0, (size_t)n * sizeof(double));
+    for (int jc = 0; jc < n; jc += NC) {
+        int nc = n - jc < NC ? n - jc : NC;
+        for (int pc = 0; pc < depth; pc += KC) {
+            int kc = depth - pc < KC ? depth - pc : KC;
+            packB(&AT(b, pc, jc), b->stride, kc, nc, job->packedB);
+            for (int ic = job->rowBegin; ic < job->rowEnd; ic += MC) {
+                int mc = job->rowEnd - ic < MC ? job->rowEnd - ic : MC;
+                packA(&AT(a, ic, pc), a->stride, mc, kc, job->packedA);
+                for (int jr = 0; jr < nc; jr += NR) {
+                    for (int ir = 0; ir < mc; ir += MR) {
+                        microKernel(kc, job->packedA + (size_t)ir * kc, job->packedB + (size_t)jr * kc,
+                                    &AT(c, ic + ir, jc + jr), c->stride, mc - ir < MR ? mc - ir : MR,
+                                    nc - jr < NR ? nc - jr : NR);
+                    }
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+int defaultThreads() {
+#if !defined(_WIN32) && defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n > 0) return n < MAX_THREADS ? (int)n : MAX_THREADS;
+#endif
+    return 1;
+}
+
+// c = a * b using up to `threads` threads, each taking a band of rows of c
+// (whole MC blocks, so every band packs its own a and b and shares
+// nothing). c must not alias a or b. Returns -1 on a shape mismatch or if
+// out of memory.
+int matrixMultiply(const Matrix *a, const Matrix *b, Matrix *c, int threads) {
+    if (a->cols != b->rows || c->rows != a->rows || c->cols != b->cols) return -1;
+    if (c->data == a->data || c->data == b->data) return -1;
+    int blocks = (a->rows + MC - 1) / MC;
+    if (threads > blocks) threads = blocks;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if (threads < 1) threads = 1;
+
+    MultiplyJob jobs[MAX_THREADS];
+    int status = 0;
+    for (int t = 0; t < threads; t++) {
+        jobs[t].a = a;
+        jobs[t].b = b;
+        jobs[t].c = c;
+        jobs[t].rowBegin = (int)((long long)blocks * t / threads) * MC;
+        jobs[t].rowEnd = t + 1 == threads ? a->rows : (int)((long long)blocks * (t + 1) / threads) * MC;
+        jobs[t].packedA = alignedAlloc((size_t)MC * KC * sizeof(double));
+        jobs[t].packedB = alignedAlloc((size_t)KC * NC * sizeof(double));
+        if (!jobs[t].packedA || !jobs[t].packedB) status = -1;
+    }
+    if (status == 0) {
+#ifndef _WIN32
+        pthread_t tid[MAX_THREADS];
+        int started = 0;
+        for (int t = 1; t < threads; t++) {
+            if (pthread_create(&tid[t], NULL, multiplyWorker, &jobs[t]) != 0) break;
+            started = t;
+        }
+        multiplyWorker(&jobs[0]);
+        for (int t = started + 1; t < threads; t++) multiplyWorker(&jobs[t]);     // threads that failed to start
+        for (int t = 1; t <= started; t++) pthread_join(tid[t], NULL);
+#else
+        for (int t = 0; t < threads; t++) multiplyWorker(&jobs[t]);
+#endif
+    }
+    for (int t = 0; t < threads; t++) {
+        alignedFree(jobs[t].packedA);
+        alignedFree(jobs[t].packedB);
+    }
+    return status;
+}
+
+// ------------------ BENCHMARK SECTION ------------------
+static double nowSeconds() {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+typedef int (*MultiplyFn)(const Matrix *, const Matrix *, Matrix *, int);
+
+static int naiveAdapter(const Matrix *a, const Matrix *b, Matrix *c, int threads) {
+    (void)threads;
+    return matrixMultiplyNaive(a, b, c);
+}
+
+// Best GFLOP/s over repeats lasting at least ~0.2 s in total; -1 if the
+// multiply fails (its buffers could not be allocated)
+static double timeMultiply(MultiplyFn fn, const Matrix *a, const Matrix *b, Matrix *c, int threads) {
+    double flops = 2.0 * a->rows * a->cols * b->cols, best = 0, total = 0;
+    for (int rep = 0; rep < 3 || total < 0.2; rep++) {
+        double t0 = nowSeconds();
+        if (fn(a, b, c, threads) != 0) return -1;
+        double t = nowSeconds() - t0;
+        total += t;
+        if (t > 0 && flops / t > best) best = flops / t;
+        if (t > 2.0) break;
+    }
+    return best / 1e9;
+}
+
+// Largest error of c = a * b over a few sampled elements (rows and columns
+// spread across the matrix, edges included), each checked with a plain
+// dot product. Used where the full naive multiply would take too long.
+#define SPOT_SAMPLES 16
+static double spotCheck(const Matrix *a, const Matrix *b, const Matrix *c) {
+    double worst = 0;
+    for (int s = 0; s < SPOT_SAMPLES; s++) {
+        for (int t = 0; t < SPOT_SAMPLES; t++) {
+            int i = (int)((int64_t)s * (c->rows - 1) / (SPOT_SAMPLES - 1));
+            int j = (int)((int64_t)(t * 7 % SPOT_SAMPLES) * (c->cols - 1) / (SPOT_SAMPLES - 1));
+            double sum = 0;
+            for (int k = 0; k < a->cols; k++) sum += AT(a, i, k) * AT(b, k, j);
+            double d = fabs(AT(c, i, j) - sum);
+            if (d > worst) worst = d;
+        }
+    }
+    return worst;
+}
+
+int runBench(int maxSize, int threads, int naiveMax) {
+    printf("Blocked kernel: %s, %d thread%s\n",
+#ifdef MATRIX_AVX2
+           "AVX2 + FMA",
+#else
+           "plain C",
+#endif
+           threads, threads == 1 ? "" : "s");
+    printf("%6s %12s %12s %12s %9s %12s %12s\n", "size", "naive", "blocked x1", "blocked", "speedup", "transpose",
+           "max error");
+    for (int n = 64; n <= maxSize; n *= 2) {
+        Matrix a = matrixCreate(n, n), b = matrixCreate(n, n), c = matrixCreate(n, n);
+        Matrix ref = n <= naiveMax ? matrixCreate(n, n) : (Matrix){0};
+        if (!a.data || !b.data || !c.data || (n <= naiveMax && !ref.data)) {
+            fprintf(stderr, "Out of memory at %d x %d\n", n, n);
+            matrixFree(&a);
+            matrixFree(&b);
+            matrixFree(&c);
+            matrixFree(&ref);
+            return 1;
+        }
+        matrixRandom(&a, 1);
+        matrixRandom(&b, 2);
+
+        double naive = 0, single, multi, error;
+        if (n <= naiveMax) naive = timeMultiply(naiveAdapter, &a, &b, &ref, 1);
+        single = timeMultiply(matrixMultiply, &a, &b, &c, 1);
+        error = n <= naiveMax ? matrixMaxDiff(&c, &ref) : spotCheck(&a, &b, &c);
+        multi = single >= 0 && threads > 1 ? timeMultiply(matrixMultiply, &a, &b, &c, threads) : single;
+        if (multi >= 0 && threads > 1) {
+            double e = n <= naiveMax ? matrixMaxDiff(&c, &ref) : spotCheck(&a, &b, &c);
+            if (e > error) error = e;
+        }
+        if (naive < 0 || single < 0 || multi < 0) {
+            fprintf(stderr, "Out of memory for the multiply buffers at %d x %d\n", n, n);
+            matrixFree(&a);
+            matrixFree(&b);
+            matrixFree(&c);
+            matrixFree(&ref);
+            return 1;
+        }
+
+        double t0 = nowSeconds();
+        int reps = 0;
+        do {
+            matrixTranspose(&a, &c);
+            reps++;
+        } while (nowSeconds() - t0 < 0.05);
+        double gbs = 2.0 * n * n * sizeof(double) * reps / (nowSeconds() - t0) / 1e9;
+
+        char naiveText[16] = "-", speedText[16] = "-";
+        if (naive > 0) {
+            snprintf(naiveText, sizeof(naiveText), "%.2f", naive);
+            snprintf(speedText, sizeof(speedText), "%.1fx", multi / naive);
+        }
+        printf("%6d %12s %12.2f %12.2f %9s %9.2f GB/s %12.1e\n", n, naiveText, single, multi, speedText, gbs, error);
+        fflush(stdout);
+        matrixFree(&a);
+        matrixFree(&b);
+        matrixFree(&c);
+        matrixFree(&ref);
+    }
+    printf("(naive and blocked in GFLOP/s; max error against the naive result, or\n"
+           " against %d x %d sampled dot products above --naive-max)\n", SPOT_SAMPLES, SPOT_SAMPLES);
+    return 0;
+}
+
+// ------------------ DEMO SECTION ------------------
+int main(int argc, char *argv[]) {
+    int bench = 0, maxSize = 4096, naiveMax = 1024, threads = defaultThreads();
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bench") == 0) {
+            bench = 1;
+            if (i + 1 < argc && argv[i + 1][0] != '-') maxSize = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--naive-max") == 0 && i + 1 < argc) naiveMax = atoi(argv[++i]);
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if (bench) return runBench(maxSize, threads, naiveMax);
+
+    // the 2x3 matrix from arrays.c, now with operations on it
+    printf("=== MATRIX MODULE EXAMPLE ===\n");
+    Matrix a = matrixCreate(2, 3), t = matrixCreate(3, 2), p = matrixCreate(2, 2), s = matrixCreate(2, 3);
+    if (!a.data || !t.data || !p.data || !s.data) return 1;
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 3; j++) {
+            AT(&a, i, j) = i * 3 + j + 1;    // 1 2 3 / 4 5 6
+        }
+    }
+    printf("\nMatrix A:\n");
+    matrixPrint(&a);
+
+    matrixTranspose(&a, &t);
+    printf("\nTranspose of A:\n");
+    matrixPrint(&t);
+
+    printf("\nA x transpose(A):\n");
+    if (matrixMultiply(&a, &t, &p, 1) == 0) matrixPrint(&p);
+    else printf("(out of memory for the multiply buffers)\n");
+
+    matrixMap(MATRIX_ADD, &a, &a, &s);
+    printf("\nA + A:\n");
+    matrixPrint(&s);
+
+    matrixMap(MATRIX_MUL, &a, &a, &s);
+    printf("\nA * A (element by element):\n");
+    matrixPrint(&s);
+
+    matrixScale(&a, 0.5, &s);
+    printf("\n0.5 * A:\n");
+    matrixPrint(&s);
+
+    matrixFree(&a);
+    matrixFree(&t);
+    matrixFree(&p);
+    matrixFree(&s);
+    return 0;
+}
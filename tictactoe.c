@@ -1,27 +1,1460 @@
+// tictactoe.c
+// Tic-tac-toe and other m,n,k games (K in a row on an M x N board, up to
+// 32 x 32), for two players or against the computer
+// Compile: gcc -O2 tictactoe.c -o tictactoe -pthread
+// Play:    ./tictactoe [--board <rows>x<cols>] [--k <n>] [--ai X|O]
+//                      [--threads <n>] [--time <seconds per move>]
+//          (default 3x3, K = 3, or 5 on boards with both sides of 5 or more;
+//          with --ai the computer plays that side, otherwise two players)
+// Bench:   ./tictactoe [--board ...] [--k ...] --perft [depth]
+//          ./tictactoe [--board ...] [--k ...] [--threads <n>] --bench [depth]
+//          (time to depth and nodes/s with 1, 2, 4 ... threads)
+// Table:   ./tictactoe --gen-table [tictactoe_table.h]
+//          (3x3 perfect play; the computer answers from it with no search)
+// Self-play: ./tictactoe [--board ...] [--k ...] --selfplay <games>
+//                      [--x random|heuristic|search] [--o ...] [--depth <plies>]
+//                      [--opening <random plies>] [--threads <n>] [--seed <n>]
+//                      [--record <file>]
+// Records: finished 3x3 games are appended to tictactoe.rec (--record <file>
+//          to change it, --no-record for none);
+//          ./tictactoe --analyze <file> [--threads <n>] replays them against
+//          perfect play and counts blunders
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// ------------------ Board ------------------
+// Each side owns a bitboard; bit c is cell c + 1 as numbered on screen,
+// row by row. A move can only complete lines through its own cell, so the
+// win check walks the 4 directions from the last move (at most 2(K-1)
+// cells) and a draw is simply every cell having been played.
+// The board also keeps, for the search, how many stones each side has in
+// every K-window (a run of K cells that could become a line) and a score
+// summed over the windows; a move updates only the windows through its cell.
+#define MAX_SIDE  32
+#define MAX_CELLS (MAX_SIDE * MAX_SIDE)
+#define MAX_WORDS (MAX_CELLS / 64)
+#define MAX_LINES (4 * MAX_CELLS)
+#define NEAR      2     // the search only tries cells this close to a stone
+
+typedef struct {
+    int rows, cols, k, cells;
+    int moves;                          // stones on the board
+    uint64_t side[2][MAX_WORDS];        // X = 0, O = 1
+    uint8_t near[MAX_CELLS];            // stones within NEAR of each cell
+    uint8_t lines[2][MAX_LINES];        // stones of each side in each K-window
+    int score;                          // sum of lineValue(), good for X
+} Board;
+
+// K-windows of the board being played; set up by initBoard()
+static struct {
+    int count;
+    int cellLine[MAX_CELLS + 1];        // windows through c: line[cellLine[c] ..]
+    int line[4 * MAX_SIDE * MAX_CELLS];
+    int weight[MAX_SIDE + 1];           // by stones in an unblocked window
+} geometry;
+
+static const int DIRS[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } };
+static const char MARKS[2] = { 'X', 'O' };
+
+typedef struct SearchLimits SearchLimits;
 
 // Function prototypes
-void printBoard(char board[3][3]);
-int checkWinner(char board[3][3]);
-void playerMove(char board[3][3], char player);
+void printBoard(const Board *b);
+int checkWinner(const Board *b, int lastMove);
+int playerMove(Board *b, int side);
+int computerMove(Board *b, int side, const SearchLimits *limits);
+
+#if defined(__GNUC__) || defined(__clang__)
+#define lowestBit(m) __builtin_ctzll(m)
+#define countBits(m) __builtin_popcountll(m)
+#else
+static int lowestBit(uint64_t m) {
+    int c = 0;
+    while (!(m >> c & 1)) c++;
+    return c;
+}
+static int countBits(uint64_t m) {
+    int n = 0;
+    for (; m; m &= m - 1) n++;
+    return n;
+}
+#endif
+
+void initBoard(Board *b, int rows, int cols, int k) {
+    memset(b, 0, sizeof(*b));
+    b->rows = rows;
+    b->cols = cols;
+    b->k = k;
+    b->cells = rows * cols;
+
+    // Windows are counted per cell, then listed cell by cell
+    memset(&geometry, 0, sizeof(geometry));
+    for (int pass = 0; pass < 2; pass++) {
+        int w = 0;
+        for (int d = 0; d < 4; d++) {
+            for (int r = 0; r < rows; r++) {
+                for (int c = 0; c < cols; c++) {
+                    int er = r + (k - 1) * DIRS[d][0], ec = c + (k - 1) * DIRS[d][1];
+                    if (er < 0 || er >= rows || ec < 0 || ec >= cols) continue;
+                    for (int i = 0; i < k; i++) {
+                        int cell = (r + i * DIRS[d][0]) * cols + c + i * DIRS[d][1];
+                        if (pass == 0) geometry.cellLine[cell + 1]++;
+                        else geometry.line[geometry.cellLine[cell]++] = w;
+                    }
+                    w++;
+                }
+            }
+        }
+        geometry.count = w;
+        if (pass == 0) {
+            for (int c = 0; c < b->cells; c++) geometry.cellLine[c + 1] += geometry.cellLine[c];
+        } else {
+            for (int c = b->cells; c > 0; c--) geometry.cellLine[c] = geometry.cellLine[c - 1];
+            geometry.cellLine[0] = 0;
+        }
+    }
+    for (int n = 1; n <= MAX_SIDE; n++) geometry.weight[n] = 1 << (3 * (n - 1) < 15 ? 3 * (n - 1) : 15);
+}
+
+static inline int stoneAt(const Board *b, int side, int c) {
+    return (int)(b->side[side][c >> 6] >> (c & 63) & 1);
+}
+
+static inline int isEmpty(const Board *b, int c) {
+    return !((b->side[0][c >> 6] | b->side[1][c >> 6]) >> (c & 63) & 1);
+}
+
+static void updateNear(Board *b, int c, int delta) {
+    int r = c / b->cols, col = c % b->cols;
+    for (int i = r - NEAR; i <= r + NEAR; i++) {
+        if (i < 0 || i >= b->rows) continue;
+        for (int j = col - NEAR; j <= col + NEAR; j++) {
+            if (j >= 0 && j < b->cols) b->near[i * b->cols + j] += delta;
+        }
+    }
+}
+
+// A window counts for a side while the other has no stone in it
+static inline int lineValue(const Board *b, int w) {
+    int x = b->lines[0][w], o = b->lines[1][w];
+    return o == 0 ? geometry.weight[x] : x == 0 ? -geometry.weight[o] : 0;
+}
+
+static inline void updateLines(Board *b, int side, int c, int delta) {
+    for (int i = geometry.cellLine[c]; i < geometry.cellLine[c + 1]; i++) {
+        int w = geometry.line[i];
+        b->score -= lineValue(b, w);
+        b->lines[side][w] += delta;
+        b->score += lineValue(b, w);
+    }
+}
+
+// Just the stone, for players that read nothing but the bitboards; the
+// board's search fields go stale until it is emptied again
+static inline void setStone(Board *b, int side, int c) {
+    b->side[side][c >> 6] |= 1ULL << (c & 63);
+    b->moves++;
+}
+
+static inline void clearStone(Board *b, int side, int c) {
+    b->side[side][c >> 6] &= ~(1ULL << (c & 63));
+    b->moves--;
+}
+
+static inline void placeStone(Board *b, int side, int c) {
+    setStone(b, side, c);
+    updateNear(b, c, 1);
+    updateLines(b, side, c, 1);
+}
+
+static inline void removeStone(Board *b, int side, int c) {
+    clearStone(b, side, c);
+    updateNear(b, c, -1);
+    updateLines(b, side, c, -1);
+}
+
+// Stones of `side` in a row from cell (r, col), not counting it, up to max
+static inline int runLength(const Board *b, int side, int r, int col, int dr, int dc, int max) {
+    int n = 0;
+    for (r += dr, col += dc; n < max && r >= 0 && r < b->rows && col >= 0 && col < b->cols;
+         r += dr, col += dc, n++) {
+        if (!stoneAt(b, side, r * b->cols + col)) break;
+    }
+    return n;
+}
+
+// Does the stone of `side` on cell c complete K in a row?
+static int winsThrough(const Board *b, int side, int c) {
+    int r = c / b->cols, col = c % b->cols, need = b->k - 1;
+    for (int d = 0; d < 4; d++) {
+        int n = runLength(b, side, r, col, DIRS[d][0], DIRS[d][1], need);
+        if (n < need) n += runLength(b, side, r, col, -DIRS[d][0], -DIRS[d][1], need - n);
+        if (n >= need) return 1;
+    }
+    return 0;
+}
+
+// ------------------ Search ------------------
+// Negamax with alpha-beta and iterative deepening under a time budget. A win
+// scores WIN - (stones on the board) so faster wins and slower losses are
+// preferred; at the depth limit a position scores its K-windows (see
+// lineValue()). Moves are tried after the table's best move in a fixed
+// order, cells on the most K-lines first, and only cells within NEAR of a
+// stone are tried.
+//
+// Lazy SMP: every thread runs its own iterative deepening on the same root,
+// helpers starting one ply deeper on odd ids and trying root moves in a
+// rotated order, so they fill the shared transposition table with results
+// the others then cut on. The table is lock-free: an entry stores key ^ data
+// next to data, and a torn write simply fails the key check on probe.
+#define WIN (1 << 30)
+#define TT_BITS 20
+#define MAX_THREADS 64
+#define DEFAULT_SECONDS 1.0
+
+enum { TT_EMPTY, TT_EXACT, TT_LOWER, TT_UPPER };
+
+typedef struct {
+    uint64_t check;     // key ^ data
+    uint64_t data;      // score:32, move:16, depth:8, flag:8
+} TTEntry;
+
+struct SearchLimits {
+    int threads;
+    int maxDepth;       // 0 for no limit but the game's end
+    double seconds;     // 0 for no time limit
+};
+
+typedef struct {
+    int move, score, depth;
+    unsigned long long nodes;
+    double seconds;
+} SearchResult;
+
+typedef struct {
+    Board board;
+    int id, side, maxDepth;
+    unsigned long long nodes;
+    int move, score, depth;     // deepest completed iteration
+} SearchThread;
+
+static uint64_t zobrist[2][MAX_CELLS];
+static TTEntry *table;         // allocated by the first search
+static int order[MAX_CELLS];
+static volatile int stopSearch;
+static double searchDeadline;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define loadRelaxed(p)     __atomic_load_n(p, __ATOMIC_RELAXED)
+#define storeRelaxed(p, v) __atomic_store_n(p, v, __ATOMIC_RELAXED)
+#else
+#define loadRelaxed(p)     (*(p))
+#define storeRelaxed(p, v) (*(p) = (v))
+#endif
+
+static double nowSeconds() {
+#ifndef _WIN32
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+int defaultThreads() {
+#ifdef _SC_NPROCESSORS_ONLN
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n > 0) return n < MAX_THREADS ? (int)n : MAX_THREADS;
+#endif
+    return 1;
+}
+
+static uint64_t splitmix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static void clearTable() {
+    if (table) {
+        memset(table, 0, sizeof(TTEntry) << TT_BITS);
+    } else if (!(table = calloc((size_t)1 << TT_BITS, sizeof(TTEntry)))) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+}
+
+void initEngine(const Board *b) {
+    static int weight[MAX_CELLS];
+    uint64_t seed = 0x7469637461637465ULL;
+    for (int s = 0; s < 2; s++) {
+        for (int c = 0; c < MAX_CELLS; c++) zobrist[s][c] = splitmix64(&seed);
+    }
+    clearTable();
+
+    // Insertion sort by lines through the cell, then closeness to the center
+    for (int c = 0; c < b->cells; c++) {
+        int dr = 2 * (c / b->cols) - (b->rows - 1), dc = 2 * (c % b->cols) - (b->cols - 1);
+        int w = (geometry.cellLine[c + 1] - geometry.cellLine[c]) * 4 * MAX_CELLS - (dr * dr + dc * dc), i = c;
+        for (; i > 0 && weight[i - 1] < w; i--) {
+            weight[i] = weight[i - 1];
+            order[i] = order[i - 1];
+        }
+        weight[i] = w;
+        order[i] = c;
+    }
+}
+
+static uint64_t boardKey(const Board *b) {
+    uint64_t key = 0;
+    for (int c = 0; c < b->cells; c++) {
+        if (stoneAt(b, 0, c)) key ^= zobrist[0][c];
+        if (stoneAt(b, 1, c)) key ^= zobrist[1][c];
+    }
+    return key;
+}
+
+static int ttProbe(uint64_t key, int *score, int *move, int *depth, int *flag) {
+    const TTEntry *e = &table[key & ((1 << TT_BITS) - 1)];
+    uint64_t data = loadRelaxed(&e->data), check = loadRelaxed(&e->check);
+    if ((check ^ data) != key || !data) return 0;
+    *score = (int32_t)(uint32_t)data;
+    *move = (int16_t)(data >> 32);
+    *depth = (int)(data >> 48 & 0xFF);
+    *flag = (int)(data >> 56);
+    return 1;
+}
+
+static void ttStore(uint64_t key, int score, int move, int depth, int flag) {
+    TTEntry *e = &table[key & ((1 << TT_BITS) - 1)];
+    uint64_t data = (uint32_t)score | (uint64_t)(uint16_t)move << 32 |
+                    (uint64_t)(depth > 255 ? 255 : depth) << 48 | (uint64_t)flag << 56;
+    storeRelaxed(&e->data, data);
+    storeRelaxed(&e->check, key ^ data);
+}
+
+// Cells worth trying, best first; the first stone goes to order[0]
+static int candidates(const Board *b, int ttMove, int *moves) {
+    int n = 0;
+    if (b->moves == 0) {
+        moves[n++] = order[0];
+        return n;
+    }
+    if (ttMove >= 0 && ttMove < b->cells && isEmpty(b, ttMove)) moves[n++] = ttMove;
+    else ttMove = -1;
+    for (int i = 0; i < b->cells; i++) {
+        int c = order[i];
+        if (b->near[c] && c != ttMove && isEmpty(b, c)) moves[n++] = c;
+    }
+    return n;
+}
+
+// Score for `side` to move; the opponent has just played lastMove. Returns 0
+// once the search is stopped, and nothing is stored from then on.
+static int negamax(SearchThread *t, int side, uint64_t key, int lastMove, int depth, int alpha, int beta) {
+    Board *b = &t->board;
+    if ((++t->nodes & 1023) == 0) {
+        if (t->id == 0 && searchDeadline > 0 && nowSeconds() >= searchDeadline) storeRelaxed(&stopSearch, 1);
+        if (loadRelaxed(&stopSearch)) return 0;
+    }
+    if (lastMove >= 0 && winsThrough(b, side ^ 1, lastMove)) return -(WIN - b->moves);
+    if (b->moves == b->cells) return 0;
+    if (depth == 0) return side ? -b->score : b->score;
+
+    int ttScore, ttMove = -1, ttDepth, flag;
+    if (ttProbe(key, &ttScore, &ttMove, &ttDepth, &flag) && ttDepth >= depth) {
+        if (flag == TT_EXACT) return ttScore;
+        if (flag == TT_LOWER && ttScore >= beta) return ttScore;
+        if (flag == TT_UPPER && ttScore <= alpha) return ttScore;
+    }
+
+    int moves[MAX_CELLS];
+    int count = candidates(b, ttMove, moves);
+    int alphaIn = alpha, best = -WIN - 1, bestMove = -1;
+    for (int i = 0; i < count; i++) {
+        int c = moves[i];
+        placeStone(b, side, c);
+        int score = -negamax(t, side ^ 1, key ^ zobrist[side][c], c, depth - 1, -beta, -alpha);
+        removeStone(b, side, c);
+        if (loadRelaxed(&stopSearch)) return 0;
+        if (score > best) {
+            best = score;
+            bestMove = c;
+        }
+        if (best > alpha) alpha = best;
+        if (alpha >= beta) break;
+    }
+
+    ttStore(key, best, bestMove, depth, best <= alphaIn ? TT_UPPER : best >= beta ? TT_LOWER : TT_EXACT);
+    return best;
+}
+
+// One iteration at the root; 0 if the search was stopped before it finished
+static int searchRoot(SearchThread *t, int depth) {
+    Board *b = &t->board;
+    int moves[MAX_CELLS], ttScore, ttMove = -1, ttDepth, flag;
+    uint64_t key = boardKey(b);
+    ttProbe(key, &ttScore, &ttMove, &ttDepth, &flag);
+    int count = candidates(b, ttMove, moves);
+
+    // Helpers keep the table's move first and rotate the rest
+    if (t->id > 0 && count > 2) {
+        int shift = 1 + (t->id - 1) % (count - 1), rotated[MAX_CELLS];
+        for (int i = 1; i < count; i++) rotated[i] = moves[1 + (i - 1 + shift) % (count - 1)];
+        memcpy(moves + 1, rotated + 1, sizeof(int) * (count - 1));
+    }
+
+    int best = -WIN - 1, move = -1;
+    for (int i = 0; i < count; i++) {
+        int c = moves[i];
+        placeStone(b, t->side, c);
+        int s = -negamax(t, t->side ^ 1, key ^ zobrist[t->side][c], c, depth - 1, -WIN - 1, -best);
+        removeStone(b, t->side, c);
+        if (loadRelaxed(&stopSearch)) return 0;
+        if (s > best) {
+            best = s;
+            move = c;
+        }
+    }
+    ttStore(key, best, move, depth, TT_EXACT);
+    t->move = move;
+    t->score = best;
+    t->depth = depth;
+    return 1;
+}
+
+static void *searchWorker(void *arg) {
+    SearchThread *t = arg;
+    for (int depth = 1 + (t->id & 1); !loadRelaxed(&stopSearch); depth++) {
+        if (depth > t->maxDepth) depth = t->maxDepth;
+        if (!searchRoot(t, depth)) break;
+
+        // The main thread decides when the search is over
+        if (t->id == 0 && (depth >= t->maxDepth || t->score >= WIN - MAX_CELLS || t->score <= -WIN + MAX_CELLS)) {
+            storeRelaxed(&stopSearch, 1);
+        }
+    }
+    return NULL;
+}
+
+// Best cell for `side` within the limits
+SearchResult bestMove(const Board *pos, int side, const SearchLimits *limits) {
+    static SearchThread threads[MAX_THREADS];
+    int count = limits->threads < 1 ? 1 : limits->threads > MAX_THREADS ? MAX_THREADS : limits->threads;
+    int empty = pos->cells - pos->moves;
+    double t0 = nowSeconds();
+    SearchResult r;
+
+    stopSearch = 0;
+    searchDeadline = limits->seconds > 0 ? t0 + limits->seconds : 0;
+    for (int i = 0; i < count; i++) {
+        threads[i].board = *pos;
+        threads[i].id = i;
+        threads[i].side = side;
+        threads[i].maxDepth = limits->maxDepth > 0 && limits->maxDepth < empty ? limits->maxDepth : empty;
+        threads[i].nodes = 0;
+        threads[i].move = threads[i].depth = -1;
+        threads[i].score = 0;
+    }
+#ifndef _WIN32
+    pthread_t tid[MAX_THREADS];
+    int started = 0;
+    for (int i = 1; i < count; i++) {
+        if (pthread_create(&tid[i], NULL, searchWorker, &threads[i]) != 0) break;
+        started = i;
+    }
+    searchWorker(&threads[0]);
+    for (int i = 1; i <= started; i++) pthread_join(tid[i], NULL);
+    count = started + 1;
+#else
+    count = 1;
+    searchWorker(&threads[0]);
+#endif
+
+    // If time ran out during the first iteration, take the first candidate
+    r.move = threads[0].move;
+    r.score = threads[0].score;
+    r.depth = threads[0].depth;
+    if (r.move < 0) {
+        int moves[MAX_CELLS];
+        candidates(pos, -1, moves);
+        r.move = moves[0];
+        r.depth = 0;
+    }
+    r.nodes = 0;
+    for (int i = 0; i < count; i++) r.nodes += threads[i].nodes;
+    r.seconds = nowSeconds() - t0;
+    return r;
+}
+
+// Leaf positions `depth` plies below b, stopping at finished games; every
+// empty cell is a move here, not just the ones near a stone
+static unsigned long long perft(Board *b, int side, int lastMove, int depth) {
+    if (lastMove >= 0 && winsThrough(b, side ^ 1, lastMove)) return 1;
+    if (depth == 0 || b->moves == b->cells) return 1;
+    unsigned long long nodes = 0;
+    for (int w = 0; w * 64 < b->cells; w++) {
+        uint64_t empty = ~(b->side[0][w] | b->side[1][w]);
+        if (b->cells - w * 64 < 64) empty &= (1ULL << (b->cells - w * 64)) - 1;
+        while (empty) {
+            int c = w * 64 + lowestBit(empty);
+            empty &= empty - 1;
+            b->side[side][w] |= 1ULL << (c & 63);
+            b->moves++;
+            nodes += perft(b, side ^ 1, c, depth - 1);
+            b->moves--;
+            b->side[side][w] &= ~(1ULL << (c & 63));
+        }
+    }
+    return nodes;
+}
+
+int runPerft(const Board *start, int maxDepth, const SearchLimits *limits) {
+    static Board b;
+    b = *start;
+    printf(" %dx%d, K = %d\n", b.rows, b.cols, b.k);
+    printf(" Depth        Leaves      Seconds\n");
+    for (int d = 1; d <= maxDepth; d++) {
+        double t0 = nowSeconds();
+        unsigned long long n = perft(&b, 0, -1, d);
+        printf(" %5d  %12llu  %11.6f\n", d, n, nowSeconds() - t0);
+    }
+
+    // Choosing the first move from a cold table
+    initEngine(&b);
+    SearchResult r = bestMove(&b, 0, limits);
+    printf("\n Search (depth %d): move %d, score %d, %llu nodes, %.6f s\n",
+           r.depth, r.move + 1, r.score, r.nodes, r.seconds);
+    return 0;
+}
+
+// Time to reach a fixed depth from the same position with 1, 2, 4, ...
+// threads, each run from a cold table
+int runSearchBench(const Board *start, int depth, int maxThreads) {
+    static Board b;
+    b = *start;
+    initEngine(&b);
+
+    // A few stones around the center so the search has something to read
+    static const int OPENING[][2] = { { 0, 0 }, { 1, 1 }, { 0, 1 }, { -1, 0 } };
+    int r0 = b.rows / 2, c0 = b.cols / 2, side = 0;
+    for (int i = 0; i < 4 && b.moves + 2 < b.cells; i++, side ^= 1) {
+        int r = r0 + OPENING[i][0], c = c0 + OPENING[i][1];
+        if (r >= 0 && r < b.rows && c >= 0 && c < b.cols && isEmpty(&b, r * b.cols + c)) {
+            placeStone(&b, side, r * b.cols + c);
+        }
+    }
+    if (depth > b.cells - b.moves) depth = b.cells - b.moves;
+
+    printf(" %dx%d, K = %d, %d stones placed, depth %d\n", b.rows, b.cols, b.k, b.moves, depth);
+    printf(" Threads  Move   Seconds           Nodes      Knodes/s   Speedup\n");
+    double base = 0;
+    for (int n = 1; ; n = n * 2 > maxThreads && n < maxThreads ? maxThreads : n * 2) {
+        if (n > maxThreads) break;
+        SearchLimits limits = { n, depth, 0 };
+        clearTable();
+        SearchResult r = bestMove(&b, side, &limits);
+        if (n == 1) base = r.seconds;
+        printf(" %7d  %4d  %8.3f  %14llu  %12.0f  %7.2fx\n", n, r.move + 1, r.seconds, r.nodes,
+               r.nodes / (r.seconds > 0 ? r.seconds : 1e-9) / 1000, base / (r.seconds > 0 ? r.seconds : 1e-9));
+        if (n == maxThreads) break;
+    }
+    return 0;
+}
+
+// ------------------ Perfect-play table ------------------
+// Every 3x3 position reachable in play that is not over yet (4520 of them),
+// with its best move and value, generated by --gen-table into
+// tictactoe_table.h. The key is X's mask | O's mask << 9. It is found with a
+// minimal perfect hash (hash and displace): a first hash picks a bucket, the
+// bucket's displacement picks a second hash, and that one lands every key
+// of the bucket on its own slot. Only the move and value are stored, one
+// byte per position, so the table takes under 7 KB of read-only data and
+// a lookup is two hashes and two loads.
+#if defined(__has_include)
+#if __has_include("tictactoe_table.h")
+#include "tictactoe_table.h"
+#define HAVE_PLAY_TABLE 1
+#endif
+#endif
+
+#define PLAY_TABLE_BUCKETS 1130
+
+enum { PLAY_DRAW, PLAY_WIN, PLAY_LOSS };    // for the side to move
+
+static inline uint32_t tableHash(uint32_t key, uint32_t seed) {
+    uint32_t h = (key ^ (seed * 0x85EBCA6Bu)) * 0x9E3779B1u;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    return h ^ (h >> 12);
+}
+
+// h scaled onto [0, n)
+static inline uint32_t tableReduce(uint32_t h, uint32_t n) {
+    return (uint32_t)(((uint64_t)h * n) >> 32);
+}
+
+static inline uint32_t tableSlot(uint32_t key, const uint16_t *displace, uint32_t buckets, uint32_t slots) {
+    uint32_t bucket = tableReduce(tableHash(key, 0), buckets);
+    return tableReduce(tableHash(key, displace[bucket] + 1u), slots);
+}
+
+static inline int isClassicBoard(const Board *b) {
+    return b->rows == 3 && b->cols == 3 && b->k == 3;
+}
+
+static inline uint32_t boardKey9(const Board *b) {
+    return (uint32_t)b->side[0][0] | (uint32_t)b->side[1][0] << 9;
+}
+
+static uint8_t perfectPlay(uint32_t key);
+
+// Table move for a 3x3 position, or -1 without a table
+static int tableMove(const Board *b, int *value) {
+#ifdef HAVE_PLAY_TABLE
+    uint8_t play = perfectPlay(boardKey9(b));
+    if (value) *value = play >> 4;
+    return play & 15;
+#else
+    (void)b;
+    (void)value;
+    return -1;
+#endif
+}
+
+// Exact best move of a 3x3 position (searched without a depth limit) and
+// its value for the side to move
+static int solvePosition(SearchThread *t, int side, int *value) {
+    uint64_t key = boardKey(&t->board);
+    int best = -WIN - 1, move = -1;
+    for (int c = 0; c < 9; c++) {
+        int cell = order[c];
+        if (!isEmpty(&t->board, cell)) continue;
+        placeStone(&t->board, side, cell);
+        int s = -negamax(t, side ^ 1, key ^ zobrist[side][cell], cell, 9, -WIN - 1, WIN + 1);
+        removeStone(&t->board, side, cell);
+        if (s > best) {
+            best = s;
+            move = cell;
+        }
+    }
+    *value = best > 0 ? PLAY_WIN : best < 0 ? PLAY_LOSS : PLAY_DRAW;
+    return move;
+}
+
+// Every unfinished position reachable from the current one
+static void collectPositions(Board *b, int side, int lastMove, uint8_t *seen, uint32_t *keys, int *count) {
+    if (lastMove >= 0 && winsThrough(b, side ^ 1, lastMove)) return;
+    if (b->moves == 9) return;
+    uint32_t key = boardKey9(b);
+    if (seen[key]) return;
+    seen[key] = 1;
+    keys[(*count)++] = key;
+    for (int c = 0; c < 9; c++) {
+        if (!isEmpty(b, c)) continue;
+        placeStone(b, side, c);
+        collectPositions(b, side ^ 1, c, seen, keys, count);
+        removeStone(b, side, c);
+    }
+}
+
+// Solve every unfinished position reachable from the empty board, filling
+// keys with their keys and play with their table bytes; returns the count
+static int solveAllPositions(uint32_t *keys, uint8_t *play, unsigned long long *nodes) {
+    static SearchThread solver;
+    static uint8_t seen[1 << 18];
+    int count = 0;
+
+    initBoard(&solver.board, 3, 3, 3);
+    initEngine(&solver.board);
+    stopSearch = 0;
+    searchDeadline = 0;
+    solver.nodes = 0;
+    memset(seen, 0, sizeof(seen));
+    collectPositions(&solver.board, 0, -1, seen, keys, &count);
+
+    for (int i = 0; i < count; i++) {
+        int value;
+        for (int c = 0; c < 9; c++) {
+            if (keys[i] >> c & 1) placeStone(&solver.board, 0, c);
+            if (keys[i] >> (9 + c) & 1) placeStone(&solver.board, 1, c);
+        }
+        int move = solvePosition(&solver, solver.board.moves & 1, &value);
+        play[i] = (uint8_t)(move | value << 4);
+        for (int c = 0; c < 9; c++) {
+            if (keys[i] >> c & 1) removeStone(&solver.board, 0, c);
+            if (keys[i] >> (9 + c) & 1) removeStone(&solver.board, 1, c);
+        }
+    }
+    *nodes = solver.nodes;
+    return count;
+}
 
-int main() {
-    char board[3][3] = { {'1','2','3'}, {'4','5','6'}, {'7','8','9'} };
-    char currentPlayer = 'X';
+// Table byte of an unfinished 3x3 position: from the generated table, or
+// else from positions solved on first use
+static uint8_t perfectPlay(uint32_t key) {
+#ifdef HAVE_PLAY_TABLE
+    return PLAY_TABLE[tableSlot(key, PLAY_TABLE_DISPLACE, PLAY_TABLE_BUCKETS, PLAY_TABLE_POSITIONS)];
+#else
+    static uint8_t *byKey;
+    if (!byKey) {
+        static uint32_t keys[1 << 13];
+        static uint8_t play[1 << 13];
+        unsigned long long nodes;
+        uint8_t *table = calloc(1 << 18, 1);
+        if (!table) {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+        int count = solveAllPositions(keys, play, &nodes);
+        for (int i = 0; i < count; i++) table[keys[i]] = play[i];
+        byKey = table;
+    }
+    return byKey[key];
+#endif
+}
+
+// Solve every position, build the perfect hash and write it as a header
+int runGenerateTable(const char *path) {
+    static uint32_t keys[1 << 13], bucketKeys[PLAY_TABLE_BUCKETS][32];
+    static uint8_t play[1 << 13], slotPlay[1 << 13], used[1 << 13];
+    static uint16_t displace[PLAY_TABLE_BUCKETS];
+    static int bucketSize[PLAY_TABLE_BUCKETS], byBucket[PLAY_TABLE_BUCKETS];
+    unsigned long long nodes;
+
+    double t0 = nowSeconds();
+    int count = solveAllPositions(keys, play, &nodes);
+    double t1 = nowSeconds();
+
+    // Hash and displace: the biggest buckets are placed first
+    for (int i = 0; i < count; i++) {
+        uint32_t b = tableReduce(tableHash(keys[i], 0), PLAY_TABLE_BUCKETS);
+        if (bucketSize[b] == 32) {
+            printf("Bucket overflow; change tableHash()\n");
+            return 1;
+        }
+        bucketKeys[b][bucketSize[b]++] = (uint32_t)i;
+    }
+    for (int b = 0; b < PLAY_TABLE_BUCKETS; b++) {
+        int i = b;
+        for (; i > 0 && bucketSize[byBucket[i - 1]] < bucketSize[b]; i--) byBucket[i] = byBucket[i - 1];
+        byBucket[i] = b;
+    }
+    for (int n = 0; n < PLAY_TABLE_BUCKETS && bucketSize[byBucket[n]] > 0; n++) {
+        int b = byBucket[n], size = bucketSize[b];
+        uint32_t slots[32];
+        uint32_t d = 0;
+        for (; d < 65535; d++) {
+            int ok = 1;
+            for (int j = 0; j < size && ok; j++) {
+                slots[j] = tableReduce(tableHash(keys[bucketKeys[b][j]], d + 1), (uint32_t)count);
+                if (used[slots[j]]) ok = 0;
+                for (int i = 0; i < j && ok; i++) ok = slots[i] != slots[j];
+            }
+            if (ok) break;
+        }
+        if (d == 65535) {
+            printf("No displacement found for bucket %d\n", b);
+            return 1;
+        }
+        displace[b] = (uint16_t)d;
+        for (int j = 0; j < size; j++) {
+            used[slots[j]] = 1;
+            slotPlay[slots[j]] = play[bucketKeys[b][j]];
+        }
+    }
+
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        printf("Cannot write %s\n", path);
+        return 1;
+    }
+    fprintf(out, "// tictactoe_table.h\n"
+                 "// Perfect play for every unfinished 3x3 position, indexed by the\n"
+                 "// minimal perfect hash in tictactoe.c (tableSlot()). Each byte is\n"
+                 "// move (0-8) | value << 4 (0 draw, 1 win, 2 loss for the side to move).\n"
+                 "// Generated by ./tictactoe --gen-table; do not edit.\n\n");
+    fprintf(out, "#define PLAY_TABLE_POSITIONS %d\n\n", count);
+    fprintf(out, "static const uint16_t PLAY_TABLE_DISPLACE[%d] = {", PLAY_TABLE_BUCKETS);
+    for (int b = 0; b < PLAY_TABLE_BUCKETS; b++) fprintf(out, "%s%u,", b % 12 ? " " : "\n    ", displace[b]);
+    fprintf(out, "\n};\n\nstatic const uint8_t PLAY_TABLE[%d] = {", count);
+    for (int i = 0; i < count; i++) fprintf(out, "%s0x%02x,", i % 12 ? " " : "\n    ", slotPlay[i]);
+    fprintf(out, "\n};\n");
+    int ok = fclose(out) == 0;
+
+    // Read the table back through the hash to check every position
+    int wrong = 0;
+    for (int i = 0; i < count; i++) {
+        uint32_t s = tableSlot(keys[i], displace, PLAY_TABLE_BUCKETS, (uint32_t)count);
+        wrong += slotPlay[s] != play[i];
+    }
+    printf(" %d positions solved in %.3f s (%llu nodes); %d-byte table + %d-byte displacements%s\n",
+           count, t1 - t0, nodes, count, (int)sizeof(displace), wrong ? "" : ", verified");
+    printf(" Wrote %s\n", path);
+    return ok && !wrong ? 0 : 1;
+}
+
+// ------------------ Game records ------------------
+// 3x3 games are appended to a record file: an 8-byte "TTTREC01" header, then
+// one 5-byte record per game, the move count in the low nibble and move i
+// (cell 0-8) in nibble i + 1, little-endian. Every record has the same size,
+// so a file splits into chunks at any multiple of 5 bytes and --analyze
+// replays the chunks on separate threads straight from the mapped file.
+#define RECORD_BYTES 5
+#define RECORD_BATCH 4096       // records buffered before a write
+#define DEFAULT_RECORDS "tictactoe.rec"
+
+static const char RECORD_MAGIC[8] = { 'T', 'T', 'T', 'R', 'E', 'C', '0', '1' };
+
+typedef struct {
+    FILE *out;
+#ifndef _WIN32
+    pthread_mutex_t lock;       // batches from several threads
+#endif
+} RecordFile;
+
+static void encodeRecord(uint8_t *out, const int *moves, int n) {
+    uint64_t v = (uint64_t)n;
+    for (int i = 0; i < n; i++) v |= (uint64_t)moves[i] << (4 + 4 * i);
+    for (int i = 0; i < RECORD_BYTES; i++) out[i] = (uint8_t)(v >> (8 * i));
+}
+
+int recordOpen(RecordFile *f, const char *path) {
+    f->out = fopen(path, "ab");
+    if (!f->out) return -1;
+    if (ftell(f->out) == 0 && fwrite(RECORD_MAGIC, sizeof(RECORD_MAGIC), 1, f->out) != 1) {
+        fclose(f->out);
+        return -1;
+    }
+#ifndef _WIN32
+    pthread_mutex_init(&f->lock, NULL);
+#endif
+    return 0;
+}
+
+// Append `count` encoded records as one write
+static void recordWrite(RecordFile *f, const uint8_t *records, size_t count) {
+#ifndef _WIN32
+    pthread_mutex_lock(&f->lock);
+#endif
+    fwrite(records, RECORD_BYTES, count, f->out);
+    fflush(f->out);
+#ifndef _WIN32
+    pthread_mutex_unlock(&f->lock);
+#endif
+}
+
+int recordClose(RecordFile *f) {
+#ifndef _WIN32
+    pthread_mutex_destroy(&f->lock);
+#endif
+    return fclose(f->out);
+}
+
+// ------------------ Self-play ------------------
+// Headless games between random, heuristic or search players, split across
+// threads. Each thread has its own xoshiro256** generator and its own
+// counters, merged once every thread is done, and plays on one board that
+// it takes moves back from after each game instead of clearing it.
+enum { PLAYER_RANDOM, PLAYER_HEURISTIC, PLAYER_SEARCH, PLAYER_KINDS };
+
+static const char *PLAYER_NAMES[PLAYER_KINDS] = { "random", "heuristic", "search" };
+
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+typedef struct {
+    unsigned long long games;
+    unsigned long long results[3];              // X wins, O wins, draws
+    unsigned long long length[MAX_CELLS + 1];   // games by number of moves
+    unsigned long long opening[MAX_CELLS][3];   // results by X's first cell
+} SelfPlayStats;
+
+typedef struct {
+    SearchThread search;        // its board is the game board
+    Rng rng;
+    const int *players;
+    int depth, openingPlies;
+    unsigned long long games;
+    SelfPlayStats *stats;
+    RecordFile *record;         // NULL when games are not recorded
+    uint8_t *batch;             // RECORD_BATCH records waiting to be written
+    size_t pending;
+} SelfPlayJob;
+
+static inline uint64_t rotl64(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static void rngSeed(Rng *r, uint64_t seed) {
+    for (int i = 0; i < 4; i++) r->s[i] = splitmix64(&seed);
+}
+
+static inline uint64_t rngNext(Rng *r) {
+    uint64_t *s = r->s;
+    uint64_t result = rotl64(s[1] * 5, 7) * 9, t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl64(s[3], 45);
+    return result;
+}
+
+// Uniform in [0, n) for n < 2^32 (multiply-shift; the bias is below 2^-32 * n)
+static inline uint32_t rngBelow(Rng *r, uint32_t n) {
+    return (uint32_t)(((rngNext(r) >> 32) * n) >> 32);
+}
+
+static int randomMove(const Board *b, Rng *rng) {
+    uint32_t pick = rngBelow(rng, (uint32_t)(b->cells - b->moves));
+    for (int w = 0; ; w++) {
+        uint64_t empty = ~(b->side[0][w] | b->side[1][w]);
+        if (b->cells - w * 64 < 64) empty &= (1ULL << (b->cells - w * 64)) - 1;
+        uint32_t n = (uint32_t)countBits(empty);
+        if (pick < n) {
+            while (pick--) empty &= empty - 1;
+            return w * 64 + lowestBit(empty);
+        }
+        pick -= n;
+    }
+}
+
+// Change in the board score for `side` if it played c
+static int moveGain(const Board *b, int side, int c) {
+    int gain = 0;
+    for (int i = geometry.cellLine[c]; i < geometry.cellLine[c + 1]; i++) {
+        int w = geometry.line[i];
+        int x = b->lines[0][w] + (side == 0), o = b->lines[1][w] + (side == 1);
+        gain += (o == 0 ? geometry.weight[x] : x == 0 ? -geometry.weight[o] : 0) - lineValue(b, w);
+    }
+    return side ? -gain : gain;
+}
+
+// Win now, else block the opponent's win, else the cell that gains most
+// (ties broken at random)
+static int heuristicMove(const Board *b, int side, Rng *rng) {
+    int moves[MAX_CELLS], block = -1, best = -1, bestGain = 0, ties = 0;
+    int count = candidates(b, -1, moves);
+    for (int i = 0; i < count; i++) {
+        int c = moves[i];
+        if (winsThrough(b, side, c)) return c;
+        if (block < 0 && winsThrough(b, side ^ 1, c)) block = c;
+        int gain = moveGain(b, side, c);
+        if (best < 0 || gain > bestGain) {
+            best = c;
+            bestGain = gain;
+            ties = 1;
+        } else if (gain == bestGain && rngBelow(rng, (uint32_t)++ties) == 0) {
+            best = c;
+        }
+    }
+    return block >= 0 ? block : best;
+}
+
+// Iterative deepening to a fixed depth on the job's own board
+static int searchMove(SearchThread *t, int side, int depth) {
+    int empty = t->board.cells - t->board.moves;
+    t->side = side;
+    t->maxDepth = depth < empty ? depth : empty;
+    t->move = -1;
+    for (int d = 1; d <= t->maxDepth; d++) {
+        searchRoot(t, d);
+        if (t->score >= WIN - MAX_CELLS || t->score <= -WIN + MAX_CELLS) break;
+    }
+    return t->move;
+}
+
+static void *selfPlayWorker(void *arg) {
+    SelfPlayJob *job = arg;
+    Board *b = &job->search.board;
+    SelfPlayStats *st = job->stats;
+    int played[MAX_CELLS];
+    int light = job->players[0] == PLAYER_RANDOM && job->players[1] == PLAYER_RANDOM;
+
+    for (unsigned long long g = 0; g < job->games; g++) {
+        int side = 0, result = -1, n = 0;
+        while (result < 0) {
+            int kind = n < job->openingPlies ? PLAYER_RANDOM : job->players[side], c;
+            if (kind == PLAYER_RANDOM) c = randomMove(b, &job->rng);
+            else if (kind == PLAYER_HEURISTIC) c = heuristicMove(b, side, &job->rng);
+            else c = searchMove(&job->search, side, job->depth);
+            if (light) setStone(b, side, c);
+            else placeStone(b, side, c);
+            played[n++] = c;
+            if (winsThrough(b, side, c)) result = side;
+            else if (b->moves == b->cells) result = 2;
+            side ^= 1;
+        }
+        st->games++;
+        st->results[result]++;
+        st->length[n]++;
+        st->opening[played[0]][result]++;
+        if (job->record) {
+            encodeRecord(job->batch + job->pending * RECORD_BYTES, played, n);
+            if (++job->pending == RECORD_BATCH) {
+                recordWrite(job->record, job->batch, job->pending);
+                job->pending = 0;
+            }
+        }
+
+        // Take the game back so the next one starts from an empty board
+        while (n > 0) {
+            n--;
+            if (light) clearStone(b, n & 1, played[n]);
+            else removeStone(b, n & 1, played[n]);
+        }
+    }
+    if (job->record && job->pending) recordWrite(job->record, job->batch, job->pending);
+    return NULL;
+}
+
+static void printPercentages(const unsigned long long *results, unsigned long long games) {
+    double g = games ? (double)games : 1;
+    printf("X %6.2f%%  O %6.2f%%  draw %6.2f%%", 100 * results[0] / g, 100 * results[1] / g, 100 * results[2] / g);
+}
+
+int runSelfPlay(const Board *start, unsigned long long games, const int *players, int depth,
+                int openingPlies, int threads, uint64_t seed, const char *recordPath) {
+    static SelfPlayJob jobs[MAX_THREADS];
+    RecordFile record;
+    if (recordPath && !isClassicBoard(start)) {
+        printf("Only 3x3 games (K = 3) can be recorded\n");
+        return 1;
+    }
+    if (recordPath && recordOpen(&record, recordPath) != 0) {
+        printf("Cannot write %s\n", recordPath);
+        return 1;
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if ((unsigned long long)threads > games) threads = games ? (int)games : 1;
+    initEngine(start);
+    stopSearch = 0;
+    searchDeadline = 0;
+
+    for (int t = 0; t < threads; t++) {
+        jobs[t].search.board = *start;
+        jobs[t].search.id = 0;
+        jobs[t].search.nodes = 0;
+        rngSeed(&jobs[t].rng, seed + (uint64_t)t * 0x9E3779B97F4A7C15ULL);
+        jobs[t].players = players;
+        jobs[t].depth = depth;
+        jobs[t].openingPlies = openingPlies;
+        jobs[t].games = games * (t + 1) / threads - games * t / threads;
+        jobs[t].stats = calloc(1, sizeof(SelfPlayStats));
+        jobs[t].record = recordPath ? &record : NULL;
+        jobs[t].batch = recordPath ? malloc(RECORD_BATCH * RECORD_BYTES) : NULL;
+        jobs[t].pending = 0;
+        if (!jobs[t].stats || (recordPath && !jobs[t].batch)) {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+    }
+
+    double t0 = nowSeconds();
+#ifndef _WIN32
+    pthread_t tid[MAX_THREADS];
+    int started = 0;
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&tid[t], NULL, selfPlayWorker, &jobs[t]) != 0) break;
+        started = t;
+    }
+    selfPlayWorker(&jobs[0]);
+    for (int t = started + 1; t < threads; t++) selfPlayWorker(&jobs[t]);
+    for (int t = 1; t <= started; t++) pthread_join(tid[t], NULL);
+#else
+    for (int t = 0; t < threads; t++) selfPlayWorker(&jobs[t]);
+#endif
+    double seconds = nowSeconds() - t0;
+    for (int t = 0; t < threads; t++) free(jobs[t].batch);
+    if (recordPath && recordClose(&record) != 0) printf("Error writing %s\n", recordPath);
+
+    // Merge the per-thread counters
+    SelfPlayStats *all = jobs[0].stats;
+    unsigned long long nodes = jobs[0].search.nodes;
+    for (int t = 1; t < threads; t++) {
+        const SelfPlayStats *st = jobs[t].stats;
+        all->games += st->games;
+        for (int r = 0; r < 3; r++) all->results[r] += st->results[r];
+        for (int n = 0; n <= start->cells; n++) all->length[n] += st->length[n];
+        for (int c = 0; c < start->cells; c++) {
+            for (int r = 0; r < 3; r++) all->opening[c][r] += st->opening[c][r];
+        }
+        nodes += jobs[t].search.nodes;
+        free(jobs[t].stats);
+    }
+
+    printf(" %dx%d, K = %d: %s (X) vs %s (O)", start->rows, start->cols, start->k,
+           PLAYER_NAMES[players[0]], PLAYER_NAMES[players[1]]);
+    if (players[0] == PLAYER_SEARCH || players[1] == PLAYER_SEARCH) printf(", search depth %d", depth);
+    if (openingPlies > 0) printf(", %d random opening plies", openingPlies);
+    printf("\n %llu games on %d threads in %.3f s: %.0f games/s", all->games, threads, seconds,
+           all->games / (seconds > 0 ? seconds : 1e-9));
+    if (nodes) printf(", %llu search nodes", nodes);
+    printf("\n Results:  ");
+    printPercentages(all->results, all->games);
+
+    // Game lengths, in buckets of several lengths on large boards
+    int bucket = (start->cells + 31) / 32;
+    double mean = 0;
+    printf("\n\n Moves      Games\n");
+    for (int lo = 1; lo <= start->cells; lo += bucket) {
+        unsigned long long n = 0;
+        for (int m = lo; m < lo + bucket && m <= start->cells; m++) {
+            n += all->length[m];
+            mean += (double)m * all->length[m];
+        }
+        if (!n) continue;
+        if (bucket == 1) printf(" %5d", lo);
+        else printf(" %3d-%-3d", lo, lo + bucket - 1 < start->cells ? lo + bucket - 1 : start->cells);
+        printf("  %6.2f%%\n", 100.0 * n / (all->games ? all->games : 1));
+    }
+    printf(" Mean length %.2f moves\n", mean / (all->games ? all->games : 1));
+
+    // Openings by how often X goes on to win; the ten best on large boards
+    int cells[MAX_CELLS], count = 0;
+    for (int c = 0; c < start->cells; c++) {
+        if (!all->opening[c][0] && !all->opening[c][1] && !all->opening[c][2]) continue;
+        double rate = (double)all->opening[c][0] / (all->opening[c][0] + all->opening[c][1] + all->opening[c][2]);
+        int i = count++;
+        for (; i > 0; i--) {
+            const unsigned long long *o = all->opening[cells[i - 1]];
+            if ((double)o[0] / (o[0] + o[1] + o[2]) >= rate) break;
+            cells[i] = cells[i - 1];
+        }
+        cells[i] = c;
+    }
+    if (count > 25) count = 10;
+    printf("\n First move        Games  Results\n");
+    for (int i = 0; i < count; i++) {
+        const unsigned long long *o = all->opening[cells[i]];
+        printf(" %10d  %11llu  ", cells[i] + 1, o[0] + o[1] + o[2]);
+        printPercentages(o, o[0] + o[1] + o[2]);
+        printf("\n");
+    }
+    free(all);
+    return 0;
+}
+
+int playerFind(const char *name) {
+    for (int i = 0; i < PLAYER_KINDS; i++) {
+        if (strcmp(PLAYER_NAMES[i], name) == 0) return i;
+    }
+    return -1;
+}
+
+// ------------------ Record analysis ------------------
+// Each move is judged by the value of the position it leaves against the
+// value of the one it was played in, both from the perfect-play table.
+enum { BLUNDER_WIN_TO_DRAW, BLUNDER_WIN_TO_LOSS, BLUNDER_DRAW_TO_LOSS, BLUNDER_KINDS };
+
+static const char *BLUNDER_NAMES[BLUNDER_KINDS] = { "win -> draw", "win -> loss", "draw -> loss" };
+
+typedef struct {
+    unsigned long long games, bad, moves;
+    unsigned long long results[3];              // X wins, O wins, draws
+    unsigned long long blunders[2][BLUNDER_KINDS];
+    unsigned long long byPly[9], movesAtPly[9];
+    unsigned long long flawed[2];               // games where the side blundered
+} AnalysisStats;
+
+typedef struct {
+    const uint8_t *data;
+    size_t begin, end;          // records
+    const Board *empty;         // empty 3x3 board, set up before the threads start
+    AnalysisStats stats;
+} AnalysisJob;
+
+static void *analysisWorker(void *arg) {
+    AnalysisJob *job = arg;
+    AnalysisStats *st = &job->stats;
+    Board b = *job->empty;      // initBoard() would rewrite the shared geometry
+
+    for (size_t r = job->begin; r < job->end; r++) {
+        const uint8_t *p = job->data + r * RECORD_BYTES;
+        uint64_t v = p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24 | (uint64_t)p[4] << 32;
+        int n = (int)(v & 15), result = -1, flawed[2] = { 0, 0 }, i;
+        int8_t kinds[9];        // blunder kind of each move, counted once the record checks out
+        if (n > 9) {
+            st->bad++;
+            continue;
+        }
+        b.side[0][0] = b.side[1][0] = 0;
+        b.moves = 0;
+        for (i = 0; i < n && result < 0; i++) {
+            int side = i & 1, c = (int)(v >> (4 + 4 * i) & 15);
+            if (c > 8 || !isEmpty(&b, c)) break;
+            int before = perfectPlay(boardKey9(&b)) >> 4, after;
+            setStone(&b, side, c);
+            if (winsThrough(&b, side, c)) {
+                result = side;
+                after = PLAY_WIN;
+            } else if (b.moves == 9) {
+                result = 2;
+                after = PLAY_DRAW;
+            } else {
+                // The opponent's value, turned round
+                int next = perfectPlay(boardKey9(&b)) >> 4;
+                after = next == PLAY_WIN ? PLAY_LOSS : next == PLAY_LOSS ? PLAY_WIN : PLAY_DRAW;
+            }
+            int kind = before == PLAY_WIN ? (after == PLAY_DRAW ? BLUNDER_WIN_TO_DRAW :
+                                             after == PLAY_LOSS ? BLUNDER_WIN_TO_LOSS : -1)
+                     : before == PLAY_DRAW && after == PLAY_LOSS ? BLUNDER_DRAW_TO_LOSS : -1;
+            kinds[i] = (int8_t)kind;
+            if (kind >= 0) flawed[side] = 1;
+        }
+
+        // A record must hold a whole game and nothing after its end
+        if (i < n || result < 0) {
+            st->bad++;
+            continue;
+        }
+        for (i = 0; i < n; i++) {
+            st->movesAtPly[i]++;
+            if (kinds[i] >= 0) {
+                st->blunders[i & 1][kinds[i]]++;
+                st->byPly[i]++;
+            }
+        }
+        st->games++;
+        st->moves += (unsigned long long)n;
+        st->results[result]++;
+        st->flawed[0] += (unsigned long long)flawed[0];
+        st->flawed[1] += (unsigned long long)flawed[1];
+    }
+    return NULL;
+}
+
+int runAnalyze(const char *path, int threads) {
+    static AnalysisJob jobs[MAX_THREADS];
+    const uint8_t *data = NULL;
+    size_t size = 0;
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        printf("Cannot read %s\n", path);
+        if (fd >= 0) close(fd);
+        return 1;
+    }
+    size = (size_t)st.st_size;
+    if (size > 0) {
+        void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            printf("Cannot map %s\n", path);
+            close(fd);
+            return 1;
+        }
+        data = map;
+#ifdef MADV_SEQUENTIAL
+        madvise(map, size, MADV_SEQUENTIAL);
+#endif
+    }
+    close(fd);
+#else
+    FILE *in = fopen(path, "rb");
+    uint8_t *buf = NULL;
+    if (!in) {
+        printf("Cannot read %s\n", path);
+        return 1;
+    }
+    fseek(in, 0, SEEK_END);
+    size = (size_t)ftell(in);
+    fseek(in, 0, SEEK_SET);
+    if (size > 0 && (!(buf = malloc(size)) || fread(buf, 1, size, in) != size)) size = 0;
+    fclose(in);
+    data = buf;
+#endif
+    if (size < sizeof(RECORD_MAGIC) || memcmp(data, RECORD_MAGIC, sizeof(RECORD_MAGIC)) != 0) {
+        printf("%s is not a game record file\n", path);
+#ifndef _WIN32
+        if (size > 0) munmap((void *)data, size);
+#else
+        free(buf);
+#endif
+        return 1;
+    }
+    size_t records = (size - sizeof(RECORD_MAGIC)) / RECORD_BYTES;
+
+    // Look the table up and lay out the 3x3 geometry once, before the
+    // threads share them
+    static Board empty;
+    perfectPlay(0);
+    initBoard(&empty, 3, 3, 3);
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if ((size_t)threads > records / 65536 + 1) threads = (int)(records / 65536 + 1);
+    for (int t = 0; t < threads; t++) {
+        memset(&jobs[t], 0, sizeof(jobs[t]));
+        jobs[t].data = data + sizeof(RECORD_MAGIC);
+        jobs[t].begin = records * t / threads;
+        jobs[t].end = records * (t + 1) / threads;
+        jobs[t].empty = &empty;
+    }
+
+    double t0 = nowSeconds();
+#ifndef _WIN32
+    pthread_t tid[MAX_THREADS];
+    int started = 0;
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&tid[t], NULL, analysisWorker, &jobs[t]) != 0) break;
+        started = t;
+    }
+    analysisWorker(&jobs[0]);
+    for (int t = started + 1; t < threads; t++) analysisWorker(&jobs[t]);
+    for (int t = 1; t <= started; t++) pthread_join(tid[t], NULL);
+#else
+    for (int t = 0; t < threads; t++) analysisWorker(&jobs[t]);
+#endif
+    double seconds = nowSeconds() - t0;
+
+    AnalysisStats *all = &jobs[0].stats;
+    for (int t = 1; t < threads; t++) {
+        const AnalysisStats *s = &jobs[t].stats;
+        all->games += s->games;
+        all->bad += s->bad;
+        all->moves += s->moves;
+        for (int i = 0; i < 3; i++) all->results[i] += s->results[i];
+        for (int side = 0; side < 2; side++) {
+            for (int k = 0; k < BLUNDER_KINDS; k++) all->blunders[side][k] += s->blunders[side][k];
+            all->flawed[side] += s->flawed[side];
+        }
+        for (int i = 0; i < 9; i++) {
+            all->byPly[i] += s->byPly[i];
+            all->movesAtPly[i] += s->movesAtPly[i];
+        }
+    }
+
+    double games = all->games ? (double)all->games : 1;
+    printf(" %s: %zu records (%llu unreadable) on %d threads in %.3f s: %.0f games/s\n", path, records,
+           all->bad, threads, seconds, records / (seconds > 0 ? seconds : 1e-9));
+    printf(" Results:  ");
+    printPercentages(all->results, all->games);
+    printf("\n Mean length %.2f moves\n\n", all->moves / games);
+    printf(" Blunders            X           O\n");
+    for (int k = 0; k < BLUNDER_KINDS; k++) {
+        printf(" %-12s %11llu %11llu\n", BLUNDER_NAMES[k], all->blunders[0][k], all->blunders[1][k]);
+    }
+    printf(" Games with one %6.2f%%     %6.2f%%\n\n", 100 * all->flawed[0] / games, 100 * all->flawed[1] / games);
+    printf(" Move     Blunders  Of moves\n");
+    for (int i = 0; i < 9; i++) {
+        if (!all->movesAtPly[i]) continue;
+        printf(" %4d  %11llu  %7.2f%%\n", i + 1, all->byPly[i], 100.0 * all->byPly[i] / all->movesAtPly[i]);
+    }
+
+#ifndef _WIN32
+    if (size > 0) munmap((void *)data, size);
+#else
+    free(buf);
+#endif
+    return 0;
+}
+
+// ------------------ Game ------------------
+int main(int argc, char **argv) {
+    static Board board;
+    int rows = 3, cols = 3, k = 0;
+    int computer = -1;  // side played by the computer, -1 for none
+    int perftDepth = 0, benchDepth = 0;
+    const char *analyzePath = NULL;
+    unsigned long long selfPlayGames = 0;
+    int players[2] = { PLAYER_RANDOM, PLAYER_RANDOM }, depth = 2, openingPlies = -1;
+    uint64_t seed = (uint64_t)time(NULL);
+    SearchLimits limits = { defaultThreads(), 0, DEFAULT_SECONDS };
+    const char *recordPath = DEFAULT_RECORDS, *selfPlayRecord = NULL;
+    int played[MAX_CELLS], moveCount = 0;   // this game's moves, for the record
+    int currentPlayer = 0;
     int winner = 0;
 
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--board") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &rows, &cols) != 2) rows = cols = 0;
+        } else if (strcmp(argv[i], "--k") == 0 && i + 1 < argc) {
+            k = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--ai") == 0 && i + 1 < argc) {
+            i++;
+            computer = (argv[i][0] == 'O' || argv[i][0] == 'o') ? 1 : 0;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            limits.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+            limits.seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--perft") == 0) {
+            perftDepth = (i + 1 < argc && argv[i + 1][0] != '-') ? atoi(argv[++i]) : 9;
+        } else if (strcmp(argv[i], "--selfplay") == 0 && i + 1 < argc) {
+            selfPlayGames = strtoull(argv[++i], NULL, 10);
+        } else if ((strcmp(argv[i], "--x") == 0 || strcmp(argv[i], "--o") == 0) && i + 1 < argc) {
+            int kind = playerFind(argv[i + 1]);
+            if (kind < 0) {
+                printf("Unknown player %s (random, heuristic or search)\n", argv[i + 1]);
+                return 1;
+            }
+            players[argv[i][2] == 'o'] = kind;
+            i++;
+        } else if (strcmp(argv[i], "--depth") == 0 && i + 1 < argc) {
+            depth = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--opening") == 0 && i + 1 < argc) {
+            openingPlies = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = selfPlayRecord = argv[++i];
+        } else if (strcmp(argv[i], "--no-record") == 0) {
+            recordPath = NULL;
+        } else if (strcmp(argv[i], "--analyze") == 0 && i + 1 < argc) {
+            analyzePath = argv[++i];
+        } else if (strcmp(argv[i], "--gen-table") == 0) {
+            return runGenerateTable(i + 1 < argc ? argv[i + 1] : "tictactoe_table.h");
+        } else if (strcmp(argv[i], "--bench") == 0) {
+            benchDepth = (i + 1 < argc && argv[i + 1][0] != '-') ? atoi(argv[++i]) : 6;
+        }
+    }
+    if (k == 0) k = (rows >= 5 && cols >= 5) ? 5 : (rows < cols ? rows : cols);
+    if (rows < 1 || cols < 1 || rows > MAX_SIDE || cols > MAX_SIDE || k < 1 || (k > rows && k > cols)) {
+        printf("Boards go up to %dx%d, with K no longer than a side\n", MAX_SIDE, MAX_SIDE);
+        return 1;
+    }
+    initBoard(&board, rows, cols, k);
+    if (analyzePath) return runAnalyze(analyzePath, limits.threads);
+    if (perftDepth > 0) return runPerft(&board, perftDepth, &limits);
+    if (benchDepth > 0) return runSearchBench(&board, benchDepth, limits.threads);
+    if (selfPlayGames > 0) {
+        // Without a random opening, two search players would replay one game
+        if (openingPlies < 0) openingPlies = (players[0] == PLAYER_RANDOM && players[1] == PLAYER_RANDOM) ? 0 : 2;
+        return runSelfPlay(&board, selfPlayGames, players, depth < 1 ? 1 : depth, openingPlies,
+                           limits.threads, seed, selfPlayRecord);
+    }
+    initEngine(&board);
+
+    int last = -1;
     while (winner == 0) {
-        printBoard(board);
-        playerMove(board, currentPlayer);
+        printBoard(&board);
+        if (currentPlayer == computer) last = computerMove(&board, currentPlayer, &limits);
+        else last = playerMove(&board, currentPlayer);
+        played[moveCount++] = last;
 
-        winner = checkWinner(board);
+        // Only lines through the last move can have been completed
+        winner = checkWinner(&board, last);
 
         // Switch player
-        currentPlayer = (currentPlayer == 'X') ? 'O' : 'X';
+        currentPlayer ^= 1;
     }
 
-    printBoard(board);
+    printBoard(&board);
 
     if (winner == 1) {
         printf("Player X wins!\n");
@@ -31,67 +1464,82 @@ int main() {
         printf("It's a draw!\n");
     }
 
+    // Keep a record of every finished 3x3 game
+    if (recordPath && isClassicBoard(&board)) {
+        RecordFile record;
+        uint8_t encoded[RECORD_BYTES];
+        encodeRecord(encoded, played, moveCount);
+        if (recordOpen(&record, recordPath) == 0) {
+            recordWrite(&record, encoded, 1);
+            recordClose(&record);
+        }
+    }
+
     return 0;
 }
 
-void printBoard(char board[3][3]) {
+void printBoard(const Board *b) {
+    int width = 1;
+    for (int n = b->cells; n >= 10; n /= 10) width++;
+
     printf("\n");
-    for(int i = 0; i < 3; i++) {
-        printf(" %c | %c | %c \n", board[i][0], board[i][1], board[i][2]);
-        if(i < 2) printf("---|---|---\n");
+    for(int i = 0; i < b->rows; i++) {
+        for (int j = 0; j < b->cols; j++) {
+            int c = i * b->cols + j;
+            if (stoneAt(b, 0, c) || stoneAt(b, 1, c)) printf(" %*c ", width, MARKS[stoneAt(b, 1, c)]);
+            else printf(" %*d ", width, c + 1);
+            printf(j + 1 < b->cols ? "|" : "\n");
+        }
+        if(i + 1 < b->rows) {
+            for (int j = 0; j < b->cols; j++) printf("%.*s%s", width + 2, "------", j + 1 < b->cols ? "|" : "\n");
+        }
     }
     printf("\n");
 }
 
-void playerMove(char board[3][3], char player) {
+// Returns the cell played
+int playerMove(Board *b, int side) {
     int choice;
-    int valid = 0;
 
-    while(!valid) {
-        printf("Player %c, enter a number (1-9): ", player);
-        scanf("%d", &choice);
-
-        int row = (choice - 1) / 3;
-        int col = (choice - 1) % 3;
+    while(1) {
+        printf("Player %c, enter a number (1-%d): ", MARKS[side], b->cells);
+        if (scanf("%d", &choice) != 1) {
+            if (feof(stdin)) exit(0);   // Input closed
+            scanf("%*s");               // Skip what was not a number
+            choice = 0;
+        }
 
-        if(choice >= 1 && choice <= 9 && board[row][col] != 'X' && board[row][col] != 'O') {
-            board[row][col] = player;
-            valid = 1;
-        } else {
-            printf("Invalid move! Try again.\n");
+        if(choice >= 1 && choice <= b->cells && isEmpty(b, choice - 1)) {
+            placeStone(b, side, choice - 1);
+            return choice - 1;
         }
+        printf("Invalid move! Try again.\n");
     }
 }
 
-int checkWinner(char board[3][3]) {
-    // Check rows and columns
-    for(int i = 0; i < 3; i++) {
-        if(board[i][0]==board[i][1] && board[i][1]==board[i][2]) {
-            return (board[i][0]=='X') ? 1 : 2;
-        }
-        if(board[0][i]==board[1][i] && board[1][i]==board[2][i]) {
-            return (board[0][i]=='X') ? 1 : 2;
-        }
+int computerMove(Board *b, int side, const SearchLimits *limits) {
+    int value, c = isClassicBoard(b) ? tableMove(b, &value) : -1;
+    if (c >= 0) {
+        placeStone(b, side, c);
+        printf("Computer (%c) plays %d%s\n", MARKS[side], c + 1, value == PLAY_WIN ? " and will win" : "");
+        return c;
     }
 
-    // Check diagonals
-    if(board[0][0]==board[1][1] && board[1][1]==board[2][2]) {
-        return (board[0][0]=='X') ? 1 : 2;
-    }
-    if(board[0][2]==board[1][1] && board[1][1]==board[2][0]) {
-        return (board[0][2]=='X') ? 1 : 2;
+    SearchResult r = bestMove(b, side, limits);
+    placeStone(b, side, r.move);
+    printf("Computer (%c) plays %d%s (depth %d, %llu nodes in %.2f s)\n", MARKS[side], r.move + 1,
+           r.score >= WIN - MAX_CELLS ? " and will win" : "", r.depth, r.nodes, r.seconds);
+    return r.move;
+}
+
+int checkWinner(const Board *b, int lastMove) {
+    // A new line can only run through the last move
+    if (lastMove >= 0 && winsThrough(b, stoneAt(b, 1, lastMove), lastMove)) {
+        return stoneAt(b, 1, lastMove) ? 2 : 1;
     }
 
     // Check for draw
-    int draw = 1;
-    for(int i=0;i<3;i++) {
-        for(int j=0;j<3;j++) {
-            if(board[i][j] != 'X' && board[i][j] != 'O') {
-                draw = 0;
-            }
-        }
-    }
-    if(draw) return 3;
+    if (b->moves == b->cells) return 3;
 
     return 0; // Game continues
 }
@@ -0,0 +1,485 @@
+// tictactoe_table.h
+// Perfect play for every unfinished 3x3 position, indexed by the
+// minimal perfect hash in tictactoe.c (tableSlot()). Each byte is
+// move (0-8) | value << 4 (0 draw, 1 win, 2 loss for the side to move).
+// Generated by ./tictactoe --gen-table; do not edit.
+
+#define PLAY_TABLE_POSITIONS 4520
+
+static const uint16_t PLAY_TABLE_DISPLACE[1130] = {
+    0, 11, 64, 31, 1, 49, 93, 129, 61, 80, 117, 3,
+    43, 2, 1, 10, 96, 131, 199, 164, 43, 22, 198, 0,
+    10, 8, 52, 25, 40, 138, 127, 5, 1, 27, 97, 16,
+    4, 90, 13, 5, 864, 3, 202, 14, 6, 41, 96, 3,
+    20, 69, 1, 10, 4, 1, 128, 4, 111, 7, 1, 18,
+    2, 28, 3, 1, 0, 62, 10, 9, 46, 85, 47, 1,
+    2, 1, 3, 119, 3, 0, 9, 17, 21, 1, 106, 39,
+    68, 0, 122, 9, 0, 380, 15, 37, 9, 36, 6, 62,
+    164, 87, 200, 60, 15, 15, 10, 4, 5, 121, 1, 1,
+    0, 6, 57, 139, 15, 25, 0, 0, 38, 9, 1, 1,
+    3, 5, 4, 23, 9, 29, 98, 83, 1, 22, 243, 1,
+    27, 365, 1, 22, 14, 327, 68, 138, 75, 198, 6, 2,
+    35, 0, 0, 0, 6, 42, 0, 4, 109, 130, 85, 73,
+    378, 51, 12, 1, 2, 213, 58, 9, 50, 82, 6, 127,
+    30, 1, 2, 12, 0, 102, 160, 0, 113, 104, 53, 446,
+    18, 3, 68, 131, 31, 4, 99, 419, 2, 88, 177, 1,
+    11, 1, 0, 7, 25, 37, 3, 0, 56, 2, 14, 18,
+    34, 6, 63, 22, 1, 29, 2, 72, 22, 8, 424, 227,
+    13, 1, 1, 455, 45, 5, 169, 21, 0, 19, 0, 52,
+    30, 233, 20, 0, 2, 60, 1, 30, 0, 23, 37, 6,
+    116, 31, 13, 124, 72, 0, 0, 20, 1, 0, 1, 4,
+    230, 0, 337, 255, 0, 356, 8, 0, 37, 14, 0, 11,
+    100, 10, 61, 33, 1, 607, 136, 359, 144, 145, 3, 0,
+    43, 168, 26, 113, 42, 0, 22, 32, 77, 29, 0, 0,
+    115, 216, 29, 306, 55, 14, 14, 162, 13, 41, 197, 437,
+    3, 2, 54, 1, 188, 0, 1, 270, 4, 4, 37, 49,
+    110, 215, 0, 153, 20, 0, 95, 18, 1, 3, 0, 150,
+    9, 97, 1, 2, 110, 39, 49, 12, 75, 191, 103, 84,
+    82, 7, 119, 711, 88, 0, 33, 28, 133, 86, 2, 3,
+    0, 19, 2, 5, 80, 4, 66, 25, 13, 311, 2, 183,
+    533, 4, 31, 111, 136, 54, 7, 30, 37, 594, 2, 11,
+    31, 253, 0, 224, 22, 445, 156, 186, 114, 1, 1, 30,
+    1, 961, 3, 85, 264, 2, 495, 159, 0, 334, 9, 18,
+    69, 3, 13, 226, 4, 150, 619, 85, 1, 192, 0, 76,
+    22, 605, 7, 1, 40, 0, 16, 40, 2, 320, 70, 7,
+    4, 26, 22, 495, 132, 0, 3, 65, 9, 207, 163, 85,
+    1, 12, 88, 19, 11, 73, 2, 1, 3, 13, 93, 1,
+    44, 0, 228, 459, 0, 0, 18, 0, 69, 824, 19, 11,
+    248, 8, 189, 46, 576, 0, 0, 28, 8, 91, 456, 0,
+    246, 1, 87, 8, 33, 5, 10, 475, 9, 312, 2, 11,
+    68, 400, 71, 112, 182, 12, 0, 114, 9, 36, 2, 50,
+    56, 485, 103, 12, 69, 47, 99, 0, 7, 209, 34, 4,
+    0, 322, 36, 12, 511, 8, 6, 33, 45, 4, 164, 24,
+    4, 122, 74, 68, 108, 8, 103, 4, 5, 1, 4, 4,
+    5, 0, 113, 5, 85, 121, 9, 1, 2, 197, 39, 2,
+    11, 20, 119, 107, 534, 1, 0, 29, 394, 67, 1, 359,
+    38, 117, 61, 0, 32, 54, 1, 259, 5, 481, 2, 5,
+    42, 229, 11, 240, 62, 269, 126, 20, 40, 0, 45, 8,
+    159, 58, 114, 192, 11, 80, 95, 204, 493, 186, 11, 0,
+    43, 0, 25, 45, 2, 188, 208, 0, 304, 132, 1, 239,
+    7, 6, 32, 115, 10, 9, 7, 227, 165, 143, 8, 161,
+    12, 29, 29, 570, 3, 10, 266, 892, 2, 15, 360, 510,
+    6, 53, 5, 37, 343, 774, 96, 237, 0, 164, 119, 144,
+    7, 5, 422, 441, 33, 11, 221, 226, 99, 503, 198, 46,
+    7, 147, 3, 101, 12, 2, 8, 371, 0, 149, 152, 1,
+    229, 34, 23, 104, 2, 7, 839, 3, 3, 1, 379, 45,
+    103, 171, 1, 213, 2, 11, 59, 50, 0, 1, 0, 106,
+    128, 127, 9, 14, 242, 838, 33, 466, 148, 12, 166, 8,
+    68, 87, 1208, 0, 173, 402, 2, 1738, 290, 96, 1013, 172,
+    10, 16, 8, 0, 271, 3, 10, 91, 221, 562, 86, 31,
+    156, 36, 117, 10, 17, 223, 44, 799, 35, 0, 26, 16,
+    75, 50, 181, 415, 23, 11, 56, 198, 148, 13, 3, 317,
+    672, 3, 125, 6, 204, 5, 315, 280, 12, 2106, 1, 20,
+    59, 9, 25, 155, 11, 1056, 433, 28, 39, 1, 11, 132,
+    919, 84, 84, 0, 88, 6, 105, 4, 14, 138, 3, 5,
+    253, 455, 0, 2, 802, 2, 197, 21, 82, 385, 224, 4,
+    0, 148, 0, 4, 6, 17, 97, 1, 42, 19, 71, 3,
+    63, 85, 22, 0, 14, 173, 104, 392, 263, 231, 1, 13,
+    12, 3, 286, 1311, 225, 136, 90, 202, 185, 25, 7, 697,
+    911, 153, 0, 105, 1268, 64, 8, 7, 204, 16, 43, 298,
+    61, 30, 1663, 198, 36, 773, 1, 3, 67, 920, 228, 872,
+    246, 1000, 57, 51, 150, 110, 193, 410, 33, 5, 140, 3530,
+    2, 78, 63, 328, 479, 156, 39, 1, 786, 120, 12, 375,
+    3, 425, 20, 1, 372, 921, 570, 0, 198, 2306, 39, 320,
+    127, 5, 54, 6, 1, 75, 37, 49, 75, 11, 861, 88,
+    329, 40, 2, 889, 31, 130, 7, 1, 107, 1023, 5, 881,
+    2549, 29, 1496, 500, 108, 8, 370, 3, 178, 50, 1407, 1616,
+    8, 128, 5, 49, 70, 252, 44, 228, 18, 602, 179, 117,
+    1, 7, 135, 469, 264, 53, 0, 1614, 2199, 981, 2325, 16,
+    178, 110, 0, 61, 1599, 9, 1438, 166, 16, 8, 0, 1776,
+    117, 33, 19, 429, 8, 124, 0, 618, 18, 409, 274, 674,
+    0, 2502, 0, 549, 2548, 64, 8, 29, 349, 23, 4, 0,
+    0, 597, 0, 97, 20, 412, 4, 1105, 318, 0, 108, 4,
+    1755, 1317, 26, 99, 10, 183, 2, 10, 1036, 361, 19, 182,
+    536, 9, 80, 0, 96, 2452, 2298, 183, 0, 127, 21, 651,
+    3, 118, 75, 0, 376, 729, 4, 58, 1950, 53, 7, 61,
+    105, 760, 11, 139, 1698, 635, 28, 243, 111, 81, 450, 11,
+    48, 76, 3533, 20, 3291, 12, 31, 85, 327, 5893, 1, 0,
+    53, 439, 12, 0, 1974, 1779, 10, 1, 2683, 191, 63, 17,
+    1, 2938, 454, 0, 430, 1273, 165, 0, 46, 1, 92, 1727,
+    232, 2522, 181, 1862, 0, 51, 490, 76, 3225, 796, 281, 1173,
+    980, 2330, 861, 935, 3945, 574, 3, 130, 0, 106, 60, 131,
+    361, 835, 21, 0, 74, 97, 167, 159, 4, 31, 88, 23,
+    17, 1267, 127, 5573, 47, 28, 669, 1752, 6, 18, 1706, 1205,
+    403, 120,
+};
+
+static const uint8_t PLAY_TABLE[4520] = {
+    0x21, 0x14, 0x10, 0x22, 0x24, 0x06, 0x16, 0x13, 0x14, 0x10, 0x14, 0x14,
+    0x04, 0x01, 0x11, 0x14, 0x14, 0x10, 0x04, 0x10, 0x24, 0x14, 0x16, 0x22,
+    0x14, 0x10, 0x14, 0x14, 0x14, 0x16, 0x04, 0x04, 0x15, 0x18, 0x18, 0x10,
+    0x04, 0x20, 0x18, 0x24, 0x14, 0x14, 0x15, 0x14, 0x14, 0x16, 0x15, 0x02,
+    0x12, 0x25, 0x14, 0x01, 0x14, 0x11, 0x12, 0x04, 0x14, 0x14, 0x13, 0x15,
+    0x14, 0x12, 0x04, 0x18, 0x14, 0x06, 0x15, 0x04, 0x00, 0x14, 0x24, 0x15,
+    0x14, 0x16, 0x15, 0x15, 0x26, 0x04, 0x10, 0x13, 0x14, 0x20, 0x22, 0x12,
+    0x06, 0x13, 0x14, 0x10, 0x12, 0x14, 0x10, 0x12, 0x18, 0x04, 0x00, 0x16,
+    0x14, 0x26, 0x14, 0x12, 0x14, 0x11, 0x27, 0x12, 0x22, 0x16, 0x04, 0x15,
+    0x01, 0x04, 0x12, 0x14, 0x14, 0x13, 0x13, 0x12, 0x00, 0x06, 0x10, 0x14,
+    0x12, 0x18, 0x14, 0x14, 0x22, 0x10, 0x12, 0x02, 0x28, 0x24, 0x18, 0x28,
+    0x13, 0x05, 0x10, 0x10, 0x02, 0x01, 0x16, 0x12, 0x15, 0x14, 0x18, 0x24,
+    0x14, 0x26, 0x08, 0x24, 0x17, 0x14, 0x13, 0x01, 0x01, 0x16, 0x18, 0x06,
+    0x12, 0x12, 0x17, 0x28, 0x00, 0x24, 0x00, 0x16, 0x16, 0x00, 0x12, 0x01,
+    0x14, 0x14, 0x14, 0x10, 0x08, 0x10, 0x10, 0x14, 0x03, 0x14, 0x14, 0x10,
+    0x10, 0x18, 0x06, 0x16, 0x02, 0x02, 0x11, 0x15, 0x01, 0x12, 0x12, 0x18,
+    0x08, 0x20, 0x16, 0x10, 0x18, 0x03, 0x06, 0x16, 0x14, 0x14, 0x04, 0x04,
+    0x16, 0x24, 0x12, 0x14, 0x10, 0x24, 0x15, 0x05, 0x28, 0x03, 0x18, 0x12,
+    0x12, 0x17, 0x17, 0x10, 0x10, 0x10, 0x18, 0x17, 0x12, 0x18, 0x02, 0x02,
+    0x13, 0x10, 0x06, 0x18, 0x10, 0x07, 0x11, 0x08, 0x04, 0x12, 0x24, 0x12,
+    0x24, 0x02, 0x11, 0x18, 0x18, 0x10, 0x15, 0x24, 0x15, 0x14, 0x08, 0x24,
+    0x04, 0x04, 0x14, 0x07, 0x21, 0x12, 0x18, 0x16, 0x16, 0x06, 0x11, 0x04,
+    0x06, 0x18, 0x15, 0x13, 0x18, 0x12, 0x18, 0x18, 0x16, 0x00, 0x10, 0x13,
+    0x16, 0x13, 0x10, 0x10, 0x14, 0x12, 0x14, 0x14, 0x06, 0x10, 0x12, 0x22,
+    0x03, 0x15, 0x18, 0x16, 0x04, 0x26, 0x14, 0x02, 0x24, 0x00, 0x18, 0x18,
+    0x17, 0x10, 0x14, 0x12, 0x08, 0x18, 0x14, 0x14, 0x11, 0x15, 0x06, 0x05,
+    0x05, 0x26, 0x07, 0x14, 0x14, 0x05, 0x13, 0x24, 0x22, 0x12, 0x14, 0x14,
+    0x00, 0x16, 0x14, 0x24, 0x12, 0x12, 0x02, 0x11, 0x04, 0x16, 0x14, 0x13,
+    0x14, 0x16, 0x00, 0x16, 0x14, 0x04, 0x12, 0x14, 0x14, 0x12, 0x20, 0x10,
+    0x15, 0x16, 0x16, 0x00, 0x12, 0x14, 0x07, 0x14, 0x14, 0x28, 0x04, 0x10,
+    0x12, 0x13, 0x15, 0x14, 0x14, 0x24, 0x06, 0x04, 0x18, 0x11, 0x00, 0x13,
+    0x28, 0x14, 0x24, 0x14, 0x14, 0x18, 0x04, 0x14, 0x12, 0x22, 0x10, 0x20,
+    0x13, 0x14, 0x02, 0x13, 0x10, 0x10, 0x12, 0x14, 0x00, 0x15, 0x13, 0x10,
+    0x16, 0x18, 0x20, 0x12, 0x10, 0x11, 0x10, 0x16, 0x14, 0x22, 0x13, 0x14,
+    0x15, 0x18, 0x28, 0x17, 0x12, 0x14, 0x15, 0x10, 0x00, 0x17, 0x14, 0x08,
+    0x18, 0x15, 0x14, 0x14, 0x01, 0x10, 0x14, 0x14, 0x10, 0x22, 0x26, 0x04,
+    0x24, 0x13, 0x05, 0x18, 0x14, 0x13, 0x24, 0x04, 0x14, 0x24, 0x05, 0x10,
+    0x16, 0x04, 0x10, 0x14, 0x04, 0x12, 0x14, 0x15, 0x12, 0x14, 0x01, 0x10,
+    0x12, 0x18, 0x20, 0x03, 0x10, 0x24, 0x10, 0x14, 0x18, 0x14, 0x17, 0x06,
+    0x10, 0x02, 0x03, 0x27, 0x22, 0x18, 0x15, 0x22, 0x16, 0x04, 0x20, 0x13,
+    0x10, 0x18, 0x08, 0x16, 0x13, 0x20, 0x14, 0x10, 0x16, 0x16, 0x16, 0x14,
+    0x04, 0x01, 0x00, 0x08, 0x12, 0x02, 0x16, 0x03, 0x05, 0x13, 0x24, 0x11,
+    0x26, 0x18, 0x04, 0x18, 0x12, 0x10, 0x15, 0x12, 0x00, 0x06, 0x11, 0x28,
+    0x10, 0x14, 0x16, 0x16, 0x06, 0x18, 0x15, 0x22, 0x14, 0x24, 0x05, 0x14,
+    0x12, 0x14, 0x14, 0x10, 0x13, 0x16, 0x10, 0x04, 0x12, 0x14, 0x16, 0x11,
+    0x16, 0x13, 0x12, 0x03, 0x12, 0x20, 0x17, 0x16, 0x02, 0x10, 0x12, 0x11,
+    0x20, 0x10, 0x04, 0x10, 0x17, 0x14, 0x14, 0x28, 0x18, 0x14, 0x10, 0x02,
+    0x16, 0x10, 0x14, 0x10, 0x14, 0x17, 0x17, 0x08, 0x04, 0x16, 0x04, 0x11,
+    0x13, 0x22, 0x04, 0x14, 0x10, 0x00, 0x02, 0x12, 0x15, 0x12, 0x14, 0x14,
+    0x00, 0x12, 0x00, 0x18, 0x22, 0x24, 0x02, 0x02, 0x14, 0x14, 0x10, 0x17,
+    0x04, 0x10, 0x04, 0x02, 0x06, 0x20, 0x16, 0x02, 0x05, 0x26, 0x04, 0x14,
+    0x18, 0x15, 0x18, 0x13, 0x13, 0x16, 0x12, 0x14, 0x16, 0x02, 0x14, 0x00,
+    0x14, 0x26, 0x12, 0x17, 0x08, 0x11, 0x10, 0x10, 0x12, 0x11, 0x06, 0x07,
+    0x05, 0x20, 0x14, 0x14, 0x18, 0x14, 0x07, 0x15, 0x14, 0x12, 0x10, 0x16,
+    0x10, 0x24, 0x12, 0x07, 0x10, 0x16, 0x12, 0x24, 0x12, 0x24, 0x17, 0x18,
+    0x18, 0x18, 0x18, 0x04, 0x10, 0x07, 0x14, 0x02, 0x12, 0x24, 0x18, 0x18,
+    0x12, 0x10, 0x12, 0x11, 0x10, 0x13, 0x26, 0x12, 0x06, 0x12, 0x00, 0x14,
+    0x10, 0x14, 0x07, 0x16, 0x00, 0x18, 0x20, 0x12, 0x15, 0x16, 0x10, 0x16,
+    0x15, 0x16, 0x21, 0x12, 0x14, 0x16, 0x02, 0x04, 0x14, 0x12, 0x10, 0x17,
+    0x16, 0x18, 0x13, 0x13, 0x18, 0x12, 0x15, 0x14, 0x00, 0x10, 0x08, 0x15,
+    0x13, 0x11, 0x23, 0x14, 0x03, 0x16, 0x16, 0x17, 0x14, 0x14, 0x16, 0x24,
+    0x17, 0x14, 0x12, 0x14, 0x20, 0x14, 0x22, 0x10, 0x28, 0x24, 0x03, 0x06,
+    0x16, 0x18, 0x05, 0x12, 0x16, 0x12, 0x20, 0x04, 0x18, 0x20, 0x18, 0x16,
+    0x04, 0x08, 0x17, 0x18, 0x18, 0x11, 0x14, 0x01, 0x02, 0x06, 0x16, 0x22,
+    0x14, 0x25, 0x10, 0x04, 0x14, 0x02, 0x15, 0x18, 0x08, 0x04, 0x14, 0x13,
+    0x10, 0x14, 0x00, 0x12, 0x06, 0x26, 0x20, 0x17, 0x18, 0x10, 0x20, 0x24,
+    0x10, 0x04, 0x16, 0x05, 0x08, 0x14, 0x00, 0x04, 0x18, 0x24, 0x18, 0x17,
+    0x07, 0x14, 0x20, 0x00, 0x16, 0x12, 0x20, 0x18, 0x11, 0x18, 0x14, 0x04,
+    0x14, 0x15, 0x16, 0x16, 0x04, 0x28, 0x14, 0x18, 0x11, 0x16, 0x00, 0x10,
+    0x18, 0x08, 0x12, 0x16, 0x04, 0x15, 0x00, 0x10, 0x13, 0x13, 0x24, 0x04,
+    0x08, 0x15, 0x10, 0x14, 0x18, 0x15, 0x12, 0x16, 0x17, 0x11, 0x06, 0x10,
+    0x14, 0x06, 0x11, 0x10, 0x18, 0x08, 0x16, 0x07, 0x03, 0x14, 0x02, 0x08,
+    0x18, 0x14, 0x14, 0x12, 0x17, 0x03, 0x10, 0x15, 0x05, 0x22, 0x12, 0x05,
+    0x16, 0x14, 0x18, 0x10, 0x16, 0x06, 0x13, 0x12, 0x18, 0x20, 0x05, 0x18,
+    0x12, 0x12, 0x14, 0x22, 0x11, 0x12, 0x15, 0x22, 0x24, 0x06, 0x00, 0x02,
+    0x10, 0x10, 0x12, 0x26, 0x22, 0x06, 0x22, 0x16, 0x24, 0x08, 0x15, 0x17,
+    0x10, 0x14, 0x14, 0x13, 0x10, 0x12, 0x07, 0x18, 0x11, 0x16, 0x11, 0x00,
+    0x14, 0x00, 0x14, 0x08, 0x14, 0x14, 0x11, 0x24, 0x17, 0x02, 0x17, 0x20,
+    0x16, 0x14, 0x14, 0x14, 0x10, 0x12, 0x15, 0x28, 0x17, 0x02, 0x11, 0x02,
+    0x16, 0x13, 0x04, 0x10, 0x16, 0x22, 0x14, 0x02, 0x16, 0x22, 0x14, 0x12,
+    0x03, 0x14, 0x06, 0x26, 0x16, 0x06, 0x16, 0x14, 0x10, 0x04, 0x28, 0x24,
+    0x01, 0x28, 0x12, 0x01, 0x10, 0x14, 0x05, 0x10, 0x10, 0x14, 0x04, 0x15,
+    0x00, 0x04, 0x14, 0x12, 0x10, 0x20, 0x04, 0x01, 0x14, 0x26, 0x22, 0x14,
+    0x20, 0x03, 0x04, 0x07, 0x05, 0x12, 0x11, 0x10, 0x04, 0x26, 0x13, 0x17,
+    0x06, 0x17, 0x10, 0x18, 0x18, 0x17, 0x11, 0x18, 0x08, 0x02, 0x10, 0x20,
+    0x20, 0x15, 0x13, 0x13, 0x06, 0x10, 0x06, 0x16, 0x14, 0x12, 0x00, 0x10,
+    0x24, 0x14, 0x00, 0x14, 0x18, 0x18, 0x26, 0x16, 0x25, 0x14, 0x12, 0x20,
+    0x25, 0x20, 0x24, 0x11, 0x17, 0x10, 0x20, 0x20, 0x24, 0x04, 0x08, 0x20,
+    0x10, 0x20, 0x16, 0x10, 0x17, 0x28, 0x12, 0x12, 0x17, 0x13, 0x15, 0x18,
+    0x02, 0x04, 0x12, 0x12, 0x04, 0x16, 0x16, 0x14, 0x15, 0x02, 0x26, 0x14,
+    0x04, 0x05, 0x17, 0x16, 0x10, 0x10, 0x20, 0x14, 0x24, 0x02, 0x12, 0x14,
+    0x04, 0x18, 0x20, 0x14, 0x16, 0x02, 0x01, 0x14, 0x14, 0x01, 0x26, 0x12,
+    0x14, 0x17, 0x14, 0x04, 0x10, 0x17, 0x08, 0x24, 0x22, 0x12, 0x17, 0x10,
+    0x04, 0x10, 0x01, 0x20, 0x12, 0x00, 0x02, 0x18, 0x08, 0x14, 0x14, 0x20,
+    0x14, 0x14, 0x10, 0x18, 0x24, 0x04, 0x18, 0x14, 0x17, 0x04, 0x14, 0x18,
+    0x00, 0x16, 0x02, 0x00, 0x14, 0x16, 0x18, 0x06, 0x14, 0x14, 0x20, 0x24,
+    0x18, 0x02, 0x24, 0x14, 0x20, 0x16, 0x03, 0x14, 0x00, 0x12, 0x10, 0x10,
+    0x03, 0x16, 0x14, 0x17, 0x14, 0x14, 0x10, 0x14, 0x14, 0x10, 0x14, 0x16,
+    0x22, 0x02, 0x14, 0x12, 0x18, 0x15, 0x00, 0x01, 0x14, 0x00, 0x12, 0x14,
+    0x18, 0x02, 0x12, 0x14, 0x20, 0x12, 0x02, 0x24, 0x22, 0x13, 0x05, 0x16,
+    0x20, 0x20, 0x24, 0x05, 0x02, 0x00, 0x10, 0x12, 0x07, 0x10, 0x01, 0x24,
+    0x18, 0x17, 0x10, 0x28, 0x18, 0x13, 0x10, 0x00, 0x14, 0x10, 0x12, 0x04,
+    0x12, 0x10, 0x24, 0x11, 0x22, 0x14, 0x14, 0x14, 0x18, 0x00, 0x14, 0x10,
+    0x18, 0x05, 0x18, 0x24, 0x24, 0x13, 0x20, 0x01, 0x10, 0x13, 0x08, 0x12,
+    0x18, 0x15, 0x08, 0x12, 0x14, 0x14, 0x08, 0x15, 0x16, 0x12, 0x14, 0x20,
+    0x08, 0x12, 0x20, 0x12, 0x18, 0x10, 0x20, 0x20, 0x02, 0x11, 0x11, 0x14,
+    0x14, 0x04, 0x04, 0x08, 0x20, 0x06, 0x07, 0x04, 0x15, 0x16, 0x14, 0x17,
+    0x04, 0x14, 0x14, 0x12, 0x00, 0x00, 0x11, 0x10, 0x14, 0x24, 0x18, 0x16,
+    0x15, 0x14, 0x18, 0x16, 0x13, 0x18, 0x26, 0x18, 0x28, 0x18, 0x14, 0x17,
+    0x10, 0x16, 0x18, 0x14, 0x13, 0x14, 0x14, 0x14, 0x24, 0x02, 0x13, 0x16,
+    0x11, 0x02, 0x24, 0x24, 0x12, 0x14, 0x10, 0x18, 0x18, 0x14, 0x24, 0x16,
+    0x12, 0x24, 0x24, 0x07, 0x20, 0x11, 0x24, 0x17, 0x17, 0x10, 0x05, 0x14,
+    0x11, 0x24, 0x04, 0x12, 0x01, 0x10, 0x15, 0x04, 0x11, 0x17, 0x14, 0x14,
+    0x04, 0x16, 0x24, 0x10, 0x16, 0x02, 0x16, 0x02, 0x18, 0x24, 0x14, 0x12,
+    0x14, 0x02, 0x16, 0x14, 0x14, 0x14, 0x13, 0x14, 0x24, 0x18, 0x12, 0x16,
+    0x16, 0x15, 0x04, 0x26, 0x13, 0x18, 0x20, 0x12, 0x15, 0x13, 0x18, 0x18,
+    0x12, 0x04, 0x16, 0x24, 0x14, 0x14, 0x14, 0x16, 0x18, 0x14, 0x05, 0x17,
+    0x12, 0x08, 0x12, 0x11, 0x18, 0x14, 0x18, 0x24, 0x12, 0x13, 0x16, 0x10,
+    0x11, 0x12, 0x24, 0x18, 0x12, 0x06, 0x14, 0x24, 0x04, 0x15, 0x02, 0x18,
+    0x03, 0x20, 0x16, 0x13, 0x16, 0x16, 0x16, 0x17, 0x14, 0x17, 0x10, 0x24,
+    0x18, 0x22, 0x16, 0x04, 0x01, 0x14, 0x22, 0x10, 0x20, 0x24, 0x12, 0x14,
+    0x02, 0x14, 0x20, 0x14, 0x06, 0x12, 0x04, 0x12, 0x14, 0x12, 0x16, 0x16,
+    0x16, 0x08, 0x08, 0x26, 0x01, 0x00, 0x22, 0x18, 0x16, 0x12, 0x10, 0x16,
+    0x00, 0x06, 0x06, 0x01, 0x16, 0x10, 0x06, 0x14, 0x07, 0x16, 0x22, 0x15,
+    0x24, 0x12, 0x14, 0x12, 0x12, 0x12, 0x08, 0x24, 0x14, 0x14, 0x08, 0x15,
+    0x11, 0x18, 0x12, 0x24, 0x12, 0x16, 0x00, 0x03, 0x11, 0x10, 0x16, 0x14,
+    0x04, 0x16, 0x14, 0x24, 0x07, 0x18, 0x11, 0x28, 0x11, 0x12, 0x06, 0x18,
+    0x00, 0x12, 0x18, 0x11, 0x05, 0x12, 0x17, 0x18, 0x10, 0x16, 0x11, 0x18,
+    0x20, 0x17, 0x07, 0x08, 0x04, 0x22, 0x08, 0x16, 0x22, 0x14, 0x12, 0x05,
+    0x02, 0x17, 0x26, 0x16, 0x14, 0x07, 0x12, 0x14, 0x10, 0x13, 0x12, 0x14,
+    0x10, 0x04, 0x12, 0x04, 0x11, 0x13, 0x14, 0x00, 0x15, 0x04, 0x12, 0x11,
+    0x26, 0x24, 0x18, 0x18, 0x20, 0x07, 0x14, 0x21, 0x01, 0x11, 0x24, 0x07,
+    0x18, 0x14, 0x07, 0x07, 0x16, 0x20, 0x16, 0x11, 0x14, 0x26, 0x14, 0x24,
+    0x15, 0x25, 0x10, 0x14, 0x10, 0x06, 0x07, 0x14, 0x12, 0x04, 0x16, 0x04,
+    0x24, 0x12, 0x21, 0x14, 0x11, 0x18, 0x16, 0x10, 0x16, 0x17, 0x10, 0x14,
+    0x14, 0x20, 0x13, 0x00, 0x10, 0x24, 0x00, 0x24, 0x13, 0x18, 0x04, 0x14,
+    0x02, 0x22, 0x13, 0x14, 0x10, 0x03, 0x10, 0x16, 0x14, 0x10, 0x02, 0x26,
+    0x14, 0x08, 0x12, 0x20, 0x22, 0x16, 0x16, 0x17, 0x04, 0x14, 0x14, 0x06,
+    0x16, 0x14, 0x27, 0x00, 0x16, 0x18, 0x17, 0x11, 0x04, 0x14, 0x10, 0x28,
+    0x26, 0x08, 0x15, 0x14, 0x20, 0x12, 0x07, 0x14, 0x00, 0x25, 0x12, 0x26,
+    0x13, 0x14, 0x18, 0x16, 0x14, 0x04, 0x14, 0x16, 0x14, 0x18, 0x14, 0x00,
+    0x03, 0x16, 0x14, 0x14, 0x14, 0x08, 0x28, 0x04, 0x14, 0x18, 0x12, 0x03,
+    0x11, 0x11, 0x14, 0x10, 0x01, 0x14, 0x17, 0x17, 0x17, 0x14, 0x05, 0x15,
+    0x18, 0x12, 0x11, 0x04, 0x06, 0x11, 0x18, 0x10, 0x22, 0x04, 0x24, 0x12,
+    0x13, 0x24, 0x20, 0x17, 0x12, 0x15, 0x18, 0x21, 0x16, 0x10, 0x13, 0x17,
+    0x12, 0x03, 0x14, 0x21, 0x10, 0x10, 0x01, 0x04, 0x14, 0x04, 0x12, 0x22,
+    0x26, 0x03, 0x11, 0x08, 0x12, 0x14, 0x14, 0x10, 0x28, 0x10, 0x10, 0x14,
+    0x15, 0x15, 0x17, 0x14, 0x06, 0x24, 0x24, 0x18, 0x14, 0x18, 0x00, 0x10,
+    0x16, 0x10, 0x18, 0x04, 0x22, 0x14, 0x20, 0x11, 0x10, 0x10, 0x16, 0x00,
+    0x00, 0x20, 0x13, 0x15, 0x04, 0x12, 0x12, 0x12, 0x16, 0x18, 0x10, 0x18,
+    0x06, 0x20, 0x00, 0x16, 0x17, 0x20, 0x12, 0x14, 0x11, 0x18, 0x15, 0x14,
+    0x18, 0x15, 0x04, 0x16, 0x16, 0x13, 0x16, 0x18, 0x20, 0x18, 0x11, 0x12,
+    0x11, 0x04, 0x14, 0x16, 0x02, 0x20, 0x07, 0x14, 0x18, 0x00, 0x14, 0x14,
+    0x10, 0x14, 0x24, 0x20, 0x10, 0x16, 0x14, 0x24, 0x14, 0x18, 0x01, 0x11,
+    0x15, 0x14, 0x13, 0x16, 0x14, 0x18, 0x11, 0x16, 0x24, 0x16, 0x12, 0x01,
+    0x22, 0x10, 0x14, 0x08, 0x10, 0x14, 0x22, 0x12, 0x00, 0x15, 0x26, 0x18,
+    0x17, 0x00, 0x23, 0x26, 0x00, 0x08, 0x12, 0x14, 0x11, 0x16, 0x24, 0x12,
+    0x04, 0x25, 0x12, 0x17, 0x18, 0x26, 0x18, 0x02, 0x02, 0x00, 0x06, 0x02,
+    0x05, 0x00, 0x14, 0x10, 0x15, 0x10, 0x04, 0x24, 0x14, 0x18, 0x14, 0x04,
+    0x03, 0x12, 0x11, 0x20, 0x04, 0x12, 0x10, 0x10, 0x05, 0x26, 0x16, 0x02,
+    0x14, 0x14, 0x18, 0x10, 0x00, 0x17, 0x03, 0x10, 0x01, 0x16, 0x27, 0x17,
+    0x06, 0x02, 0x11, 0x00, 0x13, 0x12, 0x02, 0x14, 0x13, 0x00, 0x08, 0x14,
+    0x03, 0x01, 0x10, 0x04, 0x15, 0x14, 0x14, 0x08, 0x24, 0x00, 0x12, 0x06,
+    0x17, 0x04, 0x07, 0x18, 0x18, 0x14, 0x04, 0x24, 0x14, 0x17, 0x10, 0x14,
+    0x08, 0x00, 0x14, 0x16, 0x14, 0x12, 0x14, 0x15, 0x12, 0x20, 0x13, 0x14,
+    0x13, 0x14, 0x12, 0x12, 0x06, 0x18, 0x16, 0x28, 0x10, 0x24, 0x14, 0x03,
+    0x10, 0x20, 0x14, 0x15, 0x00, 0x14, 0x00, 0x24, 0x22, 0x18, 0x05, 0x20,
+    0x16, 0x10, 0x15, 0x16, 0x13, 0x00, 0x14, 0x10, 0x10, 0x05, 0x12, 0x26,
+    0x04, 0x00, 0x23, 0x02, 0x24, 0x14, 0x10, 0x07, 0x10, 0x20, 0x14, 0x18,
+    0x16, 0x12, 0x14, 0x18, 0x02, 0x04, 0x16, 0x14, 0x11, 0x14, 0x10, 0x05,
+    0x20, 0x08, 0x04, 0x00, 0x12, 0x12, 0x12, 0x24, 0x12, 0x27, 0x12, 0x14,
+    0x16, 0x02, 0x02, 0x24, 0x01, 0x13, 0x16, 0x03, 0x20, 0x18, 0x04, 0x00,
+    0x14, 0x24, 0x00, 0x14, 0x12, 0x04, 0x02, 0x22, 0x10, 0x24, 0x14, 0x04,
+    0x12, 0x04, 0x05, 0x10, 0x04, 0x14, 0x10, 0x15, 0x17, 0x04, 0x18, 0x16,
+    0x18, 0x10, 0x26, 0x05, 0x20, 0x18, 0x14, 0x14, 0x12, 0x18, 0x14, 0x10,
+    0x16, 0x10, 0x16, 0x12, 0x18, 0x04, 0x11, 0x03, 0x18, 0x14, 0x17, 0x18,
+    0x02, 0x18, 0x00, 0x20, 0x18, 0x14, 0x11, 0x07, 0x17, 0x08, 0x15, 0x06,
+    0x12, 0x12, 0x18, 0x06, 0x16, 0x14, 0x12, 0x10, 0x04, 0x04, 0x14, 0x00,
+    0x12, 0x00, 0x08, 0x10, 0x16, 0x18, 0x11, 0x02, 0x04, 0x18, 0x26, 0x16,
+    0x12, 0x24, 0x10, 0x10, 0x16, 0x23, 0x16, 0x18, 0x14, 0x11, 0x24, 0x04,
+    0x16, 0x16, 0x22, 0x02, 0x12, 0x24, 0x10, 0x06, 0x13, 0x02, 0x13, 0x00,
+    0x20, 0x10, 0x16, 0x20, 0x00, 0x05, 0x14, 0x17, 0x10, 0x07, 0x16, 0x14,
+    0x02, 0x12, 0x11, 0x08, 0x17, 0x18, 0x14, 0x10, 0x17, 0x10, 0x17, 0x10,
+    0x14, 0x03, 0x15, 0x08, 0x24, 0x18, 0x14, 0x12, 0x01, 0x15, 0x02, 0x11,
+    0x13, 0x10, 0x18, 0x00, 0x16, 0x14, 0x14, 0x13, 0x18, 0x18, 0x14, 0x10,
+    0x16, 0x08, 0x14, 0x00, 0x10, 0x06, 0x15, 0x04, 0x14, 0x14, 0x06, 0x10,
+    0x04, 0x17, 0x01, 0x18, 0x18, 0x20, 0x10, 0x17, 0x13, 0x18, 0x14, 0x12,
+    0x26, 0x08, 0x17, 0x11, 0x02, 0x20, 0x07, 0x10, 0x14, 0x18, 0x12, 0x01,
+    0x14, 0x26, 0x14, 0x13, 0x14, 0x21, 0x20, 0x04, 0x16, 0x15, 0x24, 0x12,
+    0x17, 0x14, 0x17, 0x14, 0x15, 0x00, 0x12, 0x12, 0x12, 0x01, 0x22, 0x06,
+    0x24, 0x11, 0x18, 0x10, 0x18, 0x14, 0x10, 0x16, 0x10, 0x12, 0x02, 0x01,
+    0x13, 0x14, 0x23, 0x16, 0x14, 0x10, 0x14, 0x00, 0x10, 0x16, 0x15, 0x08,
+    0x14, 0x04, 0x10, 0x10, 0x24, 0x07, 0x04, 0x15, 0x12, 0x18, 0x15, 0x10,
+    0x18, 0x17, 0x16, 0x13, 0x14, 0x14, 0x10, 0x14, 0x16, 0x20, 0x14, 0x27,
+    0x17, 0x18, 0x18, 0x16, 0x11, 0x20, 0x16, 0x16, 0x11, 0x10, 0x24, 0x16,
+    0x06, 0x14, 0x14, 0x14, 0x28, 0x02, 0x16, 0x00, 0x26, 0x18, 0x16, 0x16,
+    0x04, 0x11, 0x20, 0x11, 0x12, 0x16, 0x03, 0x14, 0x00, 0x12, 0x06, 0x14,
+    0x15, 0x20, 0x14, 0x12, 0x11, 0x00, 0x14, 0x14, 0x17, 0x12, 0x04, 0x13,
+    0x14, 0x13, 0x04, 0x20, 0x04, 0x20, 0x04, 0x10, 0x14, 0x07, 0x10, 0x28,
+    0x12, 0x06, 0x03, 0x18, 0x25, 0x22, 0x14, 0x16, 0x22, 0x18, 0x00, 0x14,
+    0x08, 0x10, 0x10, 0x11, 0x04, 0x24, 0x12, 0x12, 0x22, 0x12, 0x14, 0x00,
+    0x14, 0x10, 0x13, 0x08, 0x16, 0x10, 0x20, 0x14, 0x24, 0x17, 0x13, 0x13,
+    0x04, 0x13, 0x16, 0x16, 0x26, 0x20, 0x12, 0x11, 0x00, 0x04, 0x12, 0x18,
+    0x18, 0x17, 0x14, 0x10, 0x11, 0x10, 0x26, 0x10, 0x10, 0x12, 0x12, 0x02,
+    0x00, 0x16, 0x16, 0x20, 0x06, 0x05, 0x14, 0x10, 0x07, 0x13, 0x25, 0x15,
+    0x14, 0x14, 0x13, 0x00, 0x18, 0x24, 0x06, 0x04, 0x16, 0x16, 0x16, 0x11,
+    0x22, 0x02, 0x11, 0x17, 0x10, 0x16, 0x24, 0x15, 0x10, 0x08, 0x16, 0x20,
+    0x14, 0x14, 0x18, 0x10, 0x24, 0x17, 0x11, 0x14, 0x18, 0x12, 0x15, 0x01,
+    0x15, 0x16, 0x26, 0x18, 0x14, 0x18, 0x18, 0x18, 0x24, 0x04, 0x10, 0x20,
+    0x24, 0x12, 0x16, 0x11, 0x18, 0x22, 0x27, 0x11, 0x12, 0x14, 0x18, 0x10,
+    0x14, 0x18, 0x11, 0x12, 0x16, 0x22, 0x05, 0x22, 0x28, 0x16, 0x24, 0x11,
+    0x07, 0x01, 0x02, 0x16, 0x17, 0x21, 0x04, 0x00, 0x04, 0x10, 0x12, 0x00,
+    0x14, 0x04, 0x04, 0x12, 0x12, 0x16, 0x13, 0x01, 0x04, 0x00, 0x16, 0x24,
+    0x11, 0x12, 0x11, 0x08, 0x14, 0x22, 0x14, 0x18, 0x12, 0x04, 0x00, 0x14,
+    0x07, 0x18, 0x20, 0x20, 0x03, 0x08, 0x16, 0x10, 0x02, 0x10, 0x02, 0x12,
+    0x00, 0x14, 0x12, 0x15, 0x14, 0x04, 0x04, 0x12, 0x14, 0x22, 0x26, 0x13,
+    0x17, 0x14, 0x14, 0x14, 0x12, 0x10, 0x17, 0x14, 0x14, 0x14, 0x10, 0x11,
+    0x12, 0x16, 0x14, 0x18, 0x26, 0x14, 0x14, 0x01, 0x16, 0x16, 0x26, 0x04,
+    0x00, 0x14, 0x04, 0x10, 0x06, 0x14, 0x18, 0x14, 0x14, 0x01, 0x14, 0x01,
+    0x12, 0x26, 0x11, 0x12, 0x17, 0x10, 0x17, 0x08, 0x20, 0x08, 0x14, 0x16,
+    0x20, 0x04, 0x16, 0x11, 0x14, 0x03, 0x11, 0x12, 0x14, 0x10, 0x08, 0x14,
+    0x13, 0x06, 0x05, 0x12, 0x14, 0x25, 0x06, 0x04, 0x04, 0x18, 0x17, 0x22,
+    0x16, 0x20, 0x12, 0x13, 0x14, 0x10, 0x15, 0x08, 0x14, 0x22, 0x02, 0x21,
+    0x03, 0x01, 0x18, 0x16, 0x14, 0x24, 0x12, 0x20, 0x12, 0x02, 0x18, 0x12,
+    0x17, 0x16, 0x28, 0x06, 0x14, 0x00, 0x10, 0x03, 0x04, 0x18, 0x01, 0x06,
+    0x16, 0x14, 0x04, 0x10, 0x14, 0x18, 0x12, 0x04, 0x00, 0x04, 0x12, 0x00,
+    0x10, 0x16, 0x04, 0x14, 0x10, 0x11, 0x10, 0x10, 0x18, 0x14, 0x10, 0x04,
+    0x06, 0x04, 0x10, 0x11, 0x02, 0x20, 0x00, 0x04, 0x10, 0x27, 0x24, 0x04,
+    0x14, 0x10, 0x14, 0x04, 0x06, 0x15, 0x12, 0x12, 0x18, 0x17, 0x22, 0x12,
+    0x16, 0x16, 0x00, 0x13, 0x28, 0x04, 0x12, 0x14, 0x10, 0x18, 0x20, 0x12,
+    0x00, 0x18, 0x06, 0x02, 0x22, 0x24, 0x10, 0x27, 0x16, 0x11, 0x10, 0x17,
+    0x11, 0x16, 0x14, 0x04, 0x11, 0x14, 0x14, 0x10, 0x12, 0x15, 0x11, 0x24,
+    0x06, 0x04, 0x05, 0x10, 0x20, 0x10, 0x26, 0x04, 0x22, 0x16, 0x18, 0x14,
+    0x18, 0x16, 0x05, 0x12, 0x16, 0x14, 0x12, 0x10, 0x14, 0x16, 0x14, 0x18,
+    0x00, 0x22, 0x14, 0x14, 0x14, 0x18, 0x10, 0x18, 0x18, 0x04, 0x17, 0x08,
+    0x00, 0x06, 0x24, 0x05, 0x08, 0x11, 0x24, 0x10, 0x16, 0x12, 0x11, 0x10,
+    0x16, 0x00, 0x15, 0x04, 0x13, 0x10, 0x14, 0x14, 0x20, 0x02, 0x12, 0x12,
+    0x14, 0x03, 0x16, 0x14, 0x12, 0x22, 0x15, 0x22, 0x14, 0x06, 0x00, 0x12,
+    0x14, 0x00, 0x14, 0x27, 0x14, 0x16, 0x01, 0x03, 0x10, 0x08, 0x03, 0x12,
+    0x16, 0x18, 0x00, 0x20, 0x08, 0x08, 0x18, 0x22, 0x14, 0x18, 0x10, 0x14,
+    0x14, 0x10, 0x16, 0x14, 0x20, 0x13, 0x16, 0x16, 0x18, 0x01, 0x20, 0x14,
+    0x11, 0x03, 0x12, 0x25, 0x20, 0x21, 0x10, 0x15, 0x14, 0x13, 0x12, 0x16,
+    0x23, 0x16, 0x06, 0x13, 0x26, 0x15, 0x14, 0x13, 0x14, 0x01, 0x04, 0x08,
+    0x06, 0x10, 0x13, 0x14, 0x16, 0x24, 0x14, 0x01, 0x26, 0x14, 0x18, 0x14,
+    0x12, 0x16, 0x00, 0x06, 0x02, 0x04, 0x14, 0x04, 0x04, 0x04, 0x02, 0x15,
+    0x14, 0x02, 0x16, 0x14, 0x18, 0x13, 0x14, 0x06, 0x04, 0x18, 0x16, 0x16,
+    0x14, 0x14, 0x16, 0x17, 0x13, 0x14, 0x08, 0x28, 0x04, 0x06, 0x16, 0x11,
+    0x10, 0x05, 0x14, 0x04, 0x17, 0x16, 0x07, 0x18, 0x28, 0x14, 0x12, 0x20,
+    0x16, 0x20, 0x14, 0x18, 0x13, 0x18, 0x10, 0x04, 0x17, 0x20, 0x12, 0x17,
+    0x10, 0x04, 0x14, 0x20, 0x14, 0x06, 0x10, 0x11, 0x16, 0x05, 0x15, 0x11,
+    0x26, 0x16, 0x00, 0x10, 0x14, 0x13, 0x02, 0x13, 0x18, 0x06, 0x06, 0x03,
+    0x04, 0x12, 0x16, 0x16, 0x03, 0x18, 0x08, 0x00, 0x14, 0x12, 0x12, 0x03,
+    0x14, 0x18, 0x15, 0x16, 0x11, 0x12, 0x14, 0x18, 0x05, 0x08, 0x24, 0x02,
+    0x11, 0x14, 0x01, 0x03, 0x22, 0x15, 0x14, 0x04, 0x04, 0x04, 0x07, 0x06,
+    0x12, 0x16, 0x10, 0x07, 0x08, 0x06, 0x10, 0x00, 0x11, 0x20, 0x14, 0x14,
+    0x18, 0x10, 0x16, 0x24, 0x14, 0x10, 0x22, 0x18, 0x14, 0x20, 0x18, 0x11,
+    0x20, 0x13, 0x08, 0x16, 0x24, 0x20, 0x11, 0x12, 0x14, 0x20, 0x14, 0x14,
+    0x24, 0x10, 0x24, 0x07, 0x07, 0x04, 0x20, 0x04, 0x15, 0x26, 0x07, 0x14,
+    0x06, 0x22, 0x10, 0x16, 0x00, 0x07, 0x12, 0x22, 0x18, 0x16, 0x14, 0x02,
+    0x03, 0x03, 0x02, 0x25, 0x14, 0x18, 0x21, 0x24, 0x12, 0x22, 0x20, 0x03,
+    0x10, 0x13, 0x04, 0x13, 0x16, 0x28, 0x11, 0x26, 0x15, 0x15, 0x04, 0x10,
+    0x12, 0x00, 0x14, 0x18, 0x16, 0x14, 0x15, 0x06, 0x10, 0x10, 0x16, 0x04,
+    0x10, 0x04, 0x07, 0x14, 0x06, 0x16, 0x16, 0x04, 0x12, 0x16, 0x10, 0x06,
+    0x16, 0x12, 0x17, 0x10, 0x20, 0x14, 0x23, 0x15, 0x01, 0x12, 0x14, 0x00,
+    0x01, 0x00, 0x10, 0x11, 0x14, 0x20, 0x02, 0x12, 0x26, 0x04, 0x18, 0x04,
+    0x15, 0x14, 0x16, 0x18, 0x18, 0x10, 0x15, 0x18, 0x02, 0x00, 0x16, 0x15,
+    0x14, 0x18, 0x12, 0x18, 0x11, 0x01, 0x00, 0x11, 0x16, 0x14, 0x20, 0x13,
+    0x06, 0x14, 0x15, 0x10, 0x10, 0x05, 0x11, 0x04, 0x14, 0x14, 0x12, 0x14,
+    0x04, 0x12, 0x04, 0x12, 0x13, 0x17, 0x05, 0x14, 0x05, 0x10, 0x16, 0x12,
+    0x15, 0x18, 0x14, 0x11, 0x14, 0x12, 0x07, 0x11, 0x10, 0x02, 0x07, 0x11,
+    0x13, 0x03, 0x14, 0x08, 0x22, 0x18, 0x18, 0x14, 0x16, 0x00, 0x11, 0x06,
+    0x13, 0x12, 0x15, 0x03, 0x16, 0x10, 0x12, 0x07, 0x16, 0x06, 0x12, 0x18,
+    0x11, 0x05, 0x14, 0x00, 0x00, 0x22, 0x04, 0x10, 0x24, 0x10, 0x07, 0x24,
+    0x11, 0x17, 0x18, 0x24, 0x18, 0x02, 0x16, 0x00, 0x02, 0x05, 0x18, 0x12,
+    0x08, 0x12, 0x27, 0x16, 0x10, 0x10, 0x14, 0x18, 0x10, 0x14, 0x12, 0x24,
+    0x16, 0x01, 0x14, 0x11, 0x17, 0x03, 0x14, 0x17, 0x20, 0x15, 0x12, 0x05,
+    0x21, 0x16, 0x24, 0x00, 0x15, 0x04, 0x28, 0x24, 0x04, 0x10, 0x24, 0x26,
+    0x00, 0x17, 0x17, 0x24, 0x24, 0x12, 0x14, 0x02, 0x12, 0x12, 0x13, 0x04,
+    0x14, 0x16, 0x16, 0x10, 0x04, 0x24, 0x17, 0x18, 0x22, 0x18, 0x10, 0x21,
+    0x16, 0x07, 0x10, 0x16, 0x23, 0x04, 0x13, 0x16, 0x17, 0x00, 0x12, 0x10,
+    0x18, 0x14, 0x18, 0x14, 0x04, 0x12, 0x22, 0x03, 0x22, 0x26, 0x07, 0x22,
+    0x14, 0x02, 0x15, 0x10, 0x05, 0x00, 0x12, 0x00, 0x16, 0x24, 0x13, 0x16,
+    0x03, 0x10, 0x18, 0x02, 0x23, 0x15, 0x14, 0x16, 0x01, 0x17, 0x15, 0x23,
+    0x05, 0x10, 0x14, 0x16, 0x04, 0x13, 0x06, 0x14, 0x18, 0x11, 0x14, 0x15,
+    0x14, 0x17, 0x06, 0x11, 0x14, 0x16, 0x14, 0x18, 0x16, 0x14, 0x16, 0x12,
+    0x14, 0x18, 0x02, 0x02, 0x10, 0x24, 0x18, 0x14, 0x03, 0x10, 0x10, 0x11,
+    0x22, 0x07, 0x14, 0x12, 0x12, 0x23, 0x02, 0x23, 0x18, 0x14, 0x21, 0x13,
+    0x13, 0x12, 0x14, 0x18, 0x15, 0x10, 0x06, 0x14, 0x10, 0x20, 0x17, 0x18,
+    0x10, 0x11, 0x14, 0x08, 0x16, 0x10, 0x00, 0x20, 0x14, 0x15, 0x10, 0x14,
+    0x16, 0x18, 0x23, 0x16, 0x14, 0x10, 0x20, 0x26, 0x04, 0x24, 0x11, 0x17,
+    0x12, 0x16, 0x02, 0x22, 0x15, 0x20, 0x10, 0x12, 0x20, 0x00, 0x04, 0x18,
+    0x20, 0x20, 0x14, 0x17, 0x04, 0x18, 0x16, 0x14, 0x06, 0x16, 0x14, 0x10,
+    0x14, 0x10, 0x10, 0x06, 0x14, 0x10, 0x18, 0x20, 0x10, 0x24, 0x04, 0x14,
+    0x14, 0x14, 0x13, 0x04, 0x18, 0x04, 0x14, 0x16, 0x04, 0x08, 0x00, 0x14,
+    0x11, 0x15, 0x04, 0x00, 0x17, 0x16, 0x13, 0x24, 0x08, 0x18, 0x12, 0x28,
+    0x14, 0x06, 0x10, 0x15, 0x15, 0x10, 0x24, 0x24, 0x18, 0x22, 0x12, 0x10,
+    0x10, 0x10, 0x06, 0x10, 0x14, 0x18, 0x22, 0x07, 0x11, 0x16, 0x10, 0x12,
+    0x10, 0x11, 0x10, 0x16, 0x13, 0x14, 0x12, 0x12, 0x05, 0x15, 0x00, 0x12,
+    0x22, 0x04, 0x26, 0x15, 0x28, 0x16, 0x17, 0x14, 0x15, 0x04, 0x12, 0x24,
+    0x11, 0x20, 0x12, 0x16, 0x14, 0x13, 0x20, 0x16, 0x04, 0x02, 0x26, 0x13,
+    0x16, 0x14, 0x12, 0x20, 0x12, 0x24, 0x08, 0x08, 0x16, 0x10, 0x12, 0x02,
+    0x10, 0x16, 0x18, 0x15, 0x14, 0x17, 0x04, 0x15, 0x01, 0x10, 0x02, 0x20,
+    0x17, 0x24, 0x16, 0x12, 0x01, 0x10, 0x15, 0x12, 0x11, 0x06, 0x25, 0x12,
+    0x00, 0x12, 0x00, 0x14, 0x13, 0x11, 0x18, 0x10, 0x14, 0x10, 0x10, 0x20,
+    0x14, 0x16, 0x06, 0x16, 0x01, 0x24, 0x28, 0x17, 0x02, 0x14, 0x16, 0x10,
+    0x17, 0x10, 0x18, 0x20, 0x16, 0x24, 0x16, 0x18, 0x14, 0x26, 0x14, 0x08,
+    0x22, 0x04, 0x14, 0x14, 0x14, 0x10, 0x08, 0x12, 0x04, 0x13, 0x15, 0x02,
+    0x02, 0x15, 0x21, 0x10, 0x00, 0x14, 0x01, 0x08, 0x14, 0x16, 0x14, 0x16,
+    0x12, 0x04, 0x02, 0x18, 0x10, 0x18, 0x14, 0x17, 0x00, 0x10, 0x24, 0x18,
+    0x04, 0x17, 0x14, 0x06, 0x16, 0x16, 0x14, 0x08, 0x14, 0x04, 0x02, 0x02,
+    0x10, 0x14, 0x26, 0x03, 0x16, 0x16, 0x14, 0x16, 0x16, 0x14, 0x10, 0x00,
+    0x12, 0x01, 0x14, 0x00, 0x12, 0x02, 0x24, 0x02, 0x10, 0x17, 0x23, 0x03,
+    0x02, 0x20, 0x02, 0x15, 0x17, 0x14, 0x10, 0x06, 0x02, 0x07, 0x14, 0x26,
+    0x17, 0x03, 0x10, 0x14, 0x14, 0x25, 0x14, 0x00, 0x10, 0x12, 0x12, 0x01,
+    0x04, 0x10, 0x02, 0x14, 0x10, 0x12, 0x14, 0x14, 0x02, 0x14, 0x24, 0x13,
+    0x10, 0x28, 0x10, 0x08, 0x14, 0x26, 0x04, 0x00, 0x16, 0x18, 0x13, 0x18,
+    0x10, 0x14, 0x14, 0x14, 0x18, 0x14, 0x04, 0x14, 0x14, 0x24, 0x07, 0x12,
+    0x15, 0x16, 0x13, 0x12, 0x17, 0x24, 0x12, 0x11, 0x04, 0x06, 0x14, 0x14,
+    0x16, 0x11, 0x16, 0x17, 0x08, 0x10, 0x13, 0x13, 0x14, 0x04, 0x16, 0x24,
+    0x00, 0x26, 0x05, 0x18, 0x10, 0x10, 0x12, 0x10, 0x20, 0x22, 0x10, 0x12,
+    0x12, 0x12, 0x00, 0x00, 0x14, 0x18, 0x13, 0x16, 0x14, 0x11, 0x24, 0x02,
+    0x05, 0x16, 0x20, 0x00, 0x18, 0x00, 0x16, 0x15, 0x10, 0x03, 0x04, 0x05,
+    0x06, 0x12, 0x06, 0x26, 0x16, 0x24, 0x04, 0x16, 0x17, 0x10, 0x15, 0x22,
+    0x12, 0x18, 0x14, 0x14, 0x04, 0x28, 0x13, 0x17, 0x15, 0x03, 0x14, 0x21,
+    0x16, 0x10, 0x24, 0x18, 0x20, 0x08, 0x16, 0x04, 0x24, 0x18, 0x11, 0x13,
+    0x10, 0x24, 0x21, 0x16, 0x14, 0x20, 0x18, 0x20, 0x16, 0x10, 0x14, 0x18,
+    0x24, 0x16, 0x10, 0x12, 0x14, 0x00, 0x00, 0x10, 0x12, 0x12, 0x15, 0x15,
+    0x05, 0x14, 0x13, 0x12, 0x10, 0x10, 0x17, 0x10, 0x04, 0x26, 0x14, 0x17,
+    0x14, 0x12, 0x17, 0x12, 0x11, 0x14, 0x12, 0x14, 0x04, 0x08, 0x20, 0x14,
+    0x20, 0x02, 0x10, 0x14, 0x14, 0x03, 0x10, 0x14, 0x11, 0x13, 0x03, 0x15,
+    0x12, 0x10, 0x07, 0x16, 0x12, 0x11, 0x06, 0x14, 0x24, 0x05, 0x01, 0x04,
+    0x14, 0x12, 0x18, 0x00, 0x24, 0x18, 0x11, 0x05, 0x17, 0x15, 0x12, 0x22,
+    0x10, 0x10, 0x01, 0x14, 0x04, 0x18, 0x20, 0x14, 0x16, 0x16, 0x08, 0x18,
+    0x11, 0x04, 0x18, 0x20, 0x02, 0x10, 0x14, 0x12, 0x10, 0x11, 0x14, 0x24,
+    0x00, 0x17, 0x16, 0x00, 0x12, 0x14, 0x11, 0x02, 0x00, 0x10, 0x06, 0x10,
+    0x16, 0x13, 0x12, 0x14, 0x12, 0x18, 0x12, 0x22, 0x20, 0x24, 0x28, 0x14,
+    0x27, 0x02, 0x10, 0x15, 0x04, 0x17, 0x10, 0x11, 0x18, 0x08, 0x18, 0x18,
+    0x00, 0x18, 0x27, 0x18, 0x10, 0x18, 0x20, 0x26, 0x10, 0x16, 0x13, 0x14,
+    0x00, 0x14, 0x17, 0x14, 0x18, 0x14, 0x18, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x02, 0x10, 0x15, 0x13, 0x15, 0x22, 0x20, 0x18, 0x23, 0x18, 0x22, 0x16,
+    0x14, 0x24, 0x12, 0x14, 0x13, 0x14, 0x05, 0x16, 0x10, 0x01, 0x26, 0x08,
+    0x10, 0x01, 0x07, 0x11, 0x18, 0x24, 0x18, 0x14, 0x14, 0x15, 0x06, 0x07,
+    0x14, 0x00, 0x00, 0x10, 0x22, 0x11, 0x20, 0x18, 0x06, 0x14, 0x04, 0x17,
+    0x04, 0x16, 0x13, 0x05, 0x15, 0x18, 0x12, 0x11, 0x03, 0x14, 0x12, 0x13,
+    0x22, 0x12, 0x13, 0x18, 0x11, 0x12, 0x16, 0x12, 0x13, 0x11, 0x16, 0x07,
+    0x12, 0x12, 0x16, 0x05, 0x04, 0x18, 0x20, 0x00, 0x20, 0x16, 0x05, 0x11,
+    0x12, 0x08, 0x10, 0x15, 0x12, 0x04, 0x18, 0x10, 0x11, 0x13, 0x18, 0x24,
+    0x14, 0x01, 0x28, 0x16, 0x08, 0x08, 0x16, 0x16, 0x24, 0x18, 0x06, 0x24,
+    0x16, 0x13, 0x17, 0x04, 0x02, 0x18, 0x00, 0x10, 0x04, 0x24, 0x10, 0x15,
+    0x12, 0x18, 0x17, 0x08, 0x10, 0x22, 0x12, 0x03, 0x12, 0x14, 0x18, 0x07,
+    0x18, 0x18, 0x28, 0x24, 0x24, 0x18, 0x14, 0x18, 0x13, 0x24, 0x07, 0x11,
+    0x10, 0x17, 0x00, 0x00, 0x18, 0x16, 0x04, 0x12, 0x13, 0x18, 0x12, 0x22,
+    0x25, 0x16, 0x02, 0x14, 0x17, 0x18, 0x18, 0x16, 0x15, 0x11, 0x14, 0x24,
+    0x10, 0x18, 0x17, 0x22, 0x13, 0x24, 0x06, 0x02, 0x17, 0x10, 0x15, 0x18,
+    0x24, 0x07, 0x01, 0x04, 0x04, 0x13, 0x07, 0x28, 0x04, 0x12, 0x14, 0x21,
+    0x14, 0x14, 0x05, 0x15, 0x17, 0x15, 0x14, 0x03, 0x20, 0x16, 0x00, 0x06,
+    0x26, 0x24, 0x10, 0x17, 0x14, 0x12, 0x12, 0x10, 0x24, 0x14, 0x16, 0x10,
+    0x14, 0x14, 0x24, 0x24, 0x12, 0x17, 0x14, 0x10, 0x12, 0x10, 0x14, 0x04,
+    0x12, 0x14, 0x08, 0x22, 0x12, 0x04, 0x10, 0x13, 0x04, 0x14, 0x03, 0x10,
+    0x07, 0x02, 0x03, 0x14, 0x13, 0x16, 0x22, 0x08, 0x24, 0x13, 0x00, 0x24,
+    0x12, 0x14, 0x16, 0x08, 0x10, 0x13, 0x12, 0x24, 0x18, 0x18, 0x16, 0x11,
+    0x10, 0x04, 0x18, 0x18, 0x24, 0x22, 0x12, 0x02, 0x12, 0x22, 0x18, 0x14,
+    0x06, 0x02, 0x14, 0x27, 0x15, 0x02, 0x16, 0x16, 0x04, 0x12, 0x04, 0x00,
+    0x03, 0x12, 0x14, 0x04, 0x14, 0x08, 0x11, 0x12, 0x14, 0x06, 0x24, 0x12,
+    0x04, 0x11, 0x22, 0x05, 0x07, 0x10, 0x13, 0x13, 0x18, 0x26, 0x26, 0x12,
+    0x13, 0x24, 0x26, 0x11, 0x01, 0x12, 0x18, 0x14, 0x16, 0x18, 0x12, 0x14,
+    0x03, 0x00, 0x15, 0x10, 0x00, 0x17, 0x11, 0x14, 0x12, 0x04, 0x24, 0x18,
+    0x05, 0x15, 0x07, 0x26, 0x01, 0x11, 0x10, 0x24, 0x24, 0x03, 0x18, 0x12,
+    0x24, 0x10, 0x04, 0x07, 0x10, 0x17, 0x06, 0x16, 0x16, 0x11, 0x10, 0x14,
+    0x20, 0x15, 0x26, 0x16, 0x04, 0x05, 0x18, 0x15, 0x18, 0x03, 0x17, 0x22,
+    0x16, 0x15, 0x18, 0x14, 0x10, 0x13, 0x12, 0x14, 0x26, 0x20, 0x17, 0x14,
+    0x15, 0x12, 0x18, 0x16, 0x02, 0x20, 0x04, 0x20, 0x14, 0x20, 0x14, 0x22,
+    0x12, 0x21, 0x16, 0x06, 0x10, 0x13, 0x16, 0x26, 0x02, 0x13, 0x00, 0x10,
+    0x10, 0x02, 0x17, 0x16, 0x14, 0x24, 0x16, 0x16, 0x10, 0x24, 0x12, 0x28,
+    0x12, 0x12, 0x18, 0x14, 0x18, 0x10, 0x04, 0x11, 0x14, 0x13, 0x02, 0x04,
+    0x10, 0x15, 0x04, 0x02, 0x04, 0x12, 0x14, 0x24, 0x01, 0x13, 0x20, 0x12,
+    0x02, 0x18, 0x11, 0x11, 0x16, 0x10, 0x14, 0x10,
+};